@@ -0,0 +1,102 @@
+/*
+
+    This file is part of libnmath.
+
+    bench.h
+    Helpers shared by the benchmarks
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_BENCH_H_INCLUDED
+#define NMATH_BENCH_H_INCLUDED
+
+/*
+	Each benchmark is a program that prints its rates. make bench builds
+	and runs them all. The benchmarks are built with the flags of the
+	library. Build the library with --enable-openmp to measure the
+	threaded batch kernels.
+
+	Include this header first, since it selects the POSIX clock.
+*/
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 199309L
+#endif
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif /* _WIN32 */
+
+#include <stdio.h>
+
+/* Each measurement repeats its work for at least this many seconds */
+#ifndef BENCH_MIN_TIME
+	#define BENCH_MIN_TIME 0.25
+#endif
+
+/* Wall clock time in seconds */
+static inline double bench_time()
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, now;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif /* _WIN32 */
+}
+
+/* Calls f() repeatedly for BENCH_MIN_TIME seconds, returns the seconds per call */
+template <class F>
+static double bench_measure(F &f)
+{
+	unsigned long calls = 0;
+	double start = bench_time(), now;
+
+	do {
+		f();
+		++calls;
+		now = bench_time();
+	} while (now - start < BENCH_MIN_TIME);
+
+	return (now - start) / calls;
+}
+
+/* Prints the rate of count items processed in seconds */
+static inline void bench_report(const char *name, double count, double seconds, const char *unit)
+{
+	printf("  %-44s %10.2f M%s/s %10.2f ns/%s\n", name, count / seconds * 1e-6, unit, seconds / count * 1e9, unit);
+}
+
+/* Keeps the compiler from discarding results that are never read */
+static volatile double bench_sink;
+
+static inline void bench_consume(double x)
+{
+	bench_sink = bench_sink + x;
+}
+
+#endif /* NMATH_BENCH_H_INCLUDED */
@@ -0,0 +1,122 @@
+/*
+
+    This file is part of libnmath.
+
+    fastmath.cc
+    Throughput of the fast transcendental functions against libm
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "bench.h"
+#include "fastmath.h"
+
+#include <math.h>
+
+using namespace NMath;
+
+#define COUNT 16384
+
+/* x in [-10, 10), y in [-1, 1), z in [0.5, 20.5) */
+static float x[COUNT], y[COUNT], z[COUNT], res[COUNT];
+
+/* Defines a functor that evaluates the expression for every i */
+#define BENCH_LOOP(name, expression) \
+	struct name { void operator ()() { for (unsigned int i = 0; i < COUNT; ++i) res[i] = (expression); } }
+
+#define BENCH_CALL(name, call) \
+	struct name { void operator ()() { call; } }
+
+BENCH_LOOP(LibmSin, sinf(x[i]));
+BENCH_LOOP(FastSin, fast_sin(x[i]));
+BENCH_CALL(ArraySin, fast_sin_array(res, x, COUNT));
+
+BENCH_LOOP(LibmCos, cosf(x[i]));
+BENCH_LOOP(FastCos, fast_cos(x[i]));
+BENCH_CALL(ArrayCos, fast_cos_array(res, x, COUNT));
+
+BENCH_LOOP(LibmAsin, asinf(y[i]));
+BENCH_LOOP(FastAsin, fast_asin(y[i]));
+BENCH_CALL(ArrayAsin, fast_asin_array(res, y, COUNT));
+
+BENCH_LOOP(LibmAcos, acosf(y[i]));
+BENCH_LOOP(FastAcos, fast_acos(y[i]));
+BENCH_CALL(ArrayAcos, fast_acos_array(res, y, COUNT));
+
+BENCH_LOOP(LibmAtan, atanf(x[i]));
+BENCH_LOOP(FastAtan, fast_atan(x[i]));
+BENCH_CALL(ArrayAtan, fast_atan_array(res, x, COUNT));
+
+BENCH_LOOP(LibmAtan2, atan2f(y[i], x[i]));
+BENCH_LOOP(FastAtan2, fast_atan2(y[i], x[i]));
+BENCH_CALL(ArrayAtan2, fast_atan2_array(res, y, x, COUNT));
+
+BENCH_LOOP(LibmExp, expf(x[i]));
+BENCH_LOOP(FastExp, fast_exp(x[i]));
+BENCH_CALL(ArrayExp, fast_exp_array(res, x, COUNT));
+
+BENCH_LOOP(LibmLog, logf(z[i]));
+BENCH_LOOP(FastLog, fast_log(z[i]));
+BENCH_CALL(ArrayLog, fast_log_array(res, z, COUNT));
+
+BENCH_LOOP(LibmPow, powf(z[i], y[i]));
+BENCH_LOOP(FastPow, fast_pow(z[i], y[i]));
+BENCH_CALL(ArrayPow, fast_pow_array(res, z, y, COUNT));
+
+template <class L, class F, class A>
+static void compare(const char *name)
+{
+	L libm;
+	F fast;
+	A array;
+
+	double tl = bench_measure(libm), tf = bench_measure(fast), ta = bench_measure(array);
+
+	printf("  %-8s %10.1f %10.1f %10.1f %9.1fx\n", name, COUNT / tl * 1e-6, COUNT / tf * 1e-6, COUNT / ta * 1e-6, tl / ta);
+	bench_consume(res[COUNT - 1]);
+}
+
+int main()
+{
+	unsigned int s = 1;
+
+	for (unsigned int i = 0; i < COUNT; ++i) {
+		s = s * 1664525u + 1013904223u;
+		x[i] = (s >> 8) / 16777216.0f * 20 - 10;
+		s = s * 1664525u + 1013904223u;
+		y[i] = (s >> 8) / 16777216.0f * 2 - 1;
+		z[i] = x[i] + 10.5f;
+	}
+
+	printf("Fast functions against the C library, %u floats, in M/s\n", COUNT);
+	printf("  %-8s %10s %10s %10s %10s\n", "", "libm", "fast", "array", "speedup");
+
+	compare<LibmSin, FastSin, ArraySin>("sin");
+	compare<LibmCos, FastCos, ArrayCos>("cos");
+	compare<LibmAsin, FastAsin, ArrayAsin>("asin");
+	compare<LibmAcos, FastAcos, ArrayAcos>("acos");
+	compare<LibmAtan, FastAtan, ArrayAtan>("atan");
+	compare<LibmAtan2, FastAtan2, ArrayAtan2>("atan2");
+	compare<LibmExp, FastExp, ArrayExp>("exp");
+	compare<LibmLog, FastLog, ArrayLog>("log");
+	compare<LibmPow, FastPow, ArrayPow>("pow");
+
+	return 0;
+}
@@ -0,0 +1,296 @@
+/*
+
+    This file is part of libnmath.
+
+    fastmath_ulp.cc
+    Error sweep of the fast transcendental functions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+/*
+	Reproduces the error table of fastmath.h. Each row sweeps the floats
+	of its domain in order of their bit patterns, every STRIDE-th one, and
+	compares the array (SIMD) and the scalar forms against the double
+	precision C library rounded to float. atan2 and pow take two arguments
+	and are swept over pseudo random points instead.
+
+		fastmath_ulp [stride]
+
+	A stride of 1 is exhaustive and takes several minutes. The program
+	fails if a row exceeds the table.
+*/
+
+#include "bench.h"
+#include "fastmath.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace NMath;
+
+#define STRIDE	64
+#define CHUNK	65536
+#define POINTS	4000000
+
+static unsigned int stride = STRIDE;
+static int exceeded = 0;
+
+static float from_bits(uint32_t b)
+{
+	float f;
+	memcpy(&f, &b, sizeof(f));
+	return f;
+}
+
+static uint32_t to_bits(float f)
+{
+	uint32_t b;
+	memcpy(&b, &f, sizeof(b));
+	return b;
+}
+
+/* Size of the unit in the last place of ref rounded to float */
+static double ulp(double ref)
+{
+	int e;
+	frexp((double)(float)ref, &e);
+
+	double res = ldexp(1.0, e - 24);
+	return res > ldexp(1.0, -149) ? res : ldexp(1.0, -149);
+}
+
+/*
+	Walks the floats of [lo, hi], every stride-th one by bit pattern, in
+	chunks of up to CHUNK values. The negative half of a domain that
+	contains 0 is walked as the mirror of the positive one.
+*/
+struct Sweep
+{
+	uint32_t bits, end;
+	float sign;
+	float lo, hi;
+
+	Sweep(float a, float b) : lo(a), hi(b)
+	{
+		sign = lo < 0 ? -1.0f : 1.0f;
+		bits = lo < 0 ? to_bits(0.0f) : to_bits(lo);
+		end = to_bits(lo < 0 ? -lo : hi);
+	}
+
+	unsigned int next(float *x)
+	{
+		unsigned int n = 0;
+
+		while (n < CHUNK) {
+			if (bits > end || bits >= 0x7F800000u) {
+				if (sign > 0 || hi < 0) {
+					break;
+				}
+
+				sign = 1;
+				bits = to_bits(0.0f) + stride;	/* 0 is done */
+				end = to_bits(hi);
+				continue;
+			}
+
+			x[n++] = sign * from_bits(bits);
+			bits += stride;
+		}
+
+		return n;
+	}
+};
+
+static void report(const char *name, const char *domain, unsigned long count, double simd, double scalar, double table)
+{
+	double worst = simd > scalar ? simd : scalar;
+
+	printf("  %-8s %-26s %10lu  %8.2f  %8.2f  %6.1f  %s\n", name, domain, count,
+		simd, scalar, table, worst <= table ? "ok" : "EXCEEDED");
+
+	exceeded += worst > table;
+}
+
+typedef void (*array_fn)(float *, const float *, unsigned int);
+typedef float (*scalar_fn)(float);
+typedef double (*reference_fn)(double);
+
+static void row(const char *name, const char *domain, float lo, float hi, array_fn fa, scalar_fn fs, reference_fn ref, double table)
+{
+	std::vector<float> x(CHUNK), res(CHUNK);
+	Sweep sweep(lo, hi);
+	unsigned long count = 0;
+	unsigned int n;
+
+	double simd = 0, scalar = 0;
+
+	while ((n = sweep.next(&x[0])) > 0) {
+		fa(&res[0], &x[0], n);
+
+		for (unsigned int i = 0; i < n; ++i) {
+			double r = ref(x[i]), u = ulp(r);
+			double es = fabs(res[i] - r) / u, ec = fabs(fs(x[i]) - r) / u;
+			simd = es > simd ? es : simd;
+			scalar = ec > scalar ? ec : scalar;
+		}
+
+		count += n;
+	}
+
+	report(name, domain, count, simd, scalar, table);
+}
+
+/* Largest absolute error of sin over [-hi, hi] */
+static void absolute_row(const char *domain, float hi, double table)
+{
+	std::vector<float> x(CHUNK), res(CHUNK);
+	Sweep sweep(-hi, hi);
+	unsigned long count = 0;
+	unsigned int n;
+
+	double simd = 0, scalar = 0;
+
+	while ((n = sweep.next(&x[0])) > 0) {
+		fast_sin_array(&res[0], &x[0], n);
+
+		for (unsigned int i = 0; i < n; ++i) {
+			double r = sin((double)x[i]);
+			double es = fabs(res[i] - r), ec = fabs(fast_sin(x[i]) - r);
+			simd = es > simd ? es : simd;
+			scalar = ec > scalar ? ec : scalar;
+		}
+
+		count += n;
+	}
+
+	double worst = simd > scalar ? simd : scalar;
+
+	printf("  %-8s %-26s %10lu  %8.1e  %8.1e  %6.0e  %s\n", "sin abs", domain, count,
+		simd, scalar, table, worst <= table ? "ok" : "EXCEEDED");
+
+	exceeded += worst > table;
+}
+
+static unsigned int lcg_state = 1;
+
+static double lcg_uniform()
+{
+	lcg_state = lcg_state * 1664525u + 1013904223u;
+	return (lcg_state >> 8) / 16777216.0;
+}
+
+/* Points of every angle, magnitudes of 1e-30 to 1e30, with zero coordinates */
+static void row_atan2(double table)
+{
+	std::vector<float> y(POINTS), x(POINTS), res(POINTS);
+
+	for (unsigned int i = 0; i < POINTS; ++i) {
+		double a = lcg_uniform() * 2 * M_PI - M_PI, m = pow(10.0, lcg_uniform() * 60 - 30);
+		y[i] = i % 101 ? (float)(m * sin(a)) : 0;
+		x[i] = i % 100 ? (float)(m * cos(a)) : 0;
+	}
+
+	fast_atan2_array(&res[0], &y[0], &x[0], POINTS);
+
+	double simd = 0, scalar = 0;
+
+	for (unsigned int i = 0; i < POINTS; ++i) {
+		double r = atan2((double)y[i], (double)x[i]), u = ulp(r);
+		double es = fabs(res[i] - r) / u, ec = fabs(fast_atan2(y[i], x[i]) - r) / u;
+		simd = es > simd ? es : simd;
+		scalar = ec > scalar ? ec : scalar;
+	}
+
+	report("atan2", "all finite x, y", POINTS, simd, scalar, table);
+}
+
+/* x of 1e-10 to 1e10, y such that |y * log(x)| <= limit */
+static void row_pow(const char *domain, double limit, double table)
+{
+	std::vector<float> x(POINTS), y(POINTS), res(POINTS);
+
+	for (unsigned int i = 0; i < POINTS; ++i) {
+		x[i] = (float)pow(10.0, lcg_uniform() * 20 - 10);
+		double l = fabs(log((double)x[i]));
+		double ymax = l > 0 ? limit / l : limit;
+		y[i] = (float)((lcg_uniform() * 2 - 1) * (ymax < 100 ? ymax : 100));
+	}
+
+	fast_pow_array(&res[0], &x[0], &y[0], POINTS);
+
+	double simd = 0, scalar = 0;
+
+	for (unsigned int i = 0; i < POINTS; ++i) {
+		double r = pow((double)x[i], (double)y[i]), u = ulp(r);
+		double es = fabs(res[i] - r) / u, ec = fabs(fast_pow(x[i], y[i]) - r) / u;
+		simd = es > simd ? es : simd;
+		scalar = ec > scalar ? ec : scalar;
+	}
+
+	report("pow", domain, POINTS, simd, scalar, table);
+}
+
+static double ref_sin(double x) { return sin(x); }
+static double ref_cos(double x) { return cos(x); }
+static double ref_asin(double x) { return asin(x); }
+static double ref_acos(double x) { return acos(x); }
+static double ref_atan(double x) { return atan(x); }
+static double ref_exp(double x) { return exp(x); }
+static double ref_log(double x) { return log(x); }
+
+int main(int argc, char **argv)
+{
+	if (argc > 1 && atoi(argv[1]) > 0) {
+		stride = (unsigned int)atoi(argv[1]);
+	}
+
+	if (stride == 1) {
+		printf("Maximum error of the fast functions in ulp, every float\n");
+	}
+	else {
+		printf("Maximum error of the fast functions in ulp, every %u-th float\n", stride);
+	}
+	printf("  %-8s %-26s %10s  %8s  %8s  %6s\n", "", "domain", "points", "array", "scalar", "table");
+
+	row("sin", "|x| <= pi", -(float)M_PI, (float)M_PI, fast_sin_array, fast_sin, ref_sin, 2);
+	row("sin", "|x| <= 100", -100, 100, fast_sin_array, fast_sin, ref_sin, 14);
+	row("cos", "|x| <= pi", -(float)M_PI, (float)M_PI, fast_cos_array, fast_cos, ref_cos, 2);
+	row("cos", "|x| <= 100", -100, 100, fast_cos_array, fast_cos, ref_cos, 14);
+	absolute_row("|x| <= 8192", 8192, 1e-7);
+	absolute_row("|x| <= 1e5", 1e5, 1e-6);
+	row("asin", "[-1, 1]", -1, 1, fast_asin_array, fast_asin, ref_asin, 3.5);
+	row("acos", "[-1, 1]", -1, 1, fast_acos_array, fast_acos, ref_acos, 2.5);
+	row("atan", "all finite x", -FLT_MAX, FLT_MAX, fast_atan_array, fast_atan, ref_atan, 5);
+	row_atan2(5.5);
+	row("exp", "[-87.3, 88.3]", -87.3f, 88.3f, fast_exp_array, fast_exp, ref_exp, 1.5);
+	row("log", "positive normal x", FLT_MIN, FLT_MAX, fast_log_array, fast_log, ref_log, 2);
+	row_pow("|y * log(x)| <= 10", 10, 20);
+	row_pow("|y * log(x)| <= 88", 88, 160);
+
+	if (exceeded) {
+		printf("%d row(s) exceed the table of fastmath.h\n", exceeded);
+		return 1;
+	}
+
+	return 0;
+}
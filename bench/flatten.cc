@@ -0,0 +1,288 @@
+/*
+
+    This file is part of libnmath.
+
+    flatten.cc
+    Adaptive Bezier flattening against uniform sampling at equal error
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+#include "bench.h"
+#include "interpolation.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace NMath;
+using namespace NMath::Interpolation;
+
+#define CURVES		256
+#define MAX_POINTS	65537
+
+/* Samples of each curve used to measure the distance to a polyline */
+#define DENSE		2048
+
+/* Distance of p from the segment ab */
+static scalar_t segment_distance(const Vector2f &p, const Vector2f &a, const Vector2f &b)
+{
+	Vector2f ab = b - a, ap = p - a;
+	scalar_t len = dot(ab, ab);
+	scalar_t t = len > 0 ? dot(ap, ab) / len : 0;
+	t = t < 0 ? 0 : (t > 1 ? 1 : t);
+	return (ap - ab * t).length();
+}
+
+/* A quadratic (3 control points) or cubic (4) curve */
+struct Curve
+{
+	unsigned int order;
+	Vector2f p[4];
+	Vector2f dense[DENSE + 1];
+
+	Vector2f eval(scalar_t t) const
+	{
+		return order == 3 ? bezier_quadratic(p[0], p[1], p[2], t) : bezier_cubic(p[0], p[1], p[2], p[3], t);
+	}
+
+	unsigned int flatten(scalar_t tolerance, Vector2f *res, unsigned int max) const
+	{
+		return order == 3 ? flatten_bezier_quadratic(p[0], p[1], p[2], tolerance, res, max)
+			: flatten_bezier_cubic(p[0], p[1], p[2], p[3], tolerance, res, max);
+	}
+
+	void sample(const scalar_t *t, Vector2f *res, unsigned int count) const
+	{
+		if (order == 3) {
+			bezier_quadratic_batch(p[0], p[1], p[2], t, res, count);
+		}
+		else {
+			bezier_cubic_batch(p[0], p[1], p[2], p[3], t, res, count);
+		}
+	}
+
+	void init(unsigned int n)
+	{
+		order = n;
+
+		for (unsigned int i = 0; i < order; ++i) {
+			p[i] = Vector2f((scalar_t)(100.0 * rand() / RAND_MAX), (scalar_t)(100.0 * rand() / RAND_MAX));
+		}
+
+		for (int i = 0; i <= DENSE; ++i) {
+			dense[i] = eval((scalar_t)i / DENSE);
+		}
+	}
+
+	/* Largest distance of the curve from a polyline through any of its points */
+	scalar_t error(const Vector2f *line, unsigned int n) const
+	{
+		scalar_t err = 0;
+
+		for (int i = 0; i <= DENSE; ++i) {
+			scalar_t d = segment_distance(dense[i], line[0], line[0]);
+
+			for (unsigned int k = 0; k + 1 < n; ++k) {
+				scalar_t e = segment_distance(dense[i], line[k], line[k + 1]);
+				d = e < d ? e : d;
+			}
+
+			err = d > err ? d : err;
+		}
+
+		return err;
+	}
+
+	/* Largest distance of the curve from the polyline of n uniform samples */
+	scalar_t uniform_error(unsigned int n) const
+	{
+		scalar_t err = 0;
+		Vector2f a = p[0];
+
+		for (unsigned int k = 1; k < n; ++k) {
+			Vector2f b = eval((scalar_t)k / (n - 1));
+			scalar_t t0 = (scalar_t)(k - 1) / (n - 1), t1 = (scalar_t)k / (n - 1);
+
+			for (int i = (int)ceil(t0 * DENSE); i <= (int)floor(t1 * DENSE); ++i) {
+				scalar_t d = segment_distance(dense[i], a, b);
+				err = d > err ? d : err;
+			}
+
+			a = b;
+		}
+
+		return err;
+	}
+
+	/* Fewest uniform samples within tolerance, found by bisection */
+	unsigned int uniform_points(scalar_t tolerance) const
+	{
+		unsigned int lo = 2, hi = 2;
+
+		while (uniform_error(hi) > tolerance && hi < MAX_POINTS) {
+			lo = hi;
+			hi *= 2;
+		}
+
+		while (lo + 1 < hi) {
+			unsigned int mid = (lo + hi) / 2;
+
+			if (uniform_error(mid) > tolerance) {
+				lo = mid;
+			}
+			else {
+				hi = mid;
+			}
+		}
+
+		return hi;
+	}
+
+	/*
+		Uniform samples from the bound on the second derivative (Wang's
+		formula), the count a caller without the measured error would use.
+		A chord of length h in t is within h^2 / 8 * max |B''| of the curve.
+	*/
+	unsigned int bound_points(scalar_t tolerance) const
+	{
+		scalar_t m = 0;
+
+		for (unsigned int i = 0; i + 2 < order; ++i) {
+			scalar_t s = (p[i] - p[i + 1] * 2 + p[i + 2]).length();
+			m = s > m ? s : m;
+		}
+
+		/* |B''| <= (order - 1) (order - 2) m */
+		scalar_t c = (order - 1) * (order - 2) / (scalar_t)8;
+		unsigned int n = (unsigned int)ceil(sqrt(c * m / tolerance)) + 1;
+		return n < 2 ? 2 : (n > MAX_POINTS ? MAX_POINTS : n);
+	}
+};
+
+struct Data
+{
+	std::vector<Curve> curve;
+	std::vector<unsigned int> uniform, bound;
+	std::vector<scalar_t> t;
+	std::vector<Vector2f> res;
+	scalar_t tolerance;
+
+	Data(unsigned int order) : curve(CURVES), uniform(CURVES), bound(CURVES), t(MAX_POINTS), res(MAX_POINTS), tolerance(0)
+	{
+		for (unsigned int i = 0; i < CURVES; ++i) {
+			curve[i].init(order);
+		}
+	}
+};
+
+struct Adaptive
+{
+	Data &d;
+	Adaptive(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < CURVES; ++i) {
+			d.curve[i].flatten(d.tolerance, &d.res[0], MAX_POINTS);
+		}
+	}
+};
+
+/* The parameters are computed per call, as a caller with varying counts would */
+struct Uniform
+{
+	Data &d;
+	const std::vector<unsigned int> &count;
+	Uniform(Data &data, const std::vector<unsigned int> &c) : d(data), count(c) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < CURVES; ++i) {
+			unsigned int n = count[i];
+
+			for (unsigned int k = 0; k < n; ++k) {
+				d.t[k] = (scalar_t)k / (n - 1);
+			}
+
+			d.curve[i].sample(&d.t[0], &d.res[0], n);
+		}
+	}
+};
+
+static void run(const char *name, unsigned int order)
+{
+	static const scalar_t tolerances[] = { 1, 0.1, 0.01, 0.001 };
+
+	Data d(order);
+
+	printf("%u %s Bezier curves in a 100 x 100 square\n", CURVES, order == 3 ? "quadratic" : "cubic");
+
+	for (unsigned int s = 0; s < sizeof(tolerances) / sizeof(tolerances[0]); ++s) {
+		unsigned long adaptive_points = 0, uniform_points = 0, bound_points = 0;
+		scalar_t adaptive_error = 0, uniform_error = 0, bound_error = 0;
+
+		d.tolerance = tolerances[s];
+
+		for (unsigned int i = 0; i < CURVES; ++i) {
+			const Curve &c = d.curve[i];
+			unsigned int n = c.flatten(d.tolerance, &d.res[0], MAX_POINTS);
+			scalar_t e = c.error(&d.res[0], n);
+
+			adaptive_points += n;
+			adaptive_error = e > adaptive_error ? e : adaptive_error;
+
+			d.uniform[i] = c.uniform_points(d.tolerance);
+			e = c.uniform_error(d.uniform[i]);
+
+			uniform_points += d.uniform[i];
+			uniform_error = e > uniform_error ? e : uniform_error;
+
+			d.bound[i] = c.bound_points(d.tolerance);
+			e = c.uniform_error(d.bound[i]);
+
+			bound_points += d.bound[i];
+			bound_error = e > bound_error ? e : bound_error;
+		}
+
+		Adaptive adaptive(d);
+		Uniform uniform(d, d.uniform);
+		Uniform bound(d, d.bound);
+
+		printf("tolerance %g\n", (double)d.tolerance);
+		printf("  %-44s %10lu points, max error %g\n", name, adaptive_points, (double)adaptive_error);
+		printf("  %-44s %10lu points, max error %g\n", "uniform, fewest points within tolerance", uniform_points, (double)uniform_error);
+		printf("  %-44s %10lu points, max error %g\n", "uniform, count from the derivative bound", bound_points, (double)bound_error);
+		bench_report(name, CURVES, bench_measure(adaptive), "curve");
+		bench_report("uniform, fewest points within tolerance", CURVES, bench_measure(uniform), "curve");
+		bench_report("uniform, count from the derivative bound", CURVES, bench_measure(bound), "curve");
+
+		bench_consume(d.res[1].x);
+	}
+}
+
+int main()
+{
+	printf("Adaptive flattening against uniform sampling, %s precision\n", sizeof(scalar_t) == 4 ? "single" : "double");
+
+	run("flatten_bezier_quadratic", 3);
+	run("flatten_bezier_cubic", 4);
+
+	return 0;
+}
@@ -0,0 +1,312 @@
+/*
+
+    This file is part of libnmath.
+
+    intersect.cc
+    Vector operator chains against the same code written per component
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+/*
+	The numbers behind the design note on expression templates in README.
+	An expression template can at best evaluate a chain of vector
+	operators component by component with no temporaries, so each kernel
+	is written once with the plain operators and once by hand in that
+	fused form. Triangle::intersection is timed for scale.
+*/
+
+#include "bench.h"
+#include "triangle.h"
+#include "intinfo.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace NMath;
+
+#define COUNT	4096
+
+static scalar_t random_unit()
+{
+	return (scalar_t)rand() / RAND_MAX;
+}
+
+static Vector3f random_vector()
+{
+	return Vector3f(random_unit() * 2 - 1, random_unit() * 2 - 1, random_unit() * 2 - 1);
+}
+
+struct Data
+{
+	std::vector<Triangle> tri;
+	std::vector<Ray> ray;
+	std::vector<Vector3f> bc, res;
+	std::vector<scalar_t> t;
+	unsigned int hits;
+
+	Data() : tri(COUNT), ray(COUNT), bc(COUNT), res(COUNT), t(COUNT), hits(0)
+	{
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			for (int k = 0; k < 3; ++k) {
+				tri[i].v[k] = random_vector();
+				tri[i].n[k] = random_vector().normalized();
+				tri[i].tc[k] = Vector2f(random_unit(), random_unit());
+			}
+
+			/* Aimed at a point inside the triangle */
+			scalar_t a = random_unit(), b = random_unit() * (1 - a);
+			bc[i] = Vector3f(a, b, 1 - a - b);
+
+			Vector3f target = tri[i].v[0] * bc[i].x + tri[i].v[1] * bc[i].y + tri[i].v[2] * bc[i].z;
+			Vector3f origin = random_vector() * 4;
+
+			ray[i] = Ray(origin, target - origin);
+			t[i] = random_unit();
+		}
+	}
+};
+
+struct TriangleIntersection
+{
+	Data &d;
+	TriangleIntersection(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		IntInfo info;
+		unsigned int hits = 0;
+
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			hits += d.tri[i].intersection(d.ray[i], &info);
+		}
+
+		d.hits = hits;
+	}
+};
+
+/* origin + direction * t */
+struct PointOperators
+{
+	Data &d;
+	PointOperators(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			d.res[i] = d.ray[i].origin + d.ray[i].direction * d.t[i];
+		}
+	}
+};
+
+struct PointComponents
+{
+	Data &d;
+	PointComponents(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			const Vector3f &o = d.ray[i].origin, &v = d.ray[i].direction;
+			scalar_t t = d.t[i];
+			d.res[i].x = o.x + v.x * t;
+			d.res[i].y = o.y + v.y * t;
+			d.res[i].z = o.z + v.z * t;
+		}
+	}
+};
+
+/* n[0] * bc.x + n[1] * bc.y + n[2] * bc.z */
+struct NormalOperators
+{
+	Data &d;
+	NormalOperators(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			const Vector3f *n = d.tri[i].n;
+			const Vector3f &b = d.bc[i];
+			d.res[i] = n[0] * b.x + n[1] * b.y + n[2] * b.z;
+		}
+	}
+};
+
+struct NormalComponents
+{
+	Data &d;
+	NormalComponents(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			const Vector3f *n = d.tri[i].n;
+			const Vector3f &b = d.bc[i];
+			d.res[i].x = n[0].x * b.x + n[1].x * b.y + n[2].x * b.z;
+			d.res[i].y = n[0].y * b.x + n[1].y * b.y + n[2].y * b.z;
+			d.res[i].z = n[0].z * b.x + n[1].z * b.y + n[2].z * b.z;
+		}
+	}
+};
+
+/* Moller-Trumbore with the hit point and the interpolated normal */
+struct MollerOperators
+{
+	Data &d;
+	MollerOperators(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		unsigned int hits = 0;
+
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			const Triangle &tri = d.tri[i];
+			const Ray &ray = d.ray[i];
+
+			Vector3f e1 = tri.v[1] - tri.v[0];
+			Vector3f e2 = tri.v[2] - tri.v[0];
+			Vector3f p = cross(ray.direction, e2);
+			scalar_t det = dot(e1, p);
+
+			if (fabs(det) < EPSILON) {
+				continue;
+			}
+
+			scalar_t inv = 1 / det;
+			Vector3f s = ray.origin - tri.v[0];
+			scalar_t u = dot(s, p) * inv;
+			Vector3f q = cross(s, e1);
+			scalar_t v = dot(ray.direction, q) * inv;
+			scalar_t t = dot(e2, q) * inv;
+
+			if (u < 0 || v < 0 || u + v > 1 || t < EPSILON) {
+				continue;
+			}
+
+			Vector3f point = ray.origin + ray.direction * t;
+			Vector3f normal = tri.n[0] * (1 - u - v) + tri.n[1] * u + tri.n[2] * v;
+			d.res[i] = point + normal;
+			++hits;
+		}
+
+		d.hits = hits;
+	}
+};
+
+struct MollerComponents
+{
+	Data &d;
+	MollerComponents(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		unsigned int hits = 0;
+
+		for (unsigned int i = 0; i < COUNT; ++i) {
+			const Triangle &tri = d.tri[i];
+			const Vector3f &o = d.ray[i].origin, &dir = d.ray[i].direction;
+			const Vector3f &v0 = tri.v[0], &v1 = tri.v[1], &v2 = tri.v[2];
+
+			scalar_t e1x = v1.x - v0.x, e1y = v1.y - v0.y, e1z = v1.z - v0.z;
+			scalar_t e2x = v2.x - v0.x, e2y = v2.y - v0.y, e2z = v2.z - v0.z;
+			scalar_t px = dir.y * e2z - dir.z * e2y;
+			scalar_t py = dir.z * e2x - dir.x * e2z;
+			scalar_t pz = dir.x * e2y - dir.y * e2x;
+			scalar_t det = e1x * px + e1y * py + e1z * pz;
+
+			if (fabs(det) < EPSILON) {
+				continue;
+			}
+
+			scalar_t inv = 1 / det;
+			scalar_t sx = o.x - v0.x, sy = o.y - v0.y, sz = o.z - v0.z;
+			scalar_t u = (sx * px + sy * py + sz * pz) * inv;
+			scalar_t qx = sy * e1z - sz * e1y;
+			scalar_t qy = sz * e1x - sx * e1z;
+			scalar_t qz = sx * e1y - sy * e1x;
+			scalar_t v = (dir.x * qx + dir.y * qy + dir.z * qz) * inv;
+			scalar_t t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+
+			if (u < 0 || v < 0 || u + v > 1 || t < EPSILON) {
+				continue;
+			}
+
+			scalar_t w = 1 - u - v;
+			const Vector3f *n = tri.n;
+			d.res[i].x = o.x + dir.x * t + n[0].x * w + n[1].x * u + n[2].x * v;
+			d.res[i].y = o.y + dir.y * t + n[0].y * w + n[1].y * u + n[2].y * v;
+			d.res[i].z = o.z + dir.z * t + n[0].z * w + n[1].z * u + n[2].z * v;
+			++hits;
+		}
+
+		d.hits = hits;
+	}
+};
+
+/* Largest difference between the results of two forms of a kernel */
+template <class A, class B>
+static double compare(Data &d, A &a, B &b)
+{
+	std::vector<Vector3f> ra;
+	double err = 0;
+
+	a();
+	ra = d.res;
+	b();
+
+	for (unsigned int i = 0; i < COUNT; ++i) {
+		Vector3f e = ra[i] - d.res[i];
+		double m = fabs(e.x) > fabs(e.y) ? fabs(e.x) : fabs(e.y);
+		m = fabs(e.z) > m ? fabs(e.z) : m;
+		err = m > err ? m : err;
+	}
+
+	return err;
+}
+
+template <class A, class B>
+static void run(const char *name, Data &d, A a, B b, const char *unit)
+{
+	char label[64];
+
+	sprintf(label, "%s, operators", name);
+	bench_report(label, COUNT, bench_measure(a), unit);
+	sprintf(label, "%s, per component", name);
+	bench_report(label, COUNT, bench_measure(b), unit);
+	printf("  %-44s max difference %g\n", "", compare(d, a, b));
+	bench_consume(d.res[COUNT - 1].x);
+}
+
+int main()
+{
+	Data d;
+
+	printf("Vector operator chains, %u rays, %s precision\n", COUNT, sizeof(scalar_t) == 4 ? "single" : "double");
+
+	TriangleIntersection tri(d);
+	bench_report("Triangle::intersection", COUNT, bench_measure(tri), "ray");
+	printf("  %-44s %u of %u hit\n", "", d.hits, COUNT);
+
+	run("origin + direction * t", d, PointOperators(d), PointComponents(d), "vec");
+	run("n0 * b.x + n1 * b.y + n2 * b.z", d, NormalOperators(d), NormalComponents(d), "vec");
+	run("Moller-Trumbore, point and normal", d, MollerOperators(d), MollerComponents(d), "ray");
+
+	return 0;
+}
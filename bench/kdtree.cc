@@ -0,0 +1,188 @@
+/*
+
+    This file is part of libnmath.
+
+    kdtree.cc
+    Build time and query throughput of the k-d tree
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+#include "bench.h"
+#include "kdtree.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace NMath;
+
+#define QUERIES		4096
+#define K			16
+#define MAX_FOUND	256
+#define BRUTE_FORCE	16
+
+static scalar_t random_unit()
+{
+	return (scalar_t)rand() / RAND_MAX;
+}
+
+struct Data
+{
+	std::vector<Vector3f> point, query;
+	std::vector<unsigned int> index, found;
+	std::vector<scalar_t> distance;
+	scalar_t radius;
+	KDTree *tree;
+
+	Data(unsigned int n)
+		: point(n), query(QUERIES), index(QUERIES * MAX_FOUND), found(QUERIES), distance(QUERIES * MAX_FOUND), tree(0)
+	{
+		for (unsigned int i = 0; i < n; ++i) {
+			point[i] = Vector3f(random_unit(), random_unit(), random_unit());
+		}
+
+		for (unsigned int i = 0; i < QUERIES; ++i) {
+			query[i] = Vector3f(random_unit(), random_unit(), random_unit());
+		}
+
+		/* About K points in the radius on average */
+		radius = (scalar_t)pow(K / (n * 4.18879), 1.0 / 3.0);
+	}
+
+	~Data() { delete tree; }
+};
+
+struct Build
+{
+	Data &d;
+	Build(Data &data) : d(data) {}
+	void operator ()() { KDTree t(&d.point[0], (unsigned int)d.point.size()); bench_consume(t.count()); }
+};
+
+struct Nearest
+{
+	Data &d;
+	unsigned int k;
+	Nearest(Data &data, unsigned int n) : d(data), k(n) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < QUERIES; ++i) {
+			d.found[i] = d.tree->nearest(d.query[i], k, &d.index[i * k], &d.distance[i * k]);
+		}
+	}
+};
+
+struct NearestBatch
+{
+	Data &d;
+	unsigned int k;
+	NearestBatch(Data &data, unsigned int n) : d(data), k(n) {}
+	void operator ()() { d.tree->nearest(&d.query[0], QUERIES, k, &d.index[0], &d.distance[0], &d.found[0]); }
+};
+
+struct Radius
+{
+	Data &d;
+	Radius(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < QUERIES; ++i) {
+			d.found[i] = d.tree->radius(d.query[i], d.radius, MAX_FOUND, &d.index[i * MAX_FOUND], &d.distance[i * MAX_FOUND]);
+		}
+	}
+};
+
+struct RadiusBatch
+{
+	Data &d;
+	RadiusBatch(Data &data) : d(data) {}
+	void operator ()() { d.tree->radius(&d.query[0], QUERIES, d.radius, MAX_FOUND, &d.index[0], &d.distance[0], &d.found[0]); }
+};
+
+/* Nearest point by scanning them all, for scale */
+struct BruteForce
+{
+	Data &d;
+	BruteForce(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < BRUTE_FORCE; ++i) {
+			scalar_t best = SCALAR_T_MAX;
+			unsigned int index = 0;
+
+			for (unsigned int j = 0; j < d.point.size(); ++j) {
+				Vector3f e = d.point[j] - d.query[i];
+				scalar_t s = dot(e, e);
+
+				if (s < best) {
+					best = s;
+					index = j;
+				}
+			}
+
+			d.index[i] = index;
+		}
+	}
+};
+
+int main()
+{
+	static const unsigned int sizes[] = { 10000, 1000000 };
+
+	printf("k-d tree over uniform points in the unit cube, %s precision\n", sizeof(scalar_t) == 4 ? "single" : "double");
+
+	for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Data d(sizes[s]);
+		char name[64];
+
+		printf("%u points, %u queries\n", sizes[s], QUERIES);
+
+		Build build(d);
+		double t = bench_measure(build);
+		printf("  %-44s %10.2f ms %10.2f ns/point\n", "build", t * 1e3, t / sizes[s] * 1e9);
+
+		d.tree = new KDTree(&d.point[0], sizes[s]);
+
+		Nearest nearest1(d, 1), nearestk(d, K);
+		NearestBatch batch1(d, 1), batchk(d, K);
+		Radius radius(d);
+		RadiusBatch radius_batch(d);
+		BruteForce brute(d);
+
+		bench_report("nearest k = 1", QUERIES, bench_measure(nearest1), "query");
+		bench_report("nearest k = 1, batch", QUERIES, bench_measure(batch1), "query");
+		sprintf(name, "nearest k = %u", K);
+		bench_report(name, QUERIES, bench_measure(nearestk), "query");
+		sprintf(name, "nearest k = %u, batch", K);
+		bench_report(name, QUERIES, bench_measure(batchk), "query");
+		sprintf(name, "radius %.3g", (double)d.radius);
+		bench_report(name, QUERIES, bench_measure(radius), "query");
+		sprintf(name, "radius %.3g, batch", (double)d.radius);
+		bench_report(name, QUERIES, bench_measure(radius_batch), "query");
+		bench_report("nearest k = 1, brute force", BRUTE_FORCE, bench_measure(brute), "query");
+
+		bench_consume(d.index[0] + d.found[QUERIES - 1]);
+	}
+
+	return 0;
+}
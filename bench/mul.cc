@@ -0,0 +1,157 @@
+/*
+
+    This file is part of libnmath.
+
+    mul.cc
+    Throughput of the 4x4 matrix products
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "bench.h"
+#include "matrix.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace NMath;
+
+/* The scalar triple loop mat4x4_mul used to be */
+static void mul_reference(mat4x4_t res, const mat4x4_t m1, const mat4x4_t m2)
+{
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			res[i][j] = 0;
+			for (int k = 0; k < 4; ++k) {
+				res[i][j] += m1[i][k] * m2[k][j];
+			}
+		}
+	}
+}
+
+struct Data
+{
+	std::vector<Matrix4x4f> a, b, res;
+	std::vector<int> parent;
+	unsigned int count;
+
+	Data(unsigned int n) : a(n), b(n), res(n), parent(n), count(n)
+	{
+		for (unsigned int i = 0; i < n; ++i) {
+			for (int j = 0; j < 16; ++j) {
+				a[i].data[j / 4][j % 4] = rand() / (scalar_t)RAND_MAX;
+				b[i].data[j / 4][j % 4] = rand() / (scalar_t)RAND_MAX;
+			}
+
+			/* A forest of shallow trees, parents precede their children */
+			parent[i] = i % 64 ? (int)(i - 1 - rand() % (i % 64)) : -1;
+		}
+	}
+
+	mat4x4_t *pa() { return (mat4x4_t *)&a[0]; }
+	mat4x4_t *pb() { return (mat4x4_t *)&b[0]; }
+	mat4x4_t *pres() { return (mat4x4_t *)&res[0]; }
+};
+
+struct Reference
+{
+	Data &d;
+	Reference(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) mul_reference(d.pres()[i], d.pa()[i], d.pb()[i]); }
+};
+
+struct Operator
+{
+	Data &d;
+	Operator(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) d.res[i] = d.a[i] * d.b[i]; }
+};
+
+struct Batch
+{
+	Data &d;
+	Batch(Data &data) : d(data) {}
+	void operator ()() { mat4x4_mul_batch(d.pres(), d.pa(), d.pb(), d.count); }
+};
+
+struct BatchParent
+{
+	Data &d;
+	BatchParent(Data &data) : d(data) {}
+	void operator ()() { mat4x4_mul_batch_parent(d.pres(), d.a[0].data, d.pb(), d.count); }
+};
+
+struct Hierarchy
+{
+	Data &d;
+	Hierarchy(Data &data) : d(data) {}
+	void operator ()() { mat4x4_mul_hierarchy(d.pres(), d.pb(), &d.parent[0], d.count); }
+};
+
+/* Largest difference between the batch product and the reference */
+static double check(Data &d)
+{
+	mat4x4_mul_batch(d.pres(), d.pa(), d.pb(), d.count);
+
+	double err = 0;
+
+	for (unsigned int i = 0; i < d.count; ++i) {
+		mat4x4_t ref;
+		mul_reference(ref, d.pa()[i], d.pb()[i]);
+
+		for (int j = 0; j < 16; ++j) {
+			double e = fabs(ref[j / 4][j % 4] - d.res[i].data[j / 4][j % 4]);
+			err = e > err ? e : err;
+		}
+	}
+
+	return err;
+}
+
+int main()
+{
+	static const unsigned int sizes[] = { 1024, 262144 };
+
+	printf("4x4 matrix products, %s precision\n", sizeof(scalar_t) == 4 ? "single" : "double");
+
+	for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Data d(sizes[s]);
+
+		printf("%u matrices (%u KB per array), max error %g\n",
+			d.count, (unsigned int)(d.count * sizeof(mat4x4_t) / 1024), check(d));
+
+		Reference ref(d);
+		Operator op(d);
+		Batch batch(d);
+		BatchParent parent(d);
+		Hierarchy hierarchy(d);
+
+		bench_report("scalar triple loop", d.count, bench_measure(ref), "mat");
+		bench_report("Matrix4x4f operator *", d.count, bench_measure(op), "mat");
+		bench_report("mat4x4_mul_batch", d.count, bench_measure(batch), "mat");
+		bench_report("mat4x4_mul_batch_parent", d.count, bench_measure(parent), "mat");
+		bench_report("mat4x4_mul_hierarchy", d.count, bench_measure(hierarchy), "mat");
+
+		bench_consume(d.res[d.count - 1].data[3][3]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,181 @@
+/*
+
+    This file is part of libnmath.
+
+    normalize.cc
+    Throughput and accuracy of the batch inverse square root and normalization
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+#include "bench.h"
+#include "mutil.h"
+#include "vector.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace NMath;
+
+struct Data
+{
+	std::vector<scalar_t> x, res;
+	std::vector<Vector3f> v, vres;
+	unsigned int count;
+
+	Data(unsigned int n) : x(n), res(n), v(n), vres(n), count(n)
+	{
+		for (unsigned int i = 0; i < n; ++i) {
+			/* Squared lengths of vectors in [-10, 10]^3 */
+			x[i] = (scalar_t)(1e-3 + 300.0 * rand() / RAND_MAX);
+			v[i] = Vector3f((scalar_t)(20.0 * rand() / RAND_MAX - 10),
+				(scalar_t)(20.0 * rand() / RAND_MAX - 10),
+				(scalar_t)(20.0 * rand() / RAND_MAX - 10));
+		}
+	}
+
+	vec3_t *pv() { return (vec3_t *)&v[0]; }
+	vec3_t *pvres() { return (vec3_t *)&vres[0]; }
+};
+
+struct InvSqrt
+{
+	Data &d;
+	InvSqrt(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) d.res[i] = 1 / sqrt(d.x[i]); }
+};
+
+struct ApproxEstimate
+{
+	Data &d;
+	ApproxEstimate(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) d.res[i] = approx_invsqrt_estimate((float)d.x[i]); }
+};
+
+struct Approx1
+{
+	Data &d;
+	Approx1(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) d.res[i] = approx_invsqrt1((float)d.x[i]); }
+};
+
+struct Approx2
+{
+	Data &d;
+	Approx2(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) d.res[i] = approx_invsqrt2((float)d.x[i]); }
+};
+
+struct InvSqrtBatch
+{
+	Data &d;
+	int accuracy;
+	InvSqrtBatch(Data &data, int acc) : d(data), accuracy(acc) {}
+	void operator ()() { invsqrt_batch(&d.res[0], &d.x[0], d.count, accuracy); }
+};
+
+struct Normalized
+{
+	Data &d;
+	Normalized(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < d.count; ++i) d.vres[i] = d.v[i].normalized(); }
+};
+
+struct NormalizeBatch
+{
+	Data &d;
+	int accuracy;
+	NormalizeBatch(Data &data, int acc) : d(data), accuracy(acc) {}
+	void operator ()() { vec3_normalize_batch(d.pvres(), d.pv(), d.count, accuracy); }
+};
+
+/* Largest relative error of res against 1 / sqrt(x) */
+static double invsqrt_error(const Data &d)
+{
+	double err = 0;
+
+	for (unsigned int i = 0; i < d.count; ++i) {
+		double ref = 1 / sqrt((double)d.x[i]);
+		double e = fabs(d.res[i] - ref) / ref;
+		err = e > err ? e : err;
+	}
+
+	return err;
+}
+
+/* Largest deviation of the normalized vectors from unit length */
+static double normalize_error(const Data &d)
+{
+	double err = 0;
+
+	for (unsigned int i = 0; i < d.count; ++i) {
+		const Vector3f &r = d.vres[i];
+		double e = fabs(sqrt((double)r.x * r.x + (double)r.y * r.y + (double)r.z * r.z) - 1);
+		err = e > err ? e : err;
+	}
+
+	return err;
+}
+
+template <class F>
+static void run_invsqrt(const char *name, Data &d, F f)
+{
+	double t = bench_measure(f);
+	bench_report(name, d.count, t, "val");
+	printf("  %-44s max rel error %.3g\n", "", invsqrt_error(d));
+	bench_consume(d.res[d.count - 1]);
+}
+
+template <class F>
+static void run_normalize(const char *name, Data &d, F f)
+{
+	double t = bench_measure(f);
+	bench_report(name, d.count, t, "vec");
+	printf("  %-44s max |len - 1| %.3g\n", "", normalize_error(d));
+	bench_consume(d.vres[d.count - 1].x);
+}
+
+int main()
+{
+	static const unsigned int sizes[] = { 4096, 1048576 };
+
+	printf("Inverse square root and normalization, %s precision\n", sizeof(scalar_t) == 4 ? "single" : "double");
+
+	for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Data d(sizes[s]);
+
+		printf("%u values\n", d.count);
+
+		run_invsqrt("1 / sqrt(x)", d, InvSqrt(d));
+		run_invsqrt("approx_invsqrt_estimate", d, ApproxEstimate(d));
+		run_invsqrt("approx_invsqrt1", d, Approx1(d));
+		run_invsqrt("approx_invsqrt2", d, Approx2(d));
+		run_invsqrt("invsqrt_batch RSQRT_ESTIMATE", d, InvSqrtBatch(d, RSQRT_ESTIMATE));
+		run_invsqrt("invsqrt_batch RSQRT_NEWTON", d, InvSqrtBatch(d, RSQRT_NEWTON));
+		run_invsqrt("invsqrt_batch RSQRT_EXACT", d, InvSqrtBatch(d, RSQRT_EXACT));
+
+		run_normalize("Vector3f::normalized", d, Normalized(d));
+		run_normalize("vec3_normalize_batch RSQRT_ESTIMATE", d, NormalizeBatch(d, RSQRT_ESTIMATE));
+		run_normalize("vec3_normalize_batch RSQRT_NEWTON", d, NormalizeBatch(d, RSQRT_NEWTON));
+		run_normalize("vec3_normalize_batch RSQRT_EXACT", d, NormalizeBatch(d, RSQRT_EXACT));
+	}
+
+	return 0;
+}
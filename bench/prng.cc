@@ -0,0 +1,131 @@
+/*
+
+    This file is part of libnmath.
+
+    prng.cc
+    Throughput of the random number generators
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "bench.h"
+#include "prng.h"
+
+#include <vector>
+
+using namespace NMath;
+
+#define COUNT 65536
+
+struct Data
+{
+	std::vector<uint32_t> u;
+	std::vector<float> f;
+	std::vector<double> d;
+	std::vector<scalar_t> s;
+	prng_philox_t state;
+
+	Data() : u(COUNT), f(COUNT), d(COUNT), s(COUNT) { prng_philox_seed(&state, 1, 0); }
+};
+
+struct C
+{
+	Data &d;
+	C(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < COUNT; ++i) d.s[i] = prng_c(0, 1); }
+};
+
+struct MultiplyWithCarry
+{
+	Data &d;
+	MultiplyWithCarry(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < COUNT; ++i) d.s[i] = prng_multiplyWithCarry(0, 1); }
+};
+
+struct PhiloxSingle
+{
+	Data &d;
+	PhiloxSingle(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < COUNT; ++i) d.s[i] = prng_philox(&d.state, 0, 1); }
+};
+
+struct PhiloxSingleFloat
+{
+	Data &d;
+	PhiloxSingleFloat(Data &data) : d(data) {}
+	void operator ()() { for (unsigned int i = 0; i < COUNT; ++i) d.f[i] = prng_philox_float(&d.state); }
+};
+
+struct FillU32
+{
+	Data &d;
+	FillU32(Data &data) : d(data) {}
+	void operator ()() { prng_philox_fill_u32(&d.state, &d.u[0], COUNT); }
+};
+
+struct FillFloat
+{
+	Data &d;
+	FillFloat(Data &data) : d(data) {}
+	void operator ()() { prng_philox_fill_float(&d.state, &d.f[0], COUNT); }
+};
+
+struct FillDouble
+{
+	Data &d;
+	FillDouble(Data &data) : d(data) {}
+	void operator ()() { prng_philox_fill_double(&d.state, &d.d[0], COUNT); }
+};
+
+struct Fill
+{
+	Data &d;
+	Fill(Data &data) : d(data) {}
+	void operator ()() { prng_philox_fill(&d.state, &d.s[0], COUNT, 0, 1); }
+};
+
+int main()
+{
+	Data d;
+
+	printf("Random number generation, %u values per call, %s precision\n", COUNT, sizeof(scalar_t) == 4 ? "single" : "double");
+
+	C c(d);
+	MultiplyWithCarry mwc(d);
+	PhiloxSingle single(d);
+	PhiloxSingleFloat single_float(d);
+	FillU32 fill_u32(d);
+	FillFloat fill_float(d);
+	FillDouble fill_double(d);
+	Fill fill(d);
+
+	bench_report("prng_c", COUNT, bench_measure(c), "num");
+	bench_report("prng_multiplyWithCarry", COUNT, bench_measure(mwc), "num");
+	bench_report("prng_philox, one at a time", COUNT, bench_measure(single), "num");
+	bench_report("prng_philox_float, one at a time", COUNT, bench_measure(single_float), "num");
+	bench_report("prng_philox_fill_u32", COUNT, bench_measure(fill_u32), "num");
+	bench_report("prng_philox_fill_float", COUNT, bench_measure(fill_float), "num");
+	bench_report("prng_philox_fill_double", COUNT, bench_measure(fill_double), "num");
+	bench_report("prng_philox_fill [0, 1)", COUNT, bench_measure(fill), "num");
+
+	bench_consume(d.s[COUNT - 1] + d.f[COUNT - 1] + d.d[COUNT - 1] + d.u[COUNT - 1]);
+
+	return 0;
+}
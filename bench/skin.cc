@@ -0,0 +1,226 @@
+/*
+
+    This file is part of libnmath.
+
+    skin.cc
+    Throughput of dual quaternion skinning
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+#include "bench.h"
+#include "dualquat.h"
+#include "matrix.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace NMath;
+
+#define BONES	64
+
+static scalar_t uniform(double a, double b)
+{
+	return (scalar_t)(a + (b - a) * rand() / RAND_MAX);
+}
+
+/* A vertex array in structure of arrays form */
+struct SoA
+{
+	std::vector<scalar_t> x, y, z;
+	vec3_soa_t v;
+
+	SoA(unsigned int n) : x(n), y(n), z(n)
+	{
+		v.x = &x[0];
+		v.y = &y[0];
+		v.z = &z[0];
+	}
+
+	Vector3f get(unsigned int i) const { return Vector3f(x[i], y[i], z[i]); }
+	void set(unsigned int i, const Vector3f &p) { x[i] = p.x; y[i] = p.y; z[i] = p.z; }
+};
+
+struct Data
+{
+	SoA pos, nrm, res_pos, res_nrm;
+	std::vector<unsigned int> bone;
+	std::vector<scalar_t> weight;
+	std::vector<DualQuaternion> bones;
+	std::vector<Matrix4x4f> palette;
+	unsigned int count;
+
+	Data(unsigned int n)
+		: pos(n), nrm(n), res_pos(n), res_nrm(n)
+		, bone(n * NMATH_SKIN_INFLUENCES), weight(n * NMATH_SKIN_INFLUENCES)
+		, bones(BONES), palette(BONES), count(n)
+	{
+		for (unsigned int b = 0; b < BONES; ++b) {
+			Vector3f axis(uniform(-1, 1), uniform(-1, 1), uniform(0.1, 1));
+			Quaternion r(axis.normalized(), uniform(-3, 3));
+			bones[b] = DualQuaternion(r, Vector3f(uniform(-5, 5), uniform(-5, 5), uniform(-5, 5)));
+			palette[b] = bones[b].to_matrix4x4();
+		}
+
+		for (unsigned int i = 0; i < n; ++i) {
+			pos.set(i, Vector3f(uniform(-1, 1), uniform(-1, 1), uniform(-1, 1)));
+			nrm.set(i, Vector3f(uniform(-1, 1), uniform(-1, 1), uniform(0.1, 1)).normalized());
+
+			/* Two to four influences of nearby bones, as in a mesh */
+			unsigned int used = 2 + rand() % 3, first = rand() % (BONES - 4);
+			scalar_t sum = 0;
+
+			for (unsigned int k = 0; k < NMATH_SKIN_INFLUENCES; ++k) {
+				bone[i * NMATH_SKIN_INFLUENCES + k] = first + k;
+				weight[i * NMATH_SKIN_INFLUENCES + k] = k < used ? uniform(0.1, 1) : 0;
+				sum += weight[i * NMATH_SKIN_INFLUENCES + k];
+			}
+
+			for (unsigned int k = 0; k < NMATH_SKIN_INFLUENCES; ++k) {
+				weight[i * NMATH_SKIN_INFLUENCES + k] /= sum;
+			}
+		}
+	}
+};
+
+struct SkinBatch
+{
+	Data &d;
+	bool normals;
+	SkinBatch(Data &data, bool n) : d(data), normals(n) {}
+
+	void operator ()()
+	{
+		DualQuaternion::skin(&d.res_pos.v, normals ? &d.res_nrm.v : 0, &d.pos.v, &d.nrm.v,
+							 &d.bone[0], &d.weight[0], &d.bones[0], d.count);
+	}
+};
+
+/* One vertex at a time with the DualQuaternion operators */
+struct SkinOperators
+{
+	Data &d;
+	SkinOperators(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < d.count; ++i) {
+			const unsigned int *b = &d.bone[i * NMATH_SKIN_INFLUENCES];
+			const scalar_t *w = &d.weight[i * NMATH_SKIN_INFLUENCES];
+			const DualQuaternion &b0 = d.bones[b[0]];
+			DualQuaternion dq = b0 * w[0];
+
+			for (unsigned int k = 1; k < NMATH_SKIN_INFLUENCES; ++k) {
+				const DualQuaternion &bk = d.bones[b[k]];
+				dq += bk * (dot(b0.real, bk.real) < 0 ? -w[k] : w[k]);
+			}
+
+			dq.normalize();
+			d.res_pos.set(i, dq.transform_point(d.pos.get(i)));
+			d.res_nrm.set(i, dq.transform_vector(d.nrm.get(i)));
+		}
+	}
+};
+
+/* Linear blend skinning, the upper 3 x 4 of the matrices blended per vertex */
+struct SkinMatrices
+{
+	Data &d;
+	SkinMatrices(Data &data) : d(data) {}
+
+	void operator ()()
+	{
+		for (unsigned int i = 0; i < d.count; ++i) {
+			const unsigned int *b = &d.bone[i * NMATH_SKIN_INFLUENCES];
+			const scalar_t *w = &d.weight[i * NMATH_SKIN_INFLUENCES];
+			scalar_t m[3][4] = { { 0 } };
+
+			for (unsigned int k = 0; k < NMATH_SKIN_INFLUENCES; ++k) {
+				const Matrix4x4f &p = d.palette[b[k]];
+
+				for (unsigned int r = 0; r < 3; ++r) {
+					for (unsigned int c = 0; c < 4; ++c) {
+						m[r][c] += p.data[r][c] * w[k];
+					}
+				}
+			}
+
+			Vector3f v = d.pos.get(i), n = d.nrm.get(i);
+
+			d.res_pos.set(i, Vector3f(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3],
+									  m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3],
+									  m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3]));
+			d.res_nrm.set(i, Vector3f(m[0][0] * n.x + m[0][1] * n.y + m[0][2] * n.z,
+									  m[1][0] * n.x + m[1][1] * n.y + m[1][2] * n.z,
+									  m[2][0] * n.x + m[2][1] * n.y + m[2][2] * n.z));
+		}
+	}
+};
+
+/* Largest coordinate difference between the batch kernel and the operators */
+static double skin_error(Data &d)
+{
+	SkinBatch batch(d, true);
+	SkinOperators operators(d);
+
+	batch();
+	SoA pos = d.res_pos, nrm = d.res_nrm;
+	operators();
+
+	double err = 0;
+
+	for (unsigned int i = 0; i < d.count; ++i) {
+		double e = (pos.get(i) - d.res_pos.get(i)).length() + (nrm.get(i) - d.res_nrm.get(i)).length();
+		err = e > err ? e : err;
+	}
+
+	return err;
+}
+
+template <class F>
+static void run(const char *name, Data &d, F f)
+{
+	double t = bench_measure(f);
+	bench_report(name, d.count, t, "vert");
+	bench_consume(d.res_pos.x[d.count - 1]);
+}
+
+int main()
+{
+	static const unsigned int sizes[] = { 8192, 262144 };
+
+	printf("Skinning against %u bones, %u influences, %s precision\n", BONES, NMATH_SKIN_INFLUENCES,
+		   sizeof(scalar_t) == 4 ? "single" : "double");
+
+	for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+		Data d(sizes[s]);
+
+		printf("%u vertices\n", d.count);
+
+		run("DualQuaternion::skin, positions and normals", d, SkinBatch(d, true));
+		run("DualQuaternion::skin, positions", d, SkinBatch(d, false));
+		run("DualQuaternion operators per vertex", d, SkinOperators(d));
+		run("Matrix4x4f palette per vertex", d, SkinMatrices(d));
+
+		printf("  %-44s max difference %.3g\n", "skin against the operators", skin_error(d));
+	}
+
+	return 0;
+}
@@ -26,6 +26,7 @@
 */
 
 #include "aabb.h"
+#include "simd.h"
 
 #ifdef __cplusplus
 	#include <iostream>
@@ -33,10 +34,140 @@
 
 namespace NMath {
 
+/*
+	Batch overlap tests. A kernel tests NMATH_SCALAR_LANES boxes at once
+	with lanes() and returns one bit per box, the boxes past the last full
+	group go through test() one by one.
+*/
+class AABBOverlapKernel
+{
+	public:
+		AABBOverlapKernel(const aabb3_t &b)
+			: m_box(b)
+		{
+#ifdef NMATH_SCALAR_LANES
+			m_min[0] = scalar_v_set(b.min.x);
+			m_min[1] = scalar_v_set(b.min.y);
+			m_min[2] = scalar_v_set(b.min.z);
+			m_max[0] = scalar_v_set(b.max.x);
+			m_max[1] = scalar_v_set(b.max.y);
+			m_max[2] = scalar_v_set(b.max.z);
+#endif /* NMATH_SCALAR_LANES */
+		}
+
+#ifdef NMATH_SCALAR_LANES
+		inline unsigned int lanes(const aabb3_soa_t &s, unsigned int i) const
+		{
+			scalar_v r = scalar_v_and(scalar_v_le(m_min[0], scalar_v_load(s.max.x + i)),
+									  scalar_v_le(scalar_v_load(s.min.x + i), m_max[0]));
+			r = scalar_v_and(r, scalar_v_and(scalar_v_le(m_min[1], scalar_v_load(s.max.y + i)),
+											 scalar_v_le(scalar_v_load(s.min.y + i), m_max[1])));
+			r = scalar_v_and(r, scalar_v_and(scalar_v_le(m_min[2], scalar_v_load(s.max.z + i)),
+											 scalar_v_le(scalar_v_load(s.min.z + i), m_max[2])));
+			return scalar_v_bits(r);
+		}
+#endif /* NMATH_SCALAR_LANES */
+
+		inline unsigned int test(const aabb3_soa_t &s, unsigned int i) const
+		{
+			aabb3_t b;
+			b.min = vec3_pack(s.min.x[i], s.min.y[i], s.min.z[i]);
+			b.max = vec3_pack(s.max.x[i], s.max.y[i], s.max.z[i]);
+			return aabb3_overlaps(m_box, b);
+		}
+
+	private:
+		aabb3_t m_box;
+#ifdef NMATH_SCALAR_LANES
+		scalar_v m_min[3], m_max[3];
+#endif /* NMATH_SCALAR_LANES */
+};
+
+/* Arvo's test, the distance along each axis is max(min - c, c - max, 0) */
+class AABBSphereKernel
+{
+	public:
+		AABBSphereKernel(const vec3_t &center, scalar_t radius)
+			: m_center(center)
+			, m_radius(radius)
+		{
+#ifdef NMATH_SCALAR_LANES
+			m_c[0] = scalar_v_set(center.x);
+			m_c[1] = scalar_v_set(center.y);
+			m_c[2] = scalar_v_set(center.z);
+			m_r2 = scalar_v_set(radius * radius);
+#endif /* NMATH_SCALAR_LANES */
+		}
+
+#ifdef NMATH_SCALAR_LANES
+		inline unsigned int lanes(const aabb3_soa_t &s, unsigned int i) const
+		{
+			const scalar_v zero = scalar_v_set(0);
+
+			scalar_v dx = scalar_v_max(scalar_v_max(scalar_v_sub(scalar_v_load(s.min.x + i), m_c[0]),
+													scalar_v_sub(m_c[0], scalar_v_load(s.max.x + i))), zero);
+			scalar_v dy = scalar_v_max(scalar_v_max(scalar_v_sub(scalar_v_load(s.min.y + i), m_c[1]),
+													scalar_v_sub(m_c[1], scalar_v_load(s.max.y + i))), zero);
+			scalar_v dz = scalar_v_max(scalar_v_max(scalar_v_sub(scalar_v_load(s.min.z + i), m_c[2]),
+													scalar_v_sub(m_c[2], scalar_v_load(s.max.z + i))), zero);
+
+			scalar_v d = scalar_v_add(scalar_v_add(scalar_v_mul(dx, dx), scalar_v_mul(dy, dy)), scalar_v_mul(dz, dz));
+			return scalar_v_bits(scalar_v_le(d, m_r2));
+		}
+#endif /* NMATH_SCALAR_LANES */
+
+		inline unsigned int test(const aabb3_soa_t &s, unsigned int i) const
+		{
+			aabb3_t b;
+			b.min = vec3_pack(s.min.x[i], s.min.y[i], s.min.z[i]);
+			b.max = vec3_pack(s.max.x[i], s.max.y[i], s.max.z[i]);
+			return aabb3_overlaps_sphere(b, m_center, m_radius);
+		}
+
+	private:
+		vec3_t m_center;
+		scalar_t m_radius;
+#ifdef NMATH_SCALAR_LANES
+		scalar_v m_c[3], m_r2;
+#endif /* NMATH_SCALAR_LANES */
+};
+
+template <class K>
+static void aabb3_overlaps_kernel(const K &k, const aabb3_soa_t &boxes, unsigned int count, uint32_t *mask)
+{
+	for (unsigned int first = 0; first < count; first += 32) {
+		unsigned int n = count - first < 32 ? count - first : 32;
+		uint32_t bits = 0;
+		unsigned int j = 0;
+
+#ifdef NMATH_SCALAR_LANES
+		for (; j + NMATH_SCALAR_LANES <= n; j += NMATH_SCALAR_LANES) {
+			bits |= (uint32_t)k.lanes(boxes, first + j) << j;
+		}
+#endif /* NMATH_SCALAR_LANES */
+
+		for (; j < n; ++j) {
+			bits |= (uint32_t)k.test(boxes, first + j) << j;
+		}
+
+		mask[first / 32] = bits;
+	}
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif	/* __cplusplus */
 
+void aabb3_overlaps_batch(aabb3_t b, aabb3_soa_t boxes, unsigned int count, uint32_t *mask)
+{
+	aabb3_overlaps_kernel(AABBOverlapKernel(b), boxes, count, mask);
+}
+
+void aabb3_overlaps_sphere_batch(vec3_t center, scalar_t radius, aabb3_soa_t boxes, unsigned int count, uint32_t *mask)
+{
+	aabb3_overlaps_kernel(AABBSphereKernel(center, radius), boxes, count, mask);
+}
+
 #ifdef __cplusplus
 }
 
@@ -58,6 +189,15 @@ BoundingBox3::BoundingBox3(const Vector3f& a, const Vector3f& b)
     max=Vector3f( (a.x>=b.x)? a.x : b.x, (a.y>=b.y)? a.y : b.y, (a.z>=b.z)? a.z : b.z );
 }
 
+void BoundingBox3::overlaps(const aabb3_soa_t &boxes, unsigned int count, uint32_t *mask) const
+{
+	aabb3_t b;
+	b.min = vec3_pack(min.x, min.y, min.z);
+	b.max = vec3_pack(max.x, max.y, max.z);
+
+	aabb3_overlaps_batch(b, boxes, count, mask);
+}
+
 /*
 	ray - axis aligned bounding box intersection test based on:
 	"An Efficient and Robust Ray-Box Intersection Algorithm",
@@ -34,6 +34,8 @@
 #include "vector.h"
 #include "ray.h"
 
+#include <stdint.h>
+
 namespace NMath {
 
 #ifdef __cplusplus
@@ -42,18 +44,29 @@ extern "C" {
 
 /* C 2D bounding box functions */
 static inline aabb2_t aabb2_pack(vec2_t a, vec2_t b);
-static inline short aabb2_contains(aabb2_t b, vec2_t v);            // returns 0 if the given point is within the bounds of the box, else 1
+static inline short aabb2_contains(aabb2_t b, vec2_t v);            // returns 1 if the given point is within the bounds of the box, else 0
 static inline vec2_t aabb2_center(aabb2_t b);                       // returns the center coordinates of the box
 static inline aabb2_t aabb2_augment_by_vec(aabb2_t s, vec2_t v);    // augments the bounding box to include the given vector
 static inline aabb2_t aabb2_augment_by_aabb(aabb2_t s, aabb2_t b);  // augments the bounding box to include the given bounding box
 
 /* C 3D bounding box functions */
 static inline aabb3_t aabb3_pack(vec3_t a, vec3_t b);
-static inline short aabb3_contains(aabb3_t b, vec3_t v);            // returns 0 if the given point is within the bounds of the box, else 1
+static inline short aabb3_contains(aabb3_t b, vec3_t v);            // returns 1 if the given point is within the bounds of the box, else 0
+static inline short aabb3_overlaps(aabb3_t a, aabb3_t b);           // returns 1 if the boxes share at least a point, else 0
+static inline short aabb3_overlaps_sphere(aabb3_t b, vec3_t center, scalar_t radius);  // returns 1 if the box and the sphere share at least a point, else 0
 static inline vec3_t aabb3_center(aabb3_t b);                       // returns the center coordinates of the box
 static inline aabb3_t aabb3_augment_by_vec(aabb3_t s, vec3_t v);    // augments the bounding box to include the given vector
 static inline aabb3_t aabb3_augment_by_aabb(aabb3_t s, aabb3_t b);  // augments the bounding box to include the given bounding box
 
+/*
+	Batch overlap tests of one box or sphere against count boxes, for broad
+	phase collision. Bit i % 32 of mask[i / 32] is set if box i overlaps,
+	the bits past count in the last word are cleared. The boxes are tested
+	NMATH_SCALAR_LANES at a time where simd.h provides the lanes.
+*/
+NMATH_DECLSPEC void aabb3_overlaps_batch(aabb3_t b, aabb3_soa_t boxes, unsigned int count, uint32_t *mask);
+NMATH_DECLSPEC void aabb3_overlaps_sphere_batch(vec3_t center, scalar_t radius, aabb3_soa_t boxes, unsigned int count, uint32_t *mask);
+
 #ifdef __cplusplus
 }
 
@@ -82,9 +95,16 @@ class NMATH_DECLSPEC BoundingBox3
         BoundingBox3(const Vector3f& a, const Vector3f& b);
 
         inline bool contains(const Vector3f& p) const;           // returns true if the given point is within the bounds of the box, else false
-		inline bool contains(const BoundingBox3 &aabb) const;
+		inline bool contains(const BoundingBox3 &aabb) const;    // returns true if the boxes share at least a point (same as overlaps)
+		inline bool encloses(const BoundingBox3 &aabb) const;    // returns true if the given box is entirely within the box
+		inline bool overlaps(const BoundingBox3 &aabb) const;    // returns true if the boxes share at least a point
+		inline bool overlaps(const Vector3f &center, scalar_t radius) const;  // the same for a sphere
+
+		void overlaps(const aabb3_soa_t &boxes, unsigned int count, uint32_t *mask) const;  // aabb3_overlaps_batch
 
         inline Vector3f center() const;                          // returns the center coordinates of the box
+        inline Vector3f closest_point(const Vector3f& p) const;  // returns the point of the box closest to p, p itself if it is inside
+        inline scalar_t distance_squared(const Vector3f& p) const;  // returns the squared distance of p from the box, 0 if it is inside
 
         inline void augment(const Vector3f& v);                  // augments the bounding box to include the given vector
         inline void augment(const BoundingBox3& b);              // augments the bounding box to include the given bounding box
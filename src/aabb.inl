@@ -56,7 +56,7 @@ static inline aabb2_t aabb2_pack(vec2_t a, vec2_t b)
 
 static inline short aabb2_contains(aabb2_t b, vec2_t v)
 {
-    return ( (v.x>=b.min.x) && (v.y>=b.min.y) && (v.x<=b.max.x) && (v.y<=b.max.y) )? 0 : 1;
+    return ( (v.x>=b.min.x) && (v.y>=b.min.y) && (v.x<=b.max.x) && (v.y<=b.max.y) )? 1 : 0;
 }
 
 static inline vec2_t aabb2_center(aabb2_t b)
@@ -94,14 +94,41 @@ static inline aabb3_t aabb3_pack(vec3_t a, vec3_t b)
 
 	box.max.x = (a.x>=b.x)? a.x : b.x;
 	box.max.y = (a.y>=b.y)? a.y : b.y;
-	box.min.z = (a.z>=b.z)? a.z : b.z;
+	box.max.z = (a.z>=b.z)? a.z : b.z;
 
 	return box;
 }
 
 static inline short aabb3_contains(aabb3_t b, vec3_t v)
 {
-    return ( (v.x>=b.min.x) && (v.y>=b.min.y) && (v.z>=b.min.z) && (v.x<=b.max.x) && (v.y<=b.max.y) && (v.z<=b.min.z) )? 0 : 1;
+    return ( (v.x>=b.min.x) && (v.y>=b.min.y) && (v.z>=b.min.z) && (v.x<=b.max.x) && (v.y<=b.max.y) && (v.z<=b.max.z) )? 1 : 0;
+}
+
+static inline short aabb3_overlaps(aabb3_t a, aabb3_t b)
+{
+    return ( (a.min.x<=b.max.x) && (b.min.x<=a.max.x) && (a.min.y<=b.max.y) && (b.min.y<=a.max.y)
+          && (a.min.z<=b.max.z) && (b.min.z<=a.max.z) )? 1 : 0;
+}
+
+/*
+	Arvo's test, "A Simple Method for Box-Sphere Intersection Testing",
+	Graphics Gems, 1990: the squared distance of the center from the box
+	against the squared radius.
+*/
+static inline short aabb3_overlaps_sphere(aabb3_t b, vec3_t center, scalar_t radius)
+{
+    scalar_t d, dist = 0;
+
+    if(center.x < b.min.x) { d = b.min.x - center.x; dist += d * d; }
+    else if(center.x > b.max.x) { d = center.x - b.max.x; dist += d * d; }
+
+    if(center.y < b.min.y) { d = b.min.y - center.y; dist += d * d; }
+    else if(center.y > b.max.y) { d = center.y - b.max.y; dist += d * d; }
+
+    if(center.z < b.min.z) { d = b.min.z - center.z; dist += d * d; }
+    else if(center.z > b.max.z) { d = center.z - b.max.z; dist += d * d; }
+
+    return (dist <= radius * radius)? 1 : 0;
 }
 
 static inline vec3_t aabb3_center(aabb3_t b)
@@ -173,9 +200,20 @@ inline bool BoundingBox3::contains(const Vector3f& p) const
     return (p.x>= min.x) && (p.y>=min.y) && (p.z>=min.z) && (p.x<=max.x) && (p.y<=max.y) && (p.z<=max.z);
 }
 
+// This has always been an overlap test, encloses is the containment test.
 inline bool BoundingBox3::contains(const BoundingBox3 &aabb) const
 {
+    return overlaps(aabb);
+}
+
+inline bool BoundingBox3::encloses(const BoundingBox3 &aabb) const
+{
+    return (aabb.min.x>=min.x) && (aabb.min.y>=min.y) && (aabb.min.z>=min.z)
+        && (aabb.max.x<=max.x) && (aabb.max.y<=max.y) && (aabb.max.z<=max.z);
+}
 
+inline bool BoundingBox3::overlaps(const BoundingBox3 &aabb) const
+{
 	if(min.x > aabb.max.x || aabb.min.x > max.x) {
 		return false;
 	}
@@ -191,11 +229,29 @@ inline bool BoundingBox3::contains(const BoundingBox3 &aabb) const
 	return true;
 }
 
+inline bool BoundingBox3::overlaps(const Vector3f &center, scalar_t radius) const
+{
+    return distance_squared(center) <= radius * radius;
+}
+
 inline Vector3f BoundingBox3::center() const
 {
     return (min + max) / 2.f;
 }
 
+inline Vector3f BoundingBox3::closest_point(const Vector3f& p) const
+{
+    return Vector3f(p.x < min.x ? min.x : (p.x > max.x ? max.x : p.x),
+                    p.y < min.y ? min.y : (p.y > max.y ? max.y : p.y),
+                    p.z < min.z ? min.z : (p.z > max.z ? max.z : p.z));
+}
+
+inline scalar_t BoundingBox3::distance_squared(const Vector3f& p) const
+{
+    Vector3f d = closest_point(p) - p;
+    return dot(d, d);
+}
+
 inline void BoundingBox3::augment(const Vector3f& v)
 {
     if(v.x > max.x)	max.x = v.x;
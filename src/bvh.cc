@@ -0,0 +1,636 @@
+/*
+
+    This file is part of libnmath.
+
+    bvh.cc
+    Bounding volume hierarchy
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include <stdlib.h>
+
+#include "bvh.h"
+
+/* Heap entries of a query kept on the stack before it allocates */
+#define NMATH_BVH_HEAP_SIZE	64
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+PointInfo::PointInfo()
+	: distance(0)
+	, index(0)
+	, geometry(0)
+{}
+
+/* Squared distance limit of a query */
+static inline scalar_t bvh_radius(scalar_t max_distance)
+{
+	return max_distance < nmath_sqrt(SCALAR_T_MAX) ? max_distance * max_distance : SCALAR_T_MAX;
+}
+
+/*
+	Build
+*/
+
+/* Reorder index[lo, hi) so that index[k] has the median center along axis */
+static void bvh_select(unsigned int *index, const Vector3f *center, unsigned int axis, int lo, int hi, int k)
+{
+	while (hi - lo > 1) {
+		scalar_t pivot = center[index[lo + (hi - lo) / 2]][axis];
+		int i = lo, j = hi - 1;
+
+		while (i <= j) {
+			while (center[index[i]][axis] < pivot) {
+				++i;
+			}
+
+			while (center[index[j]][axis] > pivot) {
+				--j;
+			}
+
+			if (i <= j) {
+				unsigned int tmp = index[i];
+				index[i++] = index[j];
+				index[j--] = tmp;
+			}
+		}
+
+		/* index[lo, j] <= pivot <= index[i, hi) */
+		if (k <= j) {
+			hi = j + 1;
+		}
+		else if (k >= i) {
+			lo = i;
+		}
+		else {
+			return;
+		}
+	}
+}
+
+static void bvh_build_node(BVHNode *node, unsigned int *used, unsigned int *index, const Geometry *const *geometry,
+						   const Vector3f *center, unsigned int n, unsigned int first, unsigned int count)
+{
+	BoundingBox3 aabb = geometry[index[first]]->aabb;
+	BoundingBox3 centers(center[index[first]], center[index[first]]);
+
+	for (unsigned int i = first + 1; i < first + count; ++i) {
+		aabb.augment(geometry[index[i]]->aabb);
+		centers.augment(center[index[i]]);
+	}
+
+	node[n].aabb = aabb;
+
+	if (count <= NMATH_BVH_LEAF_SIZE) {
+		node[n].first = first;
+		node[n].count = count;
+		return;
+	}
+
+	Vector3f extent = centers.max - centers.min;
+	unsigned int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+	unsigned int half = count / 2;
+
+	bvh_select(index, center, axis, first, first + count, first + half);
+
+	unsigned int child = *used;
+	*used += 2;
+
+	node[n].first = child;
+	node[n].count = 0;
+
+	bvh_build_node(node, used, index, geometry, center, child, first, half);
+	bvh_build_node(node, used, index, geometry, center, child + 1, first + half, count - half);
+}
+
+BVH::BVH()
+	: m_geometry(0)
+	, m_index(0)
+	, m_node(0)
+	, m_count(0)
+	, m_node_count(0)
+	, m_bounded(0)
+{}
+
+BVH::~BVH()
+{
+	release();
+}
+
+int BVH::build(const Geometry *const *geometry, unsigned int count)
+{
+	release();
+
+	if (!count) {
+		return 0;
+	}
+
+	m_geometry = (const Geometry **)malloc(count * sizeof(const Geometry *));
+	m_index = (unsigned int *)malloc(count * sizeof(unsigned int));
+	m_node = (BVHNode *)malloc((2 * count - 1) * sizeof(BVHNode));
+
+	Vector3f *center = (Vector3f *)malloc(count * sizeof(Vector3f));
+
+	if (!m_geometry || !m_index || !m_node || !center) {
+		free(center);
+		release();
+		return -1;
+	}
+
+	m_count = count;
+
+	/* Bounded geometry first, unbounded at the end */
+	unsigned int head = 0, tail = count;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		const BoundingBox3 &aabb = geometry[i]->aabb;
+
+		m_geometry[i] = geometry[i];
+		center[i] = aabb.center();
+
+		bool bounded = aabb.max.x - aabb.min.x < SCALAR_T_MAX
+					&& aabb.max.y - aabb.min.y < SCALAR_T_MAX
+					&& aabb.max.z - aabb.min.z < SCALAR_T_MAX;
+
+		m_index[bounded ? head++ : --tail] = i;
+	}
+
+	m_bounded = head;
+
+	if (m_bounded) {
+		m_node_count = 1;
+		bvh_build_node(m_node, &m_node_count, m_index, m_geometry, center, 0, 0, m_bounded);
+	}
+
+	free(center);
+	return 0;
+}
+
+void BVH::release()
+{
+	free(m_geometry);
+	free(m_index);
+	free(m_node);
+
+	m_geometry = 0;
+	m_index = 0;
+	m_node = 0;
+	m_count = m_node_count = m_bounded = 0;
+}
+
+/*
+	Traversal
+*/
+
+struct bvh_entry_t
+{
+	scalar_t distance;		/* squared, of the node box */
+	unsigned int node;
+};
+
+/* Binary min heap of nodes, on the stack until it outgrows it */
+class BVHHeap
+{
+	public:
+		BVHHeap()
+			: m_data(m_local)
+			, m_size(0)
+			, m_capacity(NMATH_BVH_HEAP_SIZE)
+		{}
+
+		~BVHHeap()
+		{
+			if (m_data != m_local) {
+				free(m_data);
+			}
+		}
+
+		inline bool empty() const
+		{
+			return !m_size;
+		}
+
+		/* Return false if the heap is full and could not grow */
+		bool push(scalar_t distance, unsigned int node)
+		{
+			if (m_size == m_capacity && !grow()) {
+				return false;
+			}
+
+			unsigned int i = m_size++;
+
+			while (i && m_data[(i - 1) / 2].distance > distance) {
+				m_data[i] = m_data[(i - 1) / 2];
+				i = (i - 1) / 2;
+			}
+
+			m_data[i].distance = distance;
+			m_data[i].node = node;
+			return true;
+		}
+
+		bvh_entry_t pop()
+		{
+			bvh_entry_t top = m_data[0];
+			bvh_entry_t last = m_data[--m_size];
+			unsigned int i = 0;
+
+			for (;;) {
+				unsigned int c = 2 * i + 1;
+
+				if (c >= m_size) {
+					break;
+				}
+
+				if (c + 1 < m_size && m_data[c + 1].distance < m_data[c].distance) {
+					++c;
+				}
+
+				if (m_data[c].distance >= last.distance) {
+					break;
+				}
+
+				m_data[i] = m_data[c];
+				i = c;
+			}
+
+			if (m_size) {
+				m_data[i] = last;
+			}
+
+			return top;
+		}
+
+	private:
+		bool grow()
+		{
+			bvh_entry_t *data = (bvh_entry_t *)malloc(2 * m_capacity * sizeof(bvh_entry_t));
+
+			if (!data) {
+				return false;
+			}
+
+			for (unsigned int i = 0; i < m_size; ++i) {
+				data[i] = m_data[i];
+			}
+
+			if (m_data != m_local) {
+				free(m_data);
+			}
+
+			m_data = data;
+			m_capacity *= 2;
+			return true;
+		}
+
+		bvh_entry_t m_local[NMATH_BVH_HEAP_SIZE];
+		bvh_entry_t *m_data;
+		unsigned int m_size;
+		unsigned int m_capacity;
+};
+
+/*
+	Query of the closest geometry. radius is the squared distance that a
+	node has to beat to be visited.
+*/
+class BVHClosestQuery
+{
+	public:
+		BVHClosestQuery(const Vector3f &p, const Geometry **geometry, scalar_t radius)
+			: point(p)
+			, radius(radius)
+			, index(0)
+			, found(false)
+			, m_geometry(geometry)
+		{}
+
+		inline void test(unsigned int i)
+		{
+			Vector3f q = m_geometry[i]->closest_point(point);
+			Vector3f d = q - point;
+			scalar_t distance = dot(d, d);
+
+			if (distance < radius) {
+				radius = distance;
+				closest = q;
+				index = i;
+				found = true;
+			}
+		}
+
+		const Vector3f point;
+		scalar_t radius;
+
+		Vector3f closest;
+		unsigned int index;
+		bool found;
+
+	private:
+		const Geometry **m_geometry;
+};
+
+/*
+	Query of the k nearest geometries. The results are a max heap by the
+	squared distance until the end of the query, so the farthest is the
+	one replaced.
+*/
+class BVHNearestQuery
+{
+	public:
+		BVHNearestQuery(const Vector3f &p, const Geometry **geometry, scalar_t radius, PointInfo *info, unsigned int k)
+			: point(p)
+			, radius(radius)
+			, found(0)
+			, m_geometry(geometry)
+			, m_info(info)
+			, m_k(k)
+		{}
+
+		inline void test(unsigned int i)
+		{
+			Vector3f q = m_geometry[i]->closest_point(point);
+			Vector3f d = q - point;
+			scalar_t distance = dot(d, d);
+
+			if (distance >= radius) {
+				return;
+			}
+
+			unsigned int j;
+
+			if (found < m_k) {
+				/* Sift up from the end */
+				j = found++;
+
+				while (j && m_info[(j - 1) / 2].distance < distance) {
+					m_info[j] = m_info[(j - 1) / 2];
+					j = (j - 1) / 2;
+				}
+			}
+			else {
+				/* Replace the farthest and sift down */
+				j = 0;
+
+				for (;;) {
+					unsigned int c = 2 * j + 1;
+
+					if (c >= found) {
+						break;
+					}
+
+					if (c + 1 < found && m_info[c + 1].distance > m_info[c].distance) {
+						++c;
+					}
+
+					if (m_info[c].distance <= distance) {
+						break;
+					}
+
+					m_info[j] = m_info[c];
+					j = c;
+				}
+			}
+
+			m_info[j].point = q;
+			m_info[j].distance = distance;
+			m_info[j].index = i;
+			m_info[j].geometry = m_geometry[i];
+
+			if (found == m_k) {
+				radius = m_info[0].distance;
+			}
+		}
+
+		const Vector3f point;
+		scalar_t radius;
+		unsigned int found;
+
+	private:
+		const Geometry **m_geometry;
+		PointInfo *m_info;
+		unsigned int m_k;
+};
+
+/* Depth first descent of a subtree, for when the heap cannot grow */
+template <class Q>
+static void bvh_descend(const BVHNode *node, const unsigned int *index, Q &q, unsigned int n)
+{
+	const BVHNode &nd = node[n];
+
+	if (nd.count) {
+		for (unsigned int i = 0; i < nd.count; ++i) {
+			q.test(index[nd.first + i]);
+		}
+		return;
+	}
+
+	for (unsigned int c = nd.first; c < nd.first + 2; ++c) {
+		if (node[c].aabb.distance_squared(q.point) < q.radius) {
+			bvh_descend(node, index, q, c);
+		}
+	}
+}
+
+template <class Q>
+static void bvh_traverse(const BVHNode *node, const unsigned int *index, Q &q)
+{
+	BVHHeap heap;
+	scalar_t distance = node[0].aabb.distance_squared(q.point);
+
+	if (distance < q.radius) {
+		heap.push(distance, 0);
+	}
+
+	while (!heap.empty()) {
+		bvh_entry_t e = heap.pop();
+
+		/* Every node left is at least as far */
+		if (e.distance >= q.radius) {
+			break;
+		}
+
+		const BVHNode &nd = node[e.node];
+
+		if (nd.count) {
+			for (unsigned int i = 0; i < nd.count; ++i) {
+				q.test(index[nd.first + i]);
+			}
+			continue;
+		}
+
+		for (unsigned int c = nd.first; c < nd.first + 2; ++c) {
+			distance = node[c].aabb.distance_squared(q.point);
+
+			if (distance < q.radius && !heap.push(distance, c)) {
+				bvh_descend(node, index, q, c);
+			}
+		}
+	}
+}
+
+bool BVH::closest_point(const Vector3f &p, PointInfo *info, scalar_t max_distance) const
+{
+	BVHClosestQuery q(p, m_geometry, bvh_radius(max_distance));
+
+	for (unsigned int i = m_bounded; i < m_count; ++i) {
+		q.test(m_index[i]);
+	}
+
+	if (m_node_count) {
+		bvh_traverse(m_node, m_index, q);
+	}
+
+	if (!q.found) {
+		info->geometry = 0;
+		return false;
+	}
+
+	info->point = q.closest;
+	info->distance = nmath_sqrt(q.radius);
+	info->index = q.index;
+	info->geometry = m_geometry[q.index];
+	return true;
+}
+
+void BVH::closest_point(const Vector3f *p, unsigned int count, PointInfo *info, scalar_t max_distance) const
+{
+	#pragma omp parallel for schedule(dynamic, 64) if(count > 256)
+	for (int i = 0; i < (int)count; ++i) {
+		closest_point(p[i], info + i, max_distance);
+	}
+}
+
+unsigned int BVH::nearest(const Vector3f &p, unsigned int k, PointInfo *info, scalar_t max_distance) const
+{
+	if (!k) {
+		return 0;
+	}
+
+	BVHNearestQuery q(p, m_geometry, bvh_radius(max_distance), info, k);
+
+	for (unsigned int i = m_bounded; i < m_count; ++i) {
+		q.test(m_index[i]);
+	}
+
+	if (m_node_count) {
+		bvh_traverse(m_node, m_index, q);
+	}
+
+	/* Heap sort the results, nearest first */
+	for (unsigned int n = q.found; n > 1; --n) {
+		PointInfo last = info[n - 1];
+		unsigned int j = 0;
+
+		info[n - 1] = info[0];
+
+		for (;;) {
+			unsigned int c = 2 * j + 1;
+
+			if (c >= n - 1) {
+				break;
+			}
+
+			if (c + 1 < n - 1 && info[c + 1].distance > info[c].distance) {
+				++c;
+			}
+
+			if (info[c].distance <= last.distance) {
+				break;
+			}
+
+			info[j] = info[c];
+			j = c;
+		}
+
+		info[j] = last;
+	}
+
+	for (unsigned int i = 0; i < q.found; ++i) {
+		info[i].distance = nmath_sqrt(info[i].distance);
+	}
+
+	return q.found;
+}
+
+/*
+	Frustum culling. A node passes on the planes that its box is not yet
+	inside of, and once there are none left its subtree is taken whole.
+*/
+static void bvh_cull(const BVHNode *node, const unsigned int *index, const Geometry **geometry, const Frustum &frustum,
+					 unsigned int n, unsigned int planes, unsigned int *res, unsigned int max, unsigned int *found)
+{
+	const BVHNode &nd = node[n];
+
+	if (planes && frustum.classify(nd.aabb, &planes) == FRUSTUM_OUTSIDE) {
+		return;
+	}
+
+	if (nd.count) {
+		for (unsigned int i = 0; i < nd.count; ++i) {
+			unsigned int g = index[nd.first + i];
+			unsigned int p = planes;
+
+			if (p && frustum.classify(geometry[g]->aabb, &p) == FRUSTUM_OUTSIDE) {
+				continue;
+			}
+
+			if (*found < max) {
+				res[*found] = g;
+			}
+
+			++*found;
+		}
+		return;
+	}
+
+	bvh_cull(node, index, geometry, frustum, nd.first, planes, res, max, found);
+	bvh_cull(node, index, geometry, frustum, nd.first + 1, planes, res, max, found);
+}
+
+unsigned int BVH::cull(const Frustum &frustum, unsigned int *index, unsigned int max) const
+{
+	unsigned int found = 0;
+
+	if (m_node_count) {
+		bvh_cull(m_node, m_index, m_geometry, frustum, 0, NMATH_FRUSTUM_ALL_PLANES, index, max, &found);
+	}
+
+	for (unsigned int i = m_bounded; i < m_count; ++i) {
+		if (found < max) {
+			index[found] = m_index[i];
+		}
+
+		++found;
+	}
+
+	return found;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
@@ -0,0 +1,145 @@
+/*
+
+    This file is part of libnmath.
+
+    bvh.h
+    Bounding volume hierarchy
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_BVH_H_INCLUDED
+#define NMATH_BVH_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "vector.h"
+#include "aabb.h"
+#include "geometry.h"
+#include "frustum.h"
+
+/* Most geometry in a leaf */
+#define NMATH_BVH_LEAF_SIZE	4
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/* Result of a point query */
+class NMATH_DECLSPEC PointInfo
+{
+	public:
+		PointInfo();
+
+		Vector3f point;				/* closest point of the geometry */
+		scalar_t distance;
+		unsigned int index;			/* of the geometry in the array given to BVH::build */
+
+		const Geometry* geometry;	/* 0 if nothing was found */
+};
+
+struct BVHNode
+{
+	BoundingBox3 aabb;
+	unsigned int first;		/* first child of an inner node, the children are adjacent */
+	unsigned int count;		/* geometry in a leaf, 0 for an inner node */
+};
+
+/*
+	Bounding volume hierarchy for point queries. The geometry is split at
+	the median of the box centers along the longest axis, down to
+	NMATH_BVH_LEAF_SIZE per leaf. Geometry with an unbounded box, such as a
+	Plane, is kept out of the tree and tested by every query.
+
+	The queries visit the nodes best first, in order of the distance of
+	their boxes from the point, from a binary heap, and stop when the
+	nearest box left is farther than the best distance found so far.
+
+	The answers are as exact as the closest_point() of the geometry.
+	Geometry that keeps the default of Geometry answers with its box, so
+	its point may be off the surface and its distance is a lower bound.
+
+	The BVH keeps pointers to the geometry, which has to stay alive and
+	unchanged, with calc_aabb() called, while the BVH is in use. It is not
+	copyable, the queries are const and can run from several threads.
+*/
+class NMATH_DECLSPEC BVH
+{
+	public:
+		BVH();
+		~BVH();
+
+		/* Return 0 on success, -1 if the allocation failed */
+		int build(const Geometry *const *geometry, unsigned int count);
+		void release();
+
+		inline unsigned int count() const;
+		inline unsigned int node_count() const;
+		inline const BVHNode *nodes() const;
+
+		/*
+			Closest point of all the geometry to p, not farther than
+			max_distance. Return false, with info->geometry = 0, if there is
+			none.
+		*/
+		bool closest_point(const Vector3f &p, PointInfo *info, scalar_t max_distance = SCALAR_T_MAX) const;
+
+		/* The same for count points, spread over threads with OpenMP */
+		void closest_point(const Vector3f *p, unsigned int count, PointInfo *info, scalar_t max_distance = SCALAR_T_MAX) const;
+
+		/*
+			The k geometries nearest to p, not farther than max_distance,
+			nearest first. Return how many were found, at most k.
+		*/
+		unsigned int nearest(const Vector3f &p, unsigned int k, PointInfo *info, scalar_t max_distance = SCALAR_T_MAX) const;
+
+		/*
+			Indices of the geometry whose boxes the frustum does not cull,
+			unbounded geometry included. Write at most max of them and
+			return how many there are.
+		*/
+		unsigned int cull(const Frustum &frustum, unsigned int *index, unsigned int max) const;
+
+	private:
+		BVH(const BVH &);
+		BVH &operator =(const BVH &);
+
+		const Geometry **m_geometry;	/* as given to build */
+		unsigned int *m_index;			/* geometry of the leaves, then the unbounded geometry */
+		BVHNode *m_node;
+
+		unsigned int m_count;
+		unsigned int m_node_count;
+		unsigned int m_bounded;			/* geometry in the tree, the rest of m_index is unbounded */
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "bvh.inl"
+
+#endif /* NMATH_BVH_H_INCLUDED */
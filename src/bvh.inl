@@ -0,0 +1,63 @@
+/*
+
+    This file is part of libnmath.
+
+    bvh.inl
+    Bounding volume hierarchy
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_BVH_INL_INCLUDED
+#define NMATH_BVH_INL_INCLUDED
+
+#ifndef NMATH_BVH_H_INCLUDED
+    #error "bvh.h must be included before bvh.inl"
+#endif /* NMATH_BVH_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline unsigned int BVH::count() const
+{
+	return m_count;
+}
+
+inline unsigned int BVH::node_count() const
+{
+	return m_node_count;
+}
+
+inline const BVHNode *BVH::nodes() const
+{
+	return m_node;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_BVH_INL_INCLUDED */
@@ -0,0 +1,298 @@
+/*
+
+    This file is part of libnmath.
+
+    constexpr.h
+    Compile time vector and matrix arithmetic
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_CONSTEXPR_H_INCLUDED
+#define NMATH_CONSTEXPR_H_INCLUDED
+
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "matrix.h"
+
+#if defined(__cplusplus) && (__cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L))
+
+/*
+	Compile time counterparts of the vector and matrix types.
+
+	This header is opt-in, needs C++17 and is not included by any other
+	header of the library, which itself stays C++98. Everything in it is
+	constexpr, so tables of transformed points or composed matrices can
+	be computed by the compiler and still be handed to the rest of the
+	library, e.g.
+
+		constexpr Constexpr::Matrix4x4 mvp = Constexpr::mul(proj, view);
+		Matrix4x4f m = mvp;
+
+	The types convert to the C types in constant expressions and to the
+	C++ classes at run time.
+*/
+
+namespace NMath {
+	namespace Constexpr {
+
+/* C types */
+constexpr vec2_t vec2_pack(scalar_t x, scalar_t y) { return vec2_t{x, y}; }
+constexpr vec3_t vec3_pack(scalar_t x, scalar_t y, scalar_t z) { return vec3_t{x, y, z}; }
+constexpr vec4_t vec4_pack(scalar_t x, scalar_t y, scalar_t z, scalar_t w) { return vec4_t{x, y, z, w}; }
+
+/* Vectors */
+struct Vector2
+{
+	scalar_t x, y;
+
+	constexpr Vector2() : x(0), y(0) {}
+	constexpr Vector2(scalar_t ax, scalar_t ay) : x(ax), y(ay) {}
+	constexpr Vector2(const vec2_t &v) : x(v.x), y(v.y) {}
+
+	constexpr operator vec2_t() const { return vec2_t{x, y}; }
+	operator Vector2f() const { return Vector2f(x, y); }
+
+	constexpr scalar_t operator[](unsigned int i) const { return i == 0 ? x : y; }
+};
+
+struct Vector3
+{
+	scalar_t x, y, z;
+
+	constexpr Vector3() : x(0), y(0), z(0) {}
+	constexpr Vector3(scalar_t ax, scalar_t ay, scalar_t az) : x(ax), y(ay), z(az) {}
+	constexpr Vector3(const vec3_t &v) : x(v.x), y(v.y), z(v.z) {}
+
+	constexpr operator vec3_t() const { return vec3_t{x, y, z}; }
+	operator Vector3f() const { return Vector3f(x, y, z); }
+
+	constexpr scalar_t operator[](unsigned int i) const { return i == 0 ? x : i == 1 ? y : z; }
+};
+
+struct Vector4
+{
+	scalar_t x, y, z, w;
+
+	constexpr Vector4() : x(0), y(0), z(0), w(0) {}
+	constexpr Vector4(scalar_t ax, scalar_t ay, scalar_t az, scalar_t aw) : x(ax), y(ay), z(az), w(aw) {}
+	constexpr Vector4(const Vector3 &v, scalar_t aw) : x(v.x), y(v.y), z(v.z), w(aw) {}
+	constexpr Vector4(const vec4_t &v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+	constexpr operator vec4_t() const { return vec4_t{x, y, z, w}; }
+	operator Vector4f() const { return Vector4f(x, y, z, w); }
+
+	constexpr scalar_t operator[](unsigned int i) const { return i == 0 ? x : i == 1 ? y : i == 2 ? z : w; }
+};
+
+constexpr Vector2 operator -(const Vector2 &v) { return Vector2(-v.x, -v.y); }
+constexpr Vector2 operator +(const Vector2 &a, const Vector2 &b) { return Vector2(a.x + b.x, a.y + b.y); }
+constexpr Vector2 operator -(const Vector2 &a, const Vector2 &b) { return Vector2(a.x - b.x, a.y - b.y); }
+constexpr Vector2 operator *(const Vector2 &a, const Vector2 &b) { return Vector2(a.x * b.x, a.y * b.y); }
+constexpr Vector2 operator /(const Vector2 &a, const Vector2 &b) { return Vector2(a.x / b.x, a.y / b.y); }
+constexpr Vector2 operator *(const Vector2 &v, scalar_t r) { return Vector2(v.x * r, v.y * r); }
+constexpr Vector2 operator *(scalar_t r, const Vector2 &v) { return Vector2(v.x * r, v.y * r); }
+constexpr Vector2 operator /(const Vector2 &v, scalar_t r) { return Vector2(v.x / r, v.y / r); }
+constexpr bool operator ==(const Vector2 &a, const Vector2 &b) { return a.x == b.x && a.y == b.y; }
+constexpr bool operator !=(const Vector2 &a, const Vector2 &b) { return !(a == b); }
+
+constexpr Vector3 operator -(const Vector3 &v) { return Vector3(-v.x, -v.y, -v.z); }
+constexpr Vector3 operator +(const Vector3 &a, const Vector3 &b) { return Vector3(a.x + b.x, a.y + b.y, a.z + b.z); }
+constexpr Vector3 operator -(const Vector3 &a, const Vector3 &b) { return Vector3(a.x - b.x, a.y - b.y, a.z - b.z); }
+constexpr Vector3 operator *(const Vector3 &a, const Vector3 &b) { return Vector3(a.x * b.x, a.y * b.y, a.z * b.z); }
+constexpr Vector3 operator /(const Vector3 &a, const Vector3 &b) { return Vector3(a.x / b.x, a.y / b.y, a.z / b.z); }
+constexpr Vector3 operator *(const Vector3 &v, scalar_t r) { return Vector3(v.x * r, v.y * r, v.z * r); }
+constexpr Vector3 operator *(scalar_t r, const Vector3 &v) { return Vector3(v.x * r, v.y * r, v.z * r); }
+constexpr Vector3 operator /(const Vector3 &v, scalar_t r) { return Vector3(v.x / r, v.y / r, v.z / r); }
+constexpr bool operator ==(const Vector3 &a, const Vector3 &b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+constexpr bool operator !=(const Vector3 &a, const Vector3 &b) { return !(a == b); }
+
+constexpr Vector4 operator -(const Vector4 &v) { return Vector4(-v.x, -v.y, -v.z, -v.w); }
+constexpr Vector4 operator +(const Vector4 &a, const Vector4 &b) { return Vector4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); }
+constexpr Vector4 operator -(const Vector4 &a, const Vector4 &b) { return Vector4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w); }
+constexpr Vector4 operator *(const Vector4 &a, const Vector4 &b) { return Vector4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w); }
+constexpr Vector4 operator /(const Vector4 &a, const Vector4 &b) { return Vector4(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w); }
+constexpr Vector4 operator *(const Vector4 &v, scalar_t r) { return Vector4(v.x * r, v.y * r, v.z * r, v.w * r); }
+constexpr Vector4 operator *(scalar_t r, const Vector4 &v) { return Vector4(v.x * r, v.y * r, v.z * r, v.w * r); }
+constexpr Vector4 operator /(const Vector4 &v, scalar_t r) { return Vector4(v.x / r, v.y / r, v.z / r, v.w / r); }
+constexpr bool operator ==(const Vector4 &a, const Vector4 &b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+constexpr bool operator !=(const Vector4 &a, const Vector4 &b) { return !(a == b); }
+
+constexpr scalar_t dot(const Vector2 &a, const Vector2 &b) { return a.x * b.x + a.y * b.y; }
+constexpr scalar_t dot(const Vector3 &a, const Vector3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+constexpr scalar_t dot(const Vector4 &a, const Vector4 &b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+constexpr Vector3 cross(const Vector3 &a, const Vector3 &b)
+{
+	return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+/* Matrices, row major like Matrix3x3f and Matrix4x4f, identity by default */
+struct Matrix3x3
+{
+	scalar_t data[3][3];
+
+	constexpr Matrix3x3() : data{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}} {}
+
+	constexpr Matrix3x3(scalar_t m11, scalar_t m12, scalar_t m13,
+						scalar_t m21, scalar_t m22, scalar_t m23,
+						scalar_t m31, scalar_t m32, scalar_t m33)
+		: data{{m11, m12, m13}, {m21, m22, m23}, {m31, m32, m33}} {}
+
+	constexpr Matrix3x3(const mat3x3_t m) : data{}
+	{
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				data[i][j] = m[i][j];
+	}
+
+	operator Matrix3x3f() const { return Matrix3x3f(data); }
+
+	constexpr scalar_t *operator[](int i) { return data[i]; }
+	constexpr const scalar_t *operator[](int i) const { return data[i]; }
+};
+
+struct Matrix4x4
+{
+	scalar_t data[4][4];
+
+	constexpr Matrix4x4() : data{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}} {}
+
+	constexpr Matrix4x4(scalar_t m11, scalar_t m12, scalar_t m13, scalar_t m14,
+						scalar_t m21, scalar_t m22, scalar_t m23, scalar_t m24,
+						scalar_t m31, scalar_t m32, scalar_t m33, scalar_t m34,
+						scalar_t m41, scalar_t m42, scalar_t m43, scalar_t m44)
+		: data{{m11, m12, m13, m14}, {m21, m22, m23, m24}, {m31, m32, m33, m34}, {m41, m42, m43, m44}} {}
+
+	constexpr Matrix4x4(const mat4x4_t m) : data{}
+	{
+		for (int i = 0; i < 4; ++i)
+			for (int j = 0; j < 4; ++j)
+				data[i][j] = m[i][j];
+	}
+
+	operator Matrix4x4f() const { return Matrix4x4f(data); }
+
+	constexpr scalar_t *operator[](int i) { return data[i]; }
+	constexpr const scalar_t *operator[](int i) const { return data[i]; }
+};
+
+constexpr Matrix4x4 mat4x4_pack(scalar_t m11, scalar_t m12, scalar_t m13, scalar_t m14,
+								scalar_t m21, scalar_t m22, scalar_t m23, scalar_t m24,
+								scalar_t m31, scalar_t m32, scalar_t m33, scalar_t m34,
+								scalar_t m41, scalar_t m42, scalar_t m43, scalar_t m44)
+{
+	return Matrix4x4(m11, m12, m13, m14, m21, m22, m23, m24, m31, m32, m33, m34, m41, m42, m43, m44);
+}
+
+template <class M, int N>
+constexpr bool matrix_equal(const M &a, const M &b)
+{
+	for (int i = 0; i < N; ++i)
+		for (int j = 0; j < N; ++j)
+			if (a[i][j] != b[i][j])
+				return false;
+	return true;
+}
+
+constexpr bool operator ==(const Matrix3x3 &a, const Matrix3x3 &b) { return matrix_equal<Matrix3x3, 3>(a, b); }
+constexpr bool operator !=(const Matrix3x3 &a, const Matrix3x3 &b) { return !(a == b); }
+constexpr bool operator ==(const Matrix4x4 &a, const Matrix4x4 &b) { return matrix_equal<Matrix4x4, 4>(a, b); }
+constexpr bool operator !=(const Matrix4x4 &a, const Matrix4x4 &b) { return !(a == b); }
+
+constexpr Matrix3x3 transpose(const Matrix3x3 &m)
+{
+	Matrix3x3 res;
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			res[i][j] = m[j][i];
+	return res;
+}
+
+constexpr Matrix4x4 transpose(const Matrix4x4 &m)
+{
+	Matrix4x4 res;
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 4; ++j)
+			res[i][j] = m[j][i];
+	return res;
+}
+
+constexpr Matrix3x3 mul(const Matrix3x3 &a, const Matrix3x3 &b)
+{
+	Matrix3x3 res;
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			res[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+	return res;
+}
+
+constexpr Matrix4x4 mul(const Matrix4x4 &a, const Matrix4x4 &b)
+{
+	Matrix4x4 res;
+	for (int i = 0; i < 4; ++i)
+		for (int j = 0; j < 4; ++j)
+			res[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+	return res;
+}
+
+/* Column vectors, as operator *(const Matrix4x4f&, const Vector4f&) */
+constexpr Vector3 mul(const Matrix3x3 &m, const Vector3 &v)
+{
+	return Vector3(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+				   m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+				   m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+}
+
+constexpr Vector4 mul(const Matrix4x4 &m, const Vector4 &v)
+{
+	return Vector4(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w,
+				   m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w,
+				   m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w,
+				   m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] * v.w);
+}
+
+constexpr Matrix3x3 operator *(const Matrix3x3 &a, const Matrix3x3 &b) { return mul(a, b); }
+constexpr Matrix4x4 operator *(const Matrix4x4 &a, const Matrix4x4 &b) { return mul(a, b); }
+constexpr Vector3 operator *(const Matrix3x3 &m, const Vector3 &v) { return mul(m, v); }
+constexpr Vector4 operator *(const Matrix4x4 &m, const Vector4 &v) { return mul(m, v); }
+
+/*
+	These fail to compile if any of the above stops being usable in a
+	constant expression.
+*/
+static_assert(vec3_pack(1, 2, 3).z == 3, "vec3_pack");
+static_assert(Vector3(vec3_pack(1, 2, 3)) * 2 - Vector3(1, 1, 1) == Vector3(1, 3, 5), "vector operators");
+static_assert(dot(Vector3(1, 2, 3), Vector3(4, 5, 6)) == 32, "dot");
+static_assert(cross(Vector3(1, 0, 0), Vector3(0, 1, 0)) == Vector3(0, 0, 1), "cross");
+static_assert(transpose(mat4x4_pack(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16))[3][0] == 4, "transpose");
+static_assert(mul(Matrix4x4(), mat4x4_pack(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16))
+			  == mat4x4_pack(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16), "mul");
+static_assert(mat4x4_pack(1, 0, 0, 5, 0, 1, 0, 6, 0, 0, 1, 7, 0, 0, 0, 1) * Vector4(Vector3(1, 2, 3), 1)
+			  == Vector4(6, 8, 10, 1), "transform");
+static_assert(mul(Matrix3x3(0, -1, 0, 1, 0, 0, 0, 0, 1), Vector3(1, 0, 0)) == Vector3(0, 1, 0), "rotation");
+
+	} /* namespace Constexpr */
+} /* namespace NMath */
+
+#endif	/* C++17 */
+
+#endif /* NMATH_CONSTEXPR_H_INCLUDED */
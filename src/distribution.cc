@@ -0,0 +1,208 @@
+/*
+
+    This file is part of libnmath.
+
+    distribution.cc
+    Discrete and piecewise constant distributions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include <stdlib.h>
+
+#include "distribution.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+int dist1d_init(dist1d_t *d, const scalar_t *weights, unsigned int count)
+{
+	d->count = count;
+	d->total = 0;
+
+	/* One block for the three tables, the scalar arrays first for alignment */
+	void *mem = malloc(count * (2 * sizeof(scalar_t) + sizeof(unsigned int)));
+	unsigned int *work = (unsigned int *)malloc(count * sizeof(unsigned int));
+
+	if (!count || !mem || !work) {
+		free(mem);
+		free(work);
+		d->count = 0;
+		d->prob = d->pmf = 0;
+		d->alias = 0;
+		return -1;
+	}
+
+	d->prob = (scalar_t *)mem;
+	d->pmf = d->prob + count;
+	d->alias = (unsigned int *)(d->pmf + count);
+
+	double total = 0;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		total += weights[i] > 0 ? weights[i] : 0;
+	}
+
+	d->total = (scalar_t)total;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		d->pmf[i] = total > 0 ? (scalar_t)((weights[i] > 0 ? weights[i] : 0) / total) : (scalar_t)1 / (scalar_t)count;
+	}
+
+	/*
+		Vose's algorithm. Buckets are scaled so that the average is 1, the
+		ones below are topped up from the ones above, which then move to
+		the small list once they drop below 1 themselves. The small list
+		grows from the front of the work array and the large from the back.
+	*/
+	unsigned int small = 0, large = count;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		d->prob[i] = d->pmf[i] * (scalar_t)count;
+
+		if (d->prob[i] < 1) {
+			work[small++] = i;
+		}
+		else {
+			work[--large] = i;
+		}
+	}
+
+	while (small && large < count) {
+		unsigned int s = work[--small];
+		unsigned int l = work[large++];
+
+		d->alias[s] = l;
+		d->prob[l] = (d->prob[l] + d->prob[s]) - 1;
+
+		if (d->prob[l] < 1) {
+			work[small++] = l;
+		}
+		else {
+			work[--large] = l;
+		}
+	}
+
+	/* What is left is 1 up to rounding */
+	while (large < count) {
+		unsigned int l = work[large++];
+		d->prob[l] = 1;
+		d->alias[l] = l;
+	}
+
+	while (small) {
+		unsigned int s = work[--small];
+		d->prob[s] = 1;
+		d->alias[s] = s;
+	}
+
+	free(work);
+	return 0;
+}
+
+void dist1d_release(dist1d_t *d)
+{
+	free(d->prob);
+
+	d->count = 0;
+	d->prob = d->pmf = 0;
+	d->alias = 0;
+}
+
+int dist2d_init(dist2d_t *d, const scalar_t *weights, unsigned int width, unsigned int height)
+{
+	d->width = width;
+	d->height = height;
+	d->marginal.count = 0;
+	d->marginal.prob = d->marginal.pmf = 0;
+	d->marginal.alias = 0;
+	d->conditional = (dist1d_t *)calloc(height, sizeof(dist1d_t));
+
+	scalar_t *sums = (scalar_t *)malloc(height * sizeof(scalar_t));
+
+	int res = (d->conditional && sums) ? 0 : -1;
+
+	for (unsigned int y = 0; y < height && !res; ++y) {
+		res = dist1d_init(&d->conditional[y], weights + (size_t)y * width, width);
+		sums[y] = d->conditional[y].total;
+	}
+
+	if (!res) {
+		res = dist1d_init(&d->marginal, sums, height);
+	}
+
+	free(sums);
+
+	if (res) {
+		dist2d_release(d);
+		return -1;
+	}
+
+	return 0;
+}
+
+void dist2d_release(dist2d_t *d)
+{
+	if (d->conditional) {
+		for (unsigned int y = 0; y < d->height; ++y) {
+			dist1d_release(&d->conditional[y]);
+		}
+
+		free(d->conditional);
+	}
+
+	dist1d_release(&d->marginal);
+
+	d->width = d->height = 0;
+	d->conditional = 0;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+	namespace Sample {
+
+Distribution1D::Distribution1D(const scalar_t *weights, unsigned int count)
+{
+	m_valid = !dist1d_init(&m_dist, weights, count);
+}
+
+Distribution1D::~Distribution1D()
+{
+	dist1d_release(&m_dist);
+}
+
+Distribution2D::Distribution2D(const scalar_t *weights, unsigned int width, unsigned int height)
+{
+	m_valid = !dist2d_init(&m_dist, weights, width, height);
+}
+
+Distribution2D::~Distribution2D()
+{
+	dist2d_release(&m_dist);
+}
+
+	} /* namespace Sample */
+
+} /* namespace NMath */
@@ -0,0 +1,159 @@
+/*
+
+    This file is part of libnmath.
+
+    distribution.h
+    Discrete and piecewise constant distributions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_DISTRIBUTION_H_INCLUDED
+#define NMATH_DISTRIBUTION_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "prng.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	Discrete distribution over count outcomes, proportional to a set of
+	non negative weights, sampled in constant time with Walker's alias
+	method. The table is built in linear time with Vose's algorithm.
+
+	Every bucket i is picked uniformly and then kept with probability
+	prob[i], or replaced by alias[i]. The single number variant uses the
+	integer part of u * count for the bucket and the fraction for the coin,
+	and returns what is left of the fraction, uniform again, in remapped.
+	With single precision the fraction of large tables is coarse, the
+	generator variant draws the bucket and the coin separately.
+
+	If all weights are zero the distribution is uniform.
+*/
+struct dist1d_t
+{
+	unsigned int count;
+	scalar_t total;			/* sum of the weights */
+	scalar_t *prob;			/* probability of keeping bucket i */
+	scalar_t *pmf;			/* normalized weights */
+	unsigned int *alias;
+};
+
+typedef struct dist1d_t dist1d_t;
+
+/* Return 0 on success, -1 if the table could not be allocated */
+NMATH_DECLSPEC int dist1d_init(dist1d_t *d, const scalar_t *weights, unsigned int count);
+NMATH_DECLSPEC void dist1d_release(dist1d_t *d);
+
+static inline unsigned int dist1d_sample(const dist1d_t *d, scalar_t u, scalar_t *pmf, scalar_t *remapped);
+static inline unsigned int dist1d_sample_prng(const dist1d_t *d, prng_philox_t *s, scalar_t *pmf);
+
+/*
+	Piecewise constant distribution over [0, 1)^2, proportional to a
+	width x height grid of weights stored row major, e.g. the luminance of
+	an environment map. A row is picked from the marginal distribution of
+	the row sums, then a column from the conditional distribution of that
+	row. The samples are continuous points and the pdf is with respect to
+	area in [0, 1)^2.
+*/
+struct dist2d_t
+{
+	unsigned int width, height;
+	dist1d_t marginal;
+	dist1d_t *conditional;	/* one per row */
+};
+
+typedef struct dist2d_t dist2d_t;
+
+NMATH_DECLSPEC int dist2d_init(dist2d_t *d, const scalar_t *weights, unsigned int width, unsigned int height);
+NMATH_DECLSPEC void dist2d_release(dist2d_t *d);
+
+static inline vec2_t dist2d_sample(const dist2d_t *d, scalar_t u, scalar_t v, scalar_t *pdf);
+static inline vec2_t dist2d_sample_prng(const dist2d_t *d, prng_philox_t *s, scalar_t *pdf);
+static inline scalar_t dist2d_pdf(const dist2d_t *d, scalar_t x, scalar_t y);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+	namespace Sample {
+
+/*
+	The distributions own their tables, so they are not copyable. An empty
+	weight array or a failed allocation leaves them invalid, and an invalid
+	distribution must not be sampled.
+*/
+class NMATH_DECLSPEC Distribution1D
+{
+	public:
+		Distribution1D(const scalar_t *weights, unsigned int count);
+		~Distribution1D();
+
+		inline bool valid() const;
+		inline unsigned int count() const;
+		inline scalar_t pmf(unsigned int i) const;
+
+		inline unsigned int sample(scalar_t u, scalar_t *pmf = 0, scalar_t *remapped = 0) const;
+		inline unsigned int sample(prng_philox_t *s, scalar_t *pmf = 0) const;
+
+	private:
+		Distribution1D(const Distribution1D &);
+		Distribution1D &operator =(const Distribution1D &);
+
+		dist1d_t m_dist;
+		bool m_valid;
+};
+
+class NMATH_DECLSPEC Distribution2D
+{
+	public:
+		Distribution2D(const scalar_t *weights, unsigned int width, unsigned int height);
+		~Distribution2D();
+
+		inline bool valid() const;
+		inline scalar_t pdf(const Vector2f &p) const;
+
+		inline Vector2f sample(scalar_t u, scalar_t v, scalar_t *pdf = 0) const;
+		inline Vector2f sample(prng_philox_t *s, scalar_t *pdf = 0) const;
+
+	private:
+		Distribution2D(const Distribution2D &);
+		Distribution2D &operator =(const Distribution2D &);
+
+		dist2d_t m_dist;
+		bool m_valid;
+};
+
+	} /* namespace Sample */
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "distribution.inl"
+
+#endif /* NMATH_DISTRIBUTION_H_INCLUDED */
@@ -0,0 +1,190 @@
+/*
+
+    This file is part of libnmath.
+
+    distribution.inl
+    Discrete and piecewise constant distributions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_DISTRIBUTION_INL_INCLUDED
+#define NMATH_DISTRIBUTION_INL_INCLUDED
+
+#ifndef NMATH_DISTRIBUTION_H_INCLUDED
+    #error "distribution.h must be included before distribution.inl"
+#endif /* NMATH_DISTRIBUTION_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline unsigned int dist1d_sample(const dist1d_t *d, scalar_t u, scalar_t *pmf, scalar_t *remapped)
+{
+	scalar_t x = u * (scalar_t)d->count;
+	unsigned int i = (unsigned int)x;
+
+	if (i >= d->count) {
+		i = d->count - 1;
+	}
+
+	scalar_t f = x - (scalar_t)i;
+	scalar_t p = d->prob[i];
+	scalar_t r;
+
+	if (f < p) {
+		r = f / p;
+	}
+	else {
+		r = (f - p) / (1 - p);
+		i = d->alias[i];
+	}
+
+	if (pmf) {
+		*pmf = d->pmf[i];
+	}
+
+	if (remapped) {
+		*remapped = r < SCALAR_ONE_MINUS_EPSILON ? r : SCALAR_ONE_MINUS_EPSILON;
+	}
+
+	return i;
+}
+
+static inline unsigned int dist1d_sample_prng(const dist1d_t *d, prng_philox_t *s, scalar_t *pmf)
+{
+	/* Multiply and shift instead of a modulo, unbiased enough for any practical count */
+	unsigned int i = (unsigned int)(((uint64_t)prng_philox_u32(s) * d->count) >> 32);
+
+	if (prng_philox(s, 0, 1) >= d->prob[i]) {
+		i = d->alias[i];
+	}
+
+	if (pmf) {
+		*pmf = d->pmf[i];
+	}
+
+	return i;
+}
+
+static inline vec2_t dist2d_sample(const dist2d_t *d, scalar_t u, scalar_t v, scalar_t *pdf)
+{
+	scalar_t ry, rx, py, px;
+
+	unsigned int y = dist1d_sample(&d->marginal, v, &py, &ry);
+	unsigned int x = dist1d_sample(&d->conditional[y], u, &px, &rx);
+
+	if (pdf) {
+		*pdf = py * px * (scalar_t)d->width * (scalar_t)d->height;
+	}
+
+	vec2_t res;
+	res.x = ((scalar_t)x + rx) / (scalar_t)d->width;
+	res.y = ((scalar_t)y + ry) / (scalar_t)d->height;
+	return res;
+}
+
+static inline vec2_t dist2d_sample_prng(const dist2d_t *d, prng_philox_t *s, scalar_t *pdf)
+{
+	scalar_t py, px;
+
+	unsigned int y = dist1d_sample_prng(&d->marginal, s, &py);
+	unsigned int x = dist1d_sample_prng(&d->conditional[y], s, &px);
+
+	if (pdf) {
+		*pdf = py * px * (scalar_t)d->width * (scalar_t)d->height;
+	}
+
+	vec2_t res;
+	res.x = ((scalar_t)x + prng_philox(s, 0, 1)) / (scalar_t)d->width;
+	res.y = ((scalar_t)y + prng_philox(s, 0, 1)) / (scalar_t)d->height;
+	return res;
+}
+
+static inline scalar_t dist2d_pdf(const dist2d_t *d, scalar_t x, scalar_t y)
+{
+	unsigned int ix = (unsigned int)(x * (scalar_t)d->width);
+	unsigned int iy = (unsigned int)(y * (scalar_t)d->height);
+
+	ix = ix < d->width ? ix : d->width - 1;
+	iy = iy < d->height ? iy : d->height - 1;
+
+	return d->marginal.pmf[iy] * d->conditional[iy].pmf[ix] * (scalar_t)d->width * (scalar_t)d->height;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+	namespace Sample {
+
+inline bool Distribution1D::valid() const
+{
+	return m_valid;
+}
+
+inline unsigned int Distribution1D::count() const
+{
+	return m_dist.count;
+}
+
+inline scalar_t Distribution1D::pmf(unsigned int i) const
+{
+	return m_dist.pmf[i];
+}
+
+inline unsigned int Distribution1D::sample(scalar_t u, scalar_t *pmf, scalar_t *remapped) const
+{
+	return dist1d_sample(&m_dist, u, pmf, remapped);
+}
+
+inline unsigned int Distribution1D::sample(prng_philox_t *s, scalar_t *pmf) const
+{
+	return dist1d_sample_prng(&m_dist, s, pmf);
+}
+
+inline bool Distribution2D::valid() const
+{
+	return m_valid;
+}
+
+inline scalar_t Distribution2D::pdf(const Vector2f &p) const
+{
+	return dist2d_pdf(&m_dist, p.x, p.y);
+}
+
+inline Vector2f Distribution2D::sample(scalar_t u, scalar_t v, scalar_t *pdf) const
+{
+	return Vector2f(dist2d_sample(&m_dist, u, v, pdf));
+}
+
+inline Vector2f Distribution2D::sample(prng_philox_t *s, scalar_t *pdf) const
+{
+	return Vector2f(dist2d_sample_prng(&m_dist, s, pdf));
+}
+
+	} /* namespace Sample */
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_DISTRIBUTION_INL_INCLUDED */
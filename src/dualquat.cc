@@ -0,0 +1,373 @@
+/*
+
+    This file is part of libnmath.
+
+    dualquat.cc
+    Dual quaternion
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "dualquat.h"
+#include "simd.h"
+
+#ifdef __cplusplus
+    #include <cmath>
+	#include <cstddef>
+#else
+    #include <math.h>
+	#include <stddef.h>
+#endif  /* __cplusplus */
+
+namespace NMath {
+
+/*
+	Skinning kernel
+	Shared by the C and C++ interfaces, which only differ in the bone type.
+	Both dquat_t and DualQuaternion store the real and dual parts as eight
+	consecutive scalars, x, y, z, w each.
+
+	Per vertex the bone dual quaternions are blended linearly, keeping
+	them in the hemisphere of the first influence, and normalized once.
+	The blended rigid transformation is then applied directly, without
+	building a matrix. The hemisphere test is a sign flip of the weight
+	rather than a branch, as it is unpredictable.
+*/
+template <typename T>
+static inline void dquat_skin_vertex(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+									 const vec3_soa_t *pos, const vec3_soa_t *nrm,
+									 const unsigned int *bone, const scalar_t *weight,
+									 const T *bones, int i)
+{
+	const unsigned int *b = bone + i * NMATH_SKIN_INFLUENCES;
+	const scalar_t *w = weight + i * NMATH_SKIN_INFLUENCES;
+
+	const T &b0 = bones[b[0]];
+
+	scalar_t rx = b0.real.x * w[0], ry = b0.real.y * w[0], rz = b0.real.z * w[0], rw = b0.real.w * w[0];
+	scalar_t dx = b0.dual.x * w[0], dy = b0.dual.y * w[0], dz = b0.dual.z * w[0], dw = b0.dual.w * w[0];
+
+	for (int k=1; k<NMATH_SKIN_INFLUENCES; ++k) {
+		const T &bk = bones[b[k]];
+
+		scalar_t cos_a = b0.real.x * bk.real.x + b0.real.y * bk.real.y + b0.real.z * bk.real.z + b0.real.w * bk.real.w;
+		scalar_t wk = (cos_a < 0) ? -w[k] : w[k];
+
+		rx += bk.real.x * wk; ry += bk.real.y * wk; rz += bk.real.z * wk; rw += bk.real.w * wk;
+		dx += bk.dual.x * wk; dy += bk.dual.y * wk; dz += bk.dual.z * wk; dw += bk.dual.w * wk;
+	}
+
+	/* Normalize */
+	scalar_t rlen = 1.0 / nmath_sqrt(rx * rx + ry * ry + rz * rz + rw * rw);
+
+	rx *= rlen; ry *= rlen; rz *= rlen; rw *= rlen;
+	dx *= rlen; dy *= rlen; dz *= rlen; dw *= rlen;
+
+	/* Translation, see dquat_get_translation */
+	scalar_t tx = 2 * (rw * dx - dw * rx + ry * dz - rz * dy);
+	scalar_t ty = 2 * (rw * dy - dw * ry + rz * dx - rx * dz);
+	scalar_t tz = 2 * (rw * dz - dw * rz + rx * dy - ry * dx);
+
+	/* Rotation, see quat_rotate */
+	scalar_t px = pos->x[i], py = pos->y[i], pz = pos->z[i];
+
+	scalar_t ux = 2 * (ry * pz - rz * py);
+	scalar_t uy = 2 * (rz * px - rx * pz);
+	scalar_t uz = 2 * (rx * py - ry * px);
+
+	res_pos->x[i] = px + rw * ux + (ry * uz - rz * uy) + tx;
+	res_pos->y[i] = py + rw * uy + (rz * ux - rx * uz) + ty;
+	res_pos->z[i] = pz + rw * uz + (rx * uy - ry * ux) + tz;
+
+	if (res_nrm) {
+		scalar_t nx = nrm->x[i], ny = nrm->y[i], nz = nrm->z[i];
+
+		ux = 2 * (ry * nz - rz * ny);
+		uy = 2 * (rz * nx - rx * nz);
+		uz = 2 * (rx * ny - ry * nx);
+
+		res_nrm->x[i] = nx + rw * ux + (ry * uz - rz * uy);
+		res_nrm->y[i] = ny + rw * uy + (rz * ux - rx * uz);
+		res_nrm->z[i] = nz + rw * uz + (rx * uy - ry * ux);
+	}
+}
+
+/*
+	SIMD lanes
+	The same computation with one vertex per lane. The bone and weight
+	quadruples of the lanes are loaded whole and transposed, so that every
+	register holds one component for all the lanes.
+*/
+#if defined(NMATH_SIMD_SSE) && defined(MATH_SINGLE_PRECISION)
+	#define NMATH_SKIN_LANES 4
+
+	typedef __m128 lane_t;
+
+	static inline lane_t lane_set1(scalar_t s)            { return _mm_set1_ps(s); }
+	static inline lane_t lane_load(const scalar_t *p)     { return _mm_loadu_ps(p); }
+	static inline void lane_store(scalar_t *p, lane_t a)  { _mm_storeu_ps(p, a); }
+	static inline lane_t lane_add(lane_t a, lane_t b)     { return _mm_add_ps(a, b); }
+	static inline lane_t lane_sub(lane_t a, lane_t b)     { return _mm_sub_ps(a, b); }
+	static inline lane_t lane_mul(lane_t a, lane_t b)     { return _mm_mul_ps(a, b); }
+	static inline lane_t lane_rsqrt(lane_t a)             { return _mm_div_ps(_mm_set1_ps(1), _mm_sqrt_ps(a)); }
+
+	/* Flip the sign of a where s is negative */
+	static inline lane_t lane_signflip(lane_t a, lane_t s)
+	{
+		return _mm_xor_ps(a, _mm_and_ps(s, _mm_set1_ps(-0.0f)));
+	}
+
+	static inline void lane_load_transposed(lane_t q[4], const scalar_t *const p[NMATH_SKIN_LANES])
+	{
+		q[0] = _mm_loadu_ps(p[0]);
+		q[1] = _mm_loadu_ps(p[1]);
+		q[2] = _mm_loadu_ps(p[2]);
+		q[3] = _mm_loadu_ps(p[3]);
+		_MM_TRANSPOSE4_PS(q[0], q[1], q[2], q[3]);
+	}
+#elif defined(NMATH_SIMD_SSE2) && !defined(MATH_SINGLE_PRECISION)
+	#define NMATH_SKIN_LANES 2
+
+	typedef __m128d lane_t;
+
+	static inline lane_t lane_set1(scalar_t s)            { return _mm_set1_pd(s); }
+	static inline lane_t lane_load(const scalar_t *p)     { return _mm_loadu_pd(p); }
+	static inline void lane_store(scalar_t *p, lane_t a)  { _mm_storeu_pd(p, a); }
+	static inline lane_t lane_add(lane_t a, lane_t b)     { return _mm_add_pd(a, b); }
+	static inline lane_t lane_sub(lane_t a, lane_t b)     { return _mm_sub_pd(a, b); }
+	static inline lane_t lane_mul(lane_t a, lane_t b)     { return _mm_mul_pd(a, b); }
+	static inline lane_t lane_rsqrt(lane_t a)             { return _mm_div_pd(_mm_set1_pd(1), _mm_sqrt_pd(a)); }
+
+	/* Flip the sign of a where s is negative */
+	static inline lane_t lane_signflip(lane_t a, lane_t s)
+	{
+		return _mm_xor_pd(a, _mm_and_pd(s, _mm_set1_pd(-0.0)));
+	}
+
+	static inline void lane_load_transposed(lane_t q[4], const scalar_t *const p[NMATH_SKIN_LANES])
+	{
+		__m128d lo0 = _mm_loadu_pd(p[0]), hi0 = _mm_loadu_pd(p[0] + 2);
+		__m128d lo1 = _mm_loadu_pd(p[1]), hi1 = _mm_loadu_pd(p[1] + 2);
+
+		q[0] = _mm_unpacklo_pd(lo0, lo1);
+		q[1] = _mm_unpackhi_pd(lo0, lo1);
+		q[2] = _mm_unpacklo_pd(hi0, hi1);
+		q[3] = _mm_unpackhi_pd(hi0, hi1);
+	}
+#endif /* NMATH_SIMD_SSE */
+
+#ifdef NMATH_SKIN_LANES
+template <typename T>
+static inline void dquat_skin_lanes(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+									const vec3_soa_t *pos, const vec3_soa_t *nrm,
+									const unsigned int *bone, const scalar_t *weight,
+									const T *bones, int i)
+{
+	const scalar_t *p[NMATH_SKIN_LANES];
+	lane_t w[4], r[4], d[4], qr[4], qd[4];
+
+	for (int j=0; j<NMATH_SKIN_LANES; ++j) {
+		p[j] = weight + (i + j) * NMATH_SKIN_INFLUENCES;
+	}
+
+	lane_load_transposed(w, p);
+
+	/* First influence */
+	for (int j=0; j<NMATH_SKIN_LANES; ++j) {
+		p[j] = &bones[bone[(i + j) * NMATH_SKIN_INFLUENCES]].real.x;
+	}
+
+	lane_load_transposed(r, p);
+
+	for (int j=0; j<NMATH_SKIN_LANES; ++j) {
+		p[j] = &bones[bone[(i + j) * NMATH_SKIN_INFLUENCES]].dual.x;
+	}
+
+	lane_load_transposed(d, p);
+
+	lane_t r0[4] = { r[0], r[1], r[2], r[3] };
+
+	for (int c=0; c<4; ++c) {
+		r[c] = lane_mul(r[c], w[0]);
+		d[c] = lane_mul(d[c], w[0]);
+	}
+
+	/* Rest of the influences */
+	for (int k=1; k<NMATH_SKIN_INFLUENCES; ++k) {
+		for (int j=0; j<NMATH_SKIN_LANES; ++j) {
+			p[j] = &bones[bone[(i + j) * NMATH_SKIN_INFLUENCES + k]].real.x;
+		}
+
+		lane_load_transposed(qr, p);
+
+		for (int j=0; j<NMATH_SKIN_LANES; ++j) {
+			p[j] = &bones[bone[(i + j) * NMATH_SKIN_INFLUENCES + k]].dual.x;
+		}
+
+		lane_load_transposed(qd, p);
+
+		lane_t cos_a = lane_add(lane_add(lane_mul(r0[0], qr[0]), lane_mul(r0[1], qr[1])),
+								lane_add(lane_mul(r0[2], qr[2]), lane_mul(r0[3], qr[3])));
+		lane_t wk = lane_signflip(w[k], cos_a);
+
+		for (int c=0; c<4; ++c) {
+			r[c] = lane_add(r[c], lane_mul(qr[c], wk));
+			d[c] = lane_add(d[c], lane_mul(qd[c], wk));
+		}
+	}
+
+	/* Normalize */
+	lane_t rlen = lane_rsqrt(lane_add(lane_add(lane_mul(r[0], r[0]), lane_mul(r[1], r[1])),
+									  lane_add(lane_mul(r[2], r[2]), lane_mul(r[3], r[3]))));
+
+	for (int c=0; c<4; ++c) {
+		r[c] = lane_mul(r[c], rlen);
+		d[c] = lane_mul(d[c], rlen);
+	}
+
+	const lane_t two = lane_set1(2);
+
+	/* Translation */
+	lane_t tx = lane_mul(two, lane_add(lane_sub(lane_mul(r[3], d[0]), lane_mul(d[3], r[0])), lane_sub(lane_mul(r[1], d[2]), lane_mul(r[2], d[1]))));
+	lane_t ty = lane_mul(two, lane_add(lane_sub(lane_mul(r[3], d[1]), lane_mul(d[3], r[1])), lane_sub(lane_mul(r[2], d[0]), lane_mul(r[0], d[2]))));
+	lane_t tz = lane_mul(two, lane_add(lane_sub(lane_mul(r[3], d[2]), lane_mul(d[3], r[2])), lane_sub(lane_mul(r[0], d[1]), lane_mul(r[1], d[0]))));
+
+	/* Rotation */
+	lane_t px = lane_load(pos->x + i), py = lane_load(pos->y + i), pz = lane_load(pos->z + i);
+
+	lane_t ux = lane_mul(two, lane_sub(lane_mul(r[1], pz), lane_mul(r[2], py)));
+	lane_t uy = lane_mul(two, lane_sub(lane_mul(r[2], px), lane_mul(r[0], pz)));
+	lane_t uz = lane_mul(two, lane_sub(lane_mul(r[0], py), lane_mul(r[1], px)));
+
+	lane_store(res_pos->x + i, lane_add(lane_add(px, tx), lane_add(lane_mul(r[3], ux), lane_sub(lane_mul(r[1], uz), lane_mul(r[2], uy)))));
+	lane_store(res_pos->y + i, lane_add(lane_add(py, ty), lane_add(lane_mul(r[3], uy), lane_sub(lane_mul(r[2], ux), lane_mul(r[0], uz)))));
+	lane_store(res_pos->z + i, lane_add(lane_add(pz, tz), lane_add(lane_mul(r[3], uz), lane_sub(lane_mul(r[0], uy), lane_mul(r[1], ux)))));
+
+	if (res_nrm) {
+		lane_t nx = lane_load(nrm->x + i), ny = lane_load(nrm->y + i), nz = lane_load(nrm->z + i);
+
+		ux = lane_mul(two, lane_sub(lane_mul(r[1], nz), lane_mul(r[2], ny)));
+		uy = lane_mul(two, lane_sub(lane_mul(r[2], nx), lane_mul(r[0], nz)));
+		uz = lane_mul(two, lane_sub(lane_mul(r[0], ny), lane_mul(r[1], nx)));
+
+		lane_store(res_nrm->x + i, lane_add(nx, lane_add(lane_mul(r[3], ux), lane_sub(lane_mul(r[1], uz), lane_mul(r[2], uy)))));
+		lane_store(res_nrm->y + i, lane_add(ny, lane_add(lane_mul(r[3], uy), lane_sub(lane_mul(r[2], ux), lane_mul(r[0], uz)))));
+		lane_store(res_nrm->z + i, lane_add(nz, lane_add(lane_mul(r[3], uz), lane_sub(lane_mul(r[0], uy), lane_mul(r[1], ux)))));
+	}
+}
+#endif /* NMATH_SKIN_LANES */
+
+template <typename T>
+static void dquat_skin_kernel(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+							  const vec3_soa_t *pos, const vec3_soa_t *nrm,
+							  const unsigned int *bone, const scalar_t *weight,
+							  const T *bones, unsigned int count)
+{
+	const int n = (int)count;
+	int first = 0;
+
+	if (!nrm) {
+		res_nrm = NULL;
+	}
+
+#ifdef NMATH_SKIN_LANES
+	const int blocks = n / NMATH_SKIN_LANES;
+
+	#pragma omp parallel for schedule(static) if(n > 4096)
+	for (int i=0; i<blocks; ++i) {
+		dquat_skin_lanes(res_pos, res_nrm, pos, nrm, bone, weight, bones, i * NMATH_SKIN_LANES);
+	}
+
+	first = blocks * NMATH_SKIN_LANES;
+#endif /* NMATH_SKIN_LANES */
+
+	#pragma omp parallel for schedule(static) if(n - first > 4096)
+	for (int i=first; i<n; ++i) {
+		dquat_skin_vertex(res_pos, res_nrm, pos, nrm, bone, weight, bones, i);
+	}
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+void dquat_to_mat4x4(mat4x4_t m, dquat_t dq)
+{
+	vec3_t t = dquat_get_translation(dq);
+
+	quat_to_mat4x4(m, dq.real);
+	m[0][3] = t.x;
+	m[1][3] = t.y;
+	m[2][3] = t.z;
+}
+
+dquat_t dquat_from_mat4x4(const mat4x4_t m)
+{
+	vec3_t t = vec3_pack(m[0][3], m[1][3], m[2][3]);
+	return dquat_from_rot_trans(quat_from_mat4x4(m), t);
+}
+
+void dquat_skin(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+				const vec3_soa_t *pos, const vec3_soa_t *nrm,
+				const unsigned int *bone, const scalar_t *weight,
+				const dquat_t *bones, unsigned int count)
+{
+	dquat_skin_kernel(res_pos, res_nrm, pos, nrm, bone, weight, bones, count);
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+const DualQuaternion DualQuaternion::identity(Quaternion(0, 0, 0, 1), Quaternion(0, 0, 0, 0));
+
+DualQuaternion::DualQuaternion(const Matrix4x4f &m)
+{
+	Vector3f t(m[0][3], m[1][3], m[2][3]);
+	*this = DualQuaternion(Quaternion(m), t);
+}
+
+Matrix4x4f DualQuaternion::to_matrix4x4() const
+{
+	Matrix4x4f m = real.to_matrix4x4();
+	Vector3f t = translation();
+
+	m[0][3] = t.x;
+	m[1][3] = t.y;
+	m[2][3] = t.z;
+	return m;
+}
+
+void DualQuaternion::skin(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+						  const vec3_soa_t *pos, const vec3_soa_t *nrm,
+						  const unsigned int *bone, const scalar_t *weight,
+						  const DualQuaternion *bones, unsigned int count)
+{
+	dquat_skin_kernel(res_pos, res_nrm, pos, nrm, bone, weight, bones, count);
+}
+
+std::ostream& operator <<(std::ostream& out, const DualQuaternion &dq)
+{
+	out << "[ " << dq.real << ", " << dq.dual << " ]";
+	return out;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
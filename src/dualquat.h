@@ -0,0 +1,138 @@
+/*
+
+    This file is part of libnmath.
+
+    dualquat.h
+    Dual quaternion
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_DUALQUAT_H_INCLUDED
+#define NMATH_DUALQUAT_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "matrix.h"
+#include "quaternion.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	A unit dual quaternion q = r + e * d encodes the rigid transformation
+	that rotates by r and then translates by t, with d = 0.5 * t * r.
+*/
+static inline dquat_t dquat_pack(quat_t real, quat_t dual);
+static inline dquat_t dquat_identity(void);
+static inline dquat_t dquat_from_rot_trans(quat_t rot, vec3_t trans);     /* rot must be normalized */
+
+static inline dquat_t dquat_add(dquat_t dq1, dquat_t dq2);
+static inline dquat_t dquat_scale(dquat_t dq, scalar_t s);
+static inline dquat_t dquat_mul(dquat_t dq1, dquat_t dq2);               /* transformation dq2 followed by dq1 */
+static inline dquat_t dquat_normalize(dquat_t dq);
+static inline dquat_t dquat_conjugate(dquat_t dq);                       /* inverse of a unit dual quaternion */
+
+static inline vec3_t dquat_get_translation(dquat_t dq);
+static inline vec3_t dquat_transform_point(dquat_t dq, vec3_t p);        /* dq must be normalized */
+static inline vec3_t dquat_transform_vector(dquat_t dq, vec3_t v);       /* dq must be normalized */
+
+NMATH_DECLSPEC void dquat_to_mat4x4(mat4x4_t m, dquat_t dq);
+NMATH_DECLSPEC dquat_t dquat_from_mat4x4(const mat4x4_t m);             /* m must be a rigid transformation */
+
+/*
+	Dual quaternion skinning
+	Every vertex is influenced by NMATH_SKIN_INFLUENCES bones. bone and
+	weight hold NMATH_SKIN_INFLUENCES consecutive entries per vertex and
+	unused influences should have zero weight. The weights of a vertex
+	are expected to sum to 1. Normals are skipped when nrm or res_nrm is
+	NULL. The output arrays must not overlap the input arrays.
+	The vertex range is split across threads when built with OpenMP.
+*/
+#define NMATH_SKIN_INFLUENCES 4
+
+NMATH_DECLSPEC void dquat_skin(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+							   const vec3_soa_t *pos, const vec3_soa_t *nrm,
+							   const unsigned int *bone, const scalar_t *weight,
+							   const dquat_t *bones, unsigned int count);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+class NMATH_DECLSPEC DualQuaternion
+{
+	public:
+		/* Constructors */
+		inline DualQuaternion(const Quaternion &aReal = Quaternion(0, 0, 0, 1), const Quaternion &aDual = Quaternion(0, 0, 0, 0));
+		inline DualQuaternion(const Quaternion &rotation, const Vector3f &translation);	/* rotation must be normalized */
+		DualQuaternion(const Matrix4x4f &m);	/* m must be a rigid transformation */
+
+		/* Arithmetic operators */
+		friend inline const DualQuaternion operator +(const DualQuaternion &dq1, const DualQuaternion &dq2);
+		friend inline const DualQuaternion operator *(const DualQuaternion &dq1, const DualQuaternion &dq2);
+		friend inline const DualQuaternion operator *(const DualQuaternion &dq, scalar_t r);
+		friend inline const DualQuaternion operator *(scalar_t r, const DualQuaternion &dq);
+
+		/* Compound assignment operators */
+		friend inline DualQuaternion &operator +=(DualQuaternion &dq1, const DualQuaternion &dq2);
+		friend inline DualQuaternion &operator *=(DualQuaternion &dq1, const DualQuaternion &dq2);
+		friend inline DualQuaternion &operator *=(DualQuaternion &dq, scalar_t r);
+
+		/* Stream operations */
+		friend std::ostream& operator <<(std::ostream& out, const DualQuaternion &dq);
+
+		/* - Normalization */
+		inline void normalize();
+		inline DualQuaternion normalized() const;
+		/* - Inversion, for unit dual quaternions */
+		inline DualQuaternion conjugated() const;
+
+		/* Transformation, the dual quaternion must be normalized */
+		inline Vector3f translation() const;
+		inline Vector3f transform_point(const Vector3f &p) const;
+		inline Vector3f transform_vector(const Vector3f &v) const;
+
+		/* Conversion */
+		Matrix4x4f to_matrix4x4() const;
+
+		/* Skinning, see dquat_skin */
+		static void skin(vec3_soa_t *res_pos, vec3_soa_t *res_nrm,
+						 const vec3_soa_t *pos, const vec3_soa_t *nrm,
+						 const unsigned int *bone, const scalar_t *weight,
+						 const DualQuaternion *bones, unsigned int count);
+
+		static const DualQuaternion identity;
+
+		Quaternion real, dual;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "dualquat.inl"
+
+#endif /* NMATH_DUALQUAT_H_INCLUDED */
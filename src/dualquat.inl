@@ -0,0 +1,214 @@
+/*
+
+    This file is part of libnmath.
+
+    dualquat.inl
+    Dual quaternion inline functions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_DUALQUAT_INL_INCLUDED
+#define NMATH_DUALQUAT_INL_INCLUDED
+
+#ifndef NMATH_DUALQUAT_H_INCLUDED
+    #error "dualquat.h must be included before dualquat.inl"
+#endif /* NMATH_DUALQUAT_H_INCLUDED */
+
+#include "precision.h"
+#include "types.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline dquat_t dquat_pack(quat_t real, quat_t dual)
+{
+	dquat_t dq;
+	dq.real = real;
+	dq.dual = dual;
+	return dq;
+}
+
+static inline dquat_t dquat_identity(void)
+{
+	return dquat_pack(quat_pack(0, 0, 0, 1), quat_pack(0, 0, 0, 0));
+}
+
+static inline dquat_t dquat_from_rot_trans(quat_t rot, vec3_t trans)
+{
+	quat_t t = quat_pack(trans.x, trans.y, trans.z, 0);
+	return dquat_pack(rot, quat_scale(quat_mul(t, rot), 0.5));
+}
+
+static inline dquat_t dquat_add(dquat_t dq1, dquat_t dq2)
+{
+	return dquat_pack(quat_add(dq1.real, dq2.real), quat_add(dq1.dual, dq2.dual));
+}
+
+static inline dquat_t dquat_scale(dquat_t dq, scalar_t s)
+{
+	return dquat_pack(quat_scale(dq.real, s), quat_scale(dq.dual, s));
+}
+
+static inline dquat_t dquat_mul(dquat_t dq1, dquat_t dq2)
+{
+	return dquat_pack(quat_mul(dq1.real, dq2.real),
+					  quat_add(quat_mul(dq1.real, dq2.dual), quat_mul(dq1.dual, dq2.real)));
+}
+
+static inline dquat_t dquat_normalize(dquat_t dq)
+{
+	scalar_t len = quat_length(dq.real);
+
+	if (!len) {
+		return dq;
+	}
+
+	return dquat_scale(dq, 1.0 / len);
+}
+
+static inline dquat_t dquat_conjugate(dquat_t dq)
+{
+	return dquat_pack(quat_conjugate(dq.real), quat_conjugate(dq.dual));
+}
+
+static inline vec3_t dquat_get_translation(dquat_t dq)
+{
+	/* t = 2 * d * conjugate(r), expanded for the vector part only */
+	quat_t r = dq.real, d = dq.dual;
+
+	return vec3_pack(2 * (r.w * d.x - d.w * r.x + r.y * d.z - r.z * d.y),
+					 2 * (r.w * d.y - d.w * r.y + r.z * d.x - r.x * d.z),
+					 2 * (r.w * d.z - d.w * r.z + r.x * d.y - r.y * d.x));
+}
+
+static inline vec3_t dquat_transform_point(dquat_t dq, vec3_t p)
+{
+	vec3_t t = dquat_get_translation(dq);
+	vec3_t res = quat_rotate(dq.real, p);
+
+	res.x += t.x;
+	res.y += t.y;
+	res.z += t.z;
+	return res;
+}
+
+static inline vec3_t dquat_transform_vector(dquat_t dq, vec3_t v)
+{
+	return quat_rotate(dq.real, v);
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline DualQuaternion::DualQuaternion(const Quaternion &aReal, const Quaternion &aDual)
+	: real(aReal), dual(aDual)
+{}
+
+inline DualQuaternion::DualQuaternion(const Quaternion &rotation, const Vector3f &translation)
+	: real(rotation), dual(Quaternion(translation.x, translation.y, translation.z, 0) * rotation * 0.5)
+{}
+
+inline const DualQuaternion operator +(const DualQuaternion &dq1, const DualQuaternion &dq2)
+{
+	return DualQuaternion(dq1.real + dq2.real, dq1.dual + dq2.dual);
+}
+
+inline const DualQuaternion operator *(const DualQuaternion &dq1, const DualQuaternion &dq2)
+{
+	return DualQuaternion(dq1.real * dq2.real, dq1.real * dq2.dual + dq1.dual * dq2.real);
+}
+
+inline const DualQuaternion operator *(const DualQuaternion &dq, scalar_t r)
+{
+	return DualQuaternion(dq.real * r, dq.dual * r);
+}
+
+inline const DualQuaternion operator *(scalar_t r, const DualQuaternion &dq)
+{
+	return DualQuaternion(dq.real * r, dq.dual * r);
+}
+
+inline DualQuaternion &operator +=(DualQuaternion &dq1, const DualQuaternion &dq2)
+{
+	dq1.real += dq2.real;
+	dq1.dual += dq2.dual;
+	return dq1;
+}
+
+inline DualQuaternion &operator *=(DualQuaternion &dq1, const DualQuaternion &dq2)
+{
+	return dq1 = dq1 * dq2;
+}
+
+inline DualQuaternion &operator *=(DualQuaternion &dq, scalar_t r)
+{
+	dq.real *= r;
+	dq.dual *= r;
+	return dq;
+}
+
+inline void DualQuaternion::normalize()
+{
+	scalar_t len = real.length();
+
+	if (!len)
+		return;
+
+	*this *= 1.0 / len;
+}
+
+inline DualQuaternion DualQuaternion::normalized() const
+{
+	scalar_t len = real.length();
+	return (len != 0) ? *this * (1.0 / len) : *this;
+}
+
+inline DualQuaternion DualQuaternion::conjugated() const
+{
+	return DualQuaternion(real.conjugated(), dual.conjugated());
+}
+
+inline Vector3f DualQuaternion::translation() const
+{
+	/* See dquat_get_translation */
+	return Vector3f(2 * (real.w * dual.x - dual.w * real.x + real.y * dual.z - real.z * dual.y),
+					2 * (real.w * dual.y - dual.w * real.y + real.z * dual.x - real.x * dual.z),
+					2 * (real.w * dual.z - dual.w * real.z + real.x * dual.y - real.y * dual.x));
+}
+
+inline Vector3f DualQuaternion::transform_point(const Vector3f &p) const
+{
+	return real.rotate(p) + translation();
+}
+
+inline Vector3f DualQuaternion::transform_vector(const Vector3f &v) const
+{
+	return real.rotate(v);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_DUALQUAT_INL_INCLUDED */
@@ -0,0 +1,185 @@
+/*
+
+    This file is part of libnmath.
+
+    fastmath.cc
+    Fast transcendental approximations
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "fastmath.h"
+
+namespace NMath {
+
+/*
+	The array functions share one loop per arity, the operation is a
+	struct with a member template over the lane traits. The tail goes
+	through fm_scalar like the scalar fast_* functions, so an element gets
+	the same result whether it falls in the tail or not.
+*/
+#if defined(NMATH_SIMD_AVX2)
+	typedef fm_lane8 fm_wide;
+	#define NMATH_FASTMATH_WIDTH 8
+	#define fm_load(p)		_mm256_loadu_ps(p)
+	#define fm_store(p, v)	_mm256_storeu_ps(p, v)
+#elif defined(NMATH_SIMD_SSE2)
+	typedef fm_lane4 fm_wide;
+	#define NMATH_FASTMATH_WIDTH 4
+	#define fm_load(p)		_mm_loadu_ps(p)
+	#define fm_store(p, v)	_mm_storeu_ps(p, v)
+#endif /* NMATH_SIMD_AVX2 */
+
+template <class Op>
+static void fm_unary(float *res, const float *x, unsigned int count)
+{
+	unsigned int i = 0;
+
+#ifdef NMATH_FASTMATH_WIDTH
+	for (; i + NMATH_FASTMATH_WIDTH <= count; i += NMATH_FASTMATH_WIDTH) {
+		fm_store(res + i, Op::template apply<fm_wide>(fm_load(x + i)));
+	}
+#endif /* NMATH_FASTMATH_WIDTH */
+
+	for (; i < count; ++i) {
+		res[i] = NMATH_FASTMATH_OUT(Op::template apply<fm_scalar>(NMATH_FASTMATH_IN(x[i])));
+	}
+}
+
+template <class Op>
+static void fm_binary(float *res, const float *a, const float *b, unsigned int count)
+{
+	unsigned int i = 0;
+
+#ifdef NMATH_FASTMATH_WIDTH
+	for (; i + NMATH_FASTMATH_WIDTH <= count; i += NMATH_FASTMATH_WIDTH) {
+		fm_store(res + i, Op::template apply<fm_wide>(fm_load(a + i), fm_load(b + i)));
+	}
+#endif /* NMATH_FASTMATH_WIDTH */
+
+	for (; i < count; ++i) {
+		res[i] = NMATH_FASTMATH_OUT(Op::template apply<fm_scalar>(NMATH_FASTMATH_IN(a[i]), NMATH_FASTMATH_IN(b[i])));
+	}
+}
+
+struct fm_op_sin
+{
+	template <class L> static inline typename L::f apply(typename L::f x)
+	{
+		typename L::f s, c;
+		fm_sincos<L>(x, &s, &c);
+		return s;
+	}
+};
+
+struct fm_op_cos
+{
+	template <class L> static inline typename L::f apply(typename L::f x)
+	{
+		typename L::f s, c;
+		fm_sincos<L>(x, &s, &c);
+		return c;
+	}
+};
+
+struct fm_op_asin { template <class L> static inline typename L::f apply(typename L::f x) { return fm_asin<L>(x); } };
+struct fm_op_acos { template <class L> static inline typename L::f apply(typename L::f x) { return fm_acos<L>(x); } };
+struct fm_op_atan { template <class L> static inline typename L::f apply(typename L::f x) { return fm_atan<L>(x); } };
+struct fm_op_exp  { template <class L> static inline typename L::f apply(typename L::f x) { return fm_exp<L>(x); } };
+struct fm_op_log  { template <class L> static inline typename L::f apply(typename L::f x) { return fm_log<L>(x); } };
+
+struct fm_op_atan2 { template <class L> static inline typename L::f apply(typename L::f y, typename L::f x) { return fm_atan2<L>(y, x); } };
+struct fm_op_pow   { template <class L> static inline typename L::f apply(typename L::f x, typename L::f y) { return fm_pow<L>(x, y); } };
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+void fast_sin_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_sin>(res, x, count);
+}
+
+void fast_cos_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_cos>(res, x, count);
+}
+
+void fast_sincos_array(float *s, float *c, const float *x, unsigned int count)
+{
+	unsigned int i = 0;
+
+#ifdef NMATH_FASTMATH_WIDTH
+	for (; i + NMATH_FASTMATH_WIDTH <= count; i += NMATH_FASTMATH_WIDTH) {
+		fm_wide::f vs, vc;
+		fm_sincos<fm_wide>(fm_load(x + i), &vs, &vc);
+		fm_store(s + i, vs);
+		fm_store(c + i, vc);
+	}
+#endif /* NMATH_FASTMATH_WIDTH */
+
+	for (; i < count; ++i) {
+		fm_scalar::f vs, vc;
+		fm_sincos<fm_scalar>(NMATH_FASTMATH_IN(x[i]), &vs, &vc);
+		s[i] = NMATH_FASTMATH_OUT(vs);
+		c[i] = NMATH_FASTMATH_OUT(vc);
+	}
+}
+
+void fast_asin_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_asin>(res, x, count);
+}
+
+void fast_acos_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_acos>(res, x, count);
+}
+
+void fast_atan_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_atan>(res, x, count);
+}
+
+void fast_atan2_array(float *res, const float *y, const float *x, unsigned int count)
+{
+	fm_binary<fm_op_atan2>(res, y, x, count);
+}
+
+void fast_exp_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_exp>(res, x, count);
+}
+
+void fast_log_array(float *res, const float *x, unsigned int count)
+{
+	fm_unary<fm_op_log>(res, x, count);
+}
+
+void fast_pow_array(float *res, const float *x, const float *y, unsigned int count)
+{
+	fm_binary<fm_op_pow>(res, x, y, count);
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
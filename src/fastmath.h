@@ -0,0 +1,133 @@
+/*
+
+    This file is part of libnmath.
+
+    fastmath.h
+    Fast transcendental approximations
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_FASTMATH_H_INCLUDED
+#define NMATH_FASTMATH_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "simd.h"
+
+#include <stdint.h>
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	Single precision approximations of the elementary functions, with range
+	reduction and minimax polynomials after Cephes (S. L. Moshier). All are
+	branch free, so the same code runs on 1, 4 (SSE2) or 8 (AVX2) lanes and
+	every width gives the same results up to FMA contraction. With SSE2 the
+	scalar forms use the low lane of the vector code. The array forms are
+	where the speed is: the scalar exp, log and pow are slower than the C
+	library, the others less than twice as fast (bench/fastmath).
+
+	Maximum error against the correctly rounded result, in units in the
+	last place of a float, measured on every float of the stated domain
+	(4 million random points for atan2 and pow) by bench/fastmath_ulp:
+
+		fast_sin, fast_cos		2 ulp	|x| <= pi
+								14 ulp	|x| <= 100
+		fast_asin				3.5 ulp	[-1, 1]
+		fast_acos				2.5 ulp	[-1, 1]
+		fast_atan				5 ulp	all finite x
+		fast_atan2				5.5 ulp	all finite x, y
+		fast_exp				1.5 ulp	[-87.3, 88.3], 0 below, saturates above
+		fast_log				2 ulp	positive normal x
+		fast_pow				20 ulp	x > 0, |y * log(x)| <= 10; 0 for x <= 0
+								160 ulp	|y * log(x)| <= 88
+
+	For larger arguments of sin and cos the relative error grows near the
+	roots, the absolute error stays below 1e-7 up to |x| = 8192 and below
+	1e-6 up to 1e5. Nan and infinity are not handled.
+
+	Define MATH_FAST_TRANSCENDENTALS to route the nmath_* macros of
+	precision.h to these functions. In double precision the results then
+	have single precision accuracy.
+*/
+static inline float fast_sin(float x);
+static inline float fast_cos(float x);
+static inline void fast_sincos(float x, float *s, float *c);
+static inline float fast_asin(float x);
+static inline float fast_acos(float x);
+static inline float fast_atan(float x);
+static inline float fast_atan2(float y, float x);
+static inline float fast_exp(float x);
+static inline float fast_log(float x);
+static inline float fast_pow(float x, float y);
+
+#ifdef NMATH_SIMD_SSE2
+static inline __m128 fast_sin_ps(__m128 x);
+static inline __m128 fast_cos_ps(__m128 x);
+static inline void fast_sincos_ps(__m128 x, __m128 *s, __m128 *c);
+static inline __m128 fast_asin_ps(__m128 x);
+static inline __m128 fast_acos_ps(__m128 x);
+static inline __m128 fast_atan_ps(__m128 x);
+static inline __m128 fast_atan2_ps(__m128 y, __m128 x);
+static inline __m128 fast_exp_ps(__m128 x);
+static inline __m128 fast_log_ps(__m128 x);
+static inline __m128 fast_pow_ps(__m128 x, __m128 y);
+#endif /* NMATH_SIMD_SSE2 */
+
+#ifdef NMATH_SIMD_AVX2
+static inline __m256 fast_sin_ps256(__m256 x);
+static inline __m256 fast_cos_ps256(__m256 x);
+static inline void fast_sincos_ps256(__m256 x, __m256 *s, __m256 *c);
+static inline __m256 fast_asin_ps256(__m256 x);
+static inline __m256 fast_acos_ps256(__m256 x);
+static inline __m256 fast_atan_ps256(__m256 x);
+static inline __m256 fast_atan2_ps256(__m256 y, __m256 x);
+static inline __m256 fast_exp_ps256(__m256 x);
+static inline __m256 fast_log_ps256(__m256 x);
+static inline __m256 fast_pow_ps256(__m256 x, __m256 y);
+#endif /* NMATH_SIMD_AVX2 */
+
+/* Array versions, res[i] = f(x[i]), using the widest instruction set available */
+NMATH_DECLSPEC void fast_sin_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_cos_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_sincos_array(float *s, float *c, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_asin_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_acos_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_atan_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_atan2_array(float *res, const float *y, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_exp_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_log_array(float *res, const float *x, unsigned int count);
+NMATH_DECLSPEC void fast_pow_array(float *res, const float *x, const float *y, unsigned int count);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "fastmath.inl"
+
+#endif /* NMATH_FASTMATH_H_INCLUDED */
@@ -0,0 +1,592 @@
+/*
+
+    This file is part of libnmath.
+
+    fastmath.inl
+    Fast transcendental approximations
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_FASTMATH_INL_INCLUDED
+#define NMATH_FASTMATH_INL_INCLUDED
+
+#ifndef NMATH_FASTMATH_H_INCLUDED
+    #error "fastmath.h must be included before fastmath.inl"
+#endif /* NMATH_FASTMATH_H_INCLUDED */
+
+namespace NMath {
+
+/*
+	The library is built with -ffast-math, which would be free to fold the
+	split constants of the argument reductions back together and lose the
+	bits they exist for. An empty asm statement makes the compiler treat a
+	value as opaque at that point, which pins the evaluation order.
+*/
+#if defined(__GNUC__) && defined(NMATH_SIMD_SSE)
+	#define NMATH_FASTMATH_KEEP(v) __asm__("" : "+x"(v))
+#elif defined(__GNUC__)
+	#define NMATH_FASTMATH_KEEP(v) __asm__("" : "+m"(v))
+#else
+	#define NMATH_FASTMATH_KEEP(v)
+#endif /* __GNUC__ */
+
+/*
+	Lane traits. The approximations are written once against these, with
+	f a vector of floats, i the matching vector of ints and m a comparison
+	mask.
+*/
+struct fm_lane1
+{
+	typedef float f;
+	typedef int i;
+	typedef bool m;
+
+	static inline f set(float a) { return a; }
+	static inline f keep(f a) { NMATH_FASTMATH_KEEP(a); return a; }
+	static inline f add(f a, f b) { return a + b; }
+	static inline f sub(f a, f b) { return a - b; }
+	static inline f mul(f a, f b) { return a * b; }
+	static inline f div(f a, f b) { return a / b; }
+	static inline f fma(f a, f b, f c) { return a * b + c; }
+	static inline f sqrt(f a) { return sqrtf(a); }
+	static inline f abs(f a) { return a < 0 ? -a : a; }
+	static inline f min(f a, f b) { return a < b ? a : b; }
+	static inline f max(f a, f b) { return a > b ? a : b; }
+
+	static inline m lt(f a, f b) { return a < b; }
+	static inline m gt(f a, f b) { return a > b; }
+	static inline f select(m c, f a, f b) { return c ? a : b; }
+	static inline f negate_if(f a, m c) { return c ? -a : a; }
+
+	static inline i round(f a) { return (int)(a < 0 ? a - 0.5f : a + 0.5f); }
+	static inline f cvt(i a) { return (f)a; }
+	static inline i add_i(i a, int b) { return a + b; }
+	static inline m test_i(i a, int bit) { return (a & bit) != 0; }
+
+	/* 2^n for n in [-126, 127] */
+	static inline f pow2i(i n)
+	{
+		union { int32_t i; float f; } u;
+		u.i = (n + 127) << 23;
+		return u.f;
+	}
+
+	/* Mantissa in [0.5, 1) and exponent of a positive normal number */
+	static inline f frexp(f a, f *e)
+	{
+		union { int32_t i; float f; } u;
+		u.f = a;
+		*e = (f)((u.i >> 23) - 126);
+		u.i = (u.i & 0x007FFFFF) | 0x3F000000;
+		return u.f;
+	}
+};
+
+#ifdef NMATH_SIMD_SSE2
+struct fm_lane4
+{
+	typedef __m128 f;
+	typedef __m128i i;
+	typedef __m128 m;
+
+	static inline f set(float a) { return _mm_set1_ps(a); }
+	static inline f keep(f a) { NMATH_FASTMATH_KEEP(a); return a; }
+	static inline f add(f a, f b) { return _mm_add_ps(a, b); }
+	static inline f sub(f a, f b) { return _mm_sub_ps(a, b); }
+	static inline f mul(f a, f b) { return _mm_mul_ps(a, b); }
+	static inline f div(f a, f b) { return _mm_div_ps(a, b); }
+#ifdef __FMA__
+	static inline f fma(f a, f b, f c) { return _mm_fmadd_ps(a, b, c); }
+#else
+	static inline f fma(f a, f b, f c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#endif /* __FMA__ */
+	static inline f sqrt(f a) { return _mm_sqrt_ps(a); }
+	static inline f abs(f a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	static inline f min(f a, f b) { return _mm_min_ps(a, b); }
+	static inline f max(f a, f b) { return _mm_max_ps(a, b); }
+
+	static inline m lt(f a, f b) { return _mm_cmplt_ps(a, b); }
+	static inline m gt(f a, f b) { return _mm_cmpgt_ps(a, b); }
+	static inline f select(m c, f a, f b) { return _mm_or_ps(_mm_and_ps(c, a), _mm_andnot_ps(c, b)); }
+	static inline f negate_if(f a, m c) { return _mm_xor_ps(a, _mm_and_ps(c, _mm_set1_ps(-0.0f))); }
+
+	static inline i round(f a) { return _mm_cvtps_epi32(a); }
+	static inline f cvt(i a) { return _mm_cvtepi32_ps(a); }
+	static inline i add_i(i a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+	static inline m test_i(i a, int bit)
+	{
+		__m128i b = _mm_set1_epi32(bit);
+		return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, b), b));
+	}
+
+	static inline f pow2i(i n)
+	{
+		return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+	}
+
+	static inline f frexp(f a, f *e)
+	{
+		__m128i bits = _mm_castps_si128(a);
+		*e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+		bits = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F000000));
+		return _mm_castsi128_ps(bits);
+	}
+};
+#endif /* NMATH_SIMD_SSE2 */
+
+#ifdef NMATH_SIMD_AVX2
+struct fm_lane8
+{
+	typedef __m256 f;
+	typedef __m256i i;
+	typedef __m256 m;
+
+	static inline f set(float a) { return _mm256_set1_ps(a); }
+	static inline f keep(f a) { NMATH_FASTMATH_KEEP(a); return a; }
+	static inline f add(f a, f b) { return _mm256_add_ps(a, b); }
+	static inline f sub(f a, f b) { return _mm256_sub_ps(a, b); }
+	static inline f mul(f a, f b) { return _mm256_mul_ps(a, b); }
+	static inline f div(f a, f b) { return _mm256_div_ps(a, b); }
+#ifdef __FMA__
+	static inline f fma(f a, f b, f c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+	static inline f fma(f a, f b, f c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif /* __FMA__ */
+	static inline f sqrt(f a) { return _mm256_sqrt_ps(a); }
+	static inline f abs(f a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	static inline f min(f a, f b) { return _mm256_min_ps(a, b); }
+	static inline f max(f a, f b) { return _mm256_max_ps(a, b); }
+
+	static inline m lt(f a, f b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static inline m gt(f a, f b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static inline f select(m c, f a, f b) { return _mm256_blendv_ps(b, a, c); }
+	static inline f negate_if(f a, m c) { return _mm256_xor_ps(a, _mm256_and_ps(c, _mm256_set1_ps(-0.0f))); }
+
+	static inline i round(f a) { return _mm256_cvtps_epi32(a); }
+	static inline f cvt(i a) { return _mm256_cvtepi32_ps(a); }
+	static inline i add_i(i a, int b) { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+	static inline m test_i(i a, int bit)
+	{
+		__m256i b = _mm256_set1_epi32(bit);
+		return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, b), b));
+	}
+
+	static inline f pow2i(i n)
+	{
+		return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23));
+	}
+
+	static inline f frexp(f a, f *e)
+	{
+		__m256i bits = _mm256_castps_si256(a);
+		*e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(126)));
+		bits = _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF)), _mm256_set1_epi32(0x3F000000));
+		return _mm256_castsi256_ps(bits);
+	}
+};
+#endif /* NMATH_SIMD_AVX2 */
+
+/*
+	The scalar forms run on the low lane of the SSE2 code when there is one,
+	which keeps them free of branches and bit identical to the array forms.
+*/
+#ifdef NMATH_SIMD_SSE2
+	typedef fm_lane4 fm_scalar;
+	#define NMATH_FASTMATH_IN(x)	_mm_set_ss(x)
+	#define NMATH_FASTMATH_OUT(x)	_mm_cvtss_f32(x)
+#else
+	typedef fm_lane1 fm_scalar;
+	#define NMATH_FASTMATH_IN(x)	(x)
+	#define NMATH_FASTMATH_OUT(x)	(x)
+#endif /* NMATH_SIMD_SSE2 */
+
+/* Polynomial evaluation, Horner's scheme */
+template <class L>
+static inline typename L::f fm_poly(typename L::f x, const float *c, int n)
+{
+	typename L::f r = L::set(c[0]);
+
+	for (int k = 1; k < n; ++k) {
+		r = L::fma(r, x, L::set(c[k]));
+	}
+
+	return r;
+}
+
+template <class L>
+static inline void fm_sincos(typename L::f x, typename L::f *s, typename L::f *c)
+{
+	typedef typename L::f F;
+	typedef typename L::i I;
+
+	static const float sin_c[3] = { -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f };
+	static const float cos_c[3] = { 2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f };
+
+	/* Nearest multiple of pi/2, subtracted in three parts (Cody-Waite) */
+	I q = L::round(L::mul(x, L::set(0.63661977236758134f)));
+	F j = L::cvt(q);
+
+	F r = L::keep(L::fma(j, L::set(-1.5703125f), x));
+	r = L::keep(L::fma(j, L::set(-4.837512969970703125e-4f), r));
+	r = L::keep(L::fma(j, L::set(-7.54978995489188216e-8f), r));
+
+	/* Both on [-pi/4, pi/4] */
+	F z = L::mul(r, r);
+	F ps = L::fma(L::mul(fm_poly<L>(z, sin_c, 3), z), r, r);
+	F pc = L::add(L::fma(L::mul(fm_poly<L>(z, cos_c, 3), z), z, L::mul(L::set(-0.5f), z)), L::set(1));
+
+	/* Quadrant */
+	typename L::m swap = L::test_i(q, 1);
+	*s = L::negate_if(L::select(swap, pc, ps), L::test_i(q, 2));
+	*c = L::negate_if(L::select(swap, ps, pc), L::test_i(L::add_i(q, 1), 2));
+}
+
+/* asin of a in [0, 1] */
+template <class L>
+static inline typename L::f fm_asin_unit(typename L::f a, typename L::m *big)
+{
+	typedef typename L::f F;
+
+	static const float c[5] = { 4.2163199048e-2f, 2.4181311049e-2f, 4.5470025998e-2f, 7.4953002686e-2f, 1.6666752422e-1f };
+
+	/* Above 0.5, asin(a) = pi/2 - 2 asin(sqrt((1 - a) / 2)) */
+	*big = L::gt(a, L::set(0.5f));
+
+	F z = L::select(*big, L::mul(L::set(0.5f), L::sub(L::set(1), a)), L::mul(a, a));
+	F t = L::select(*big, L::sqrt(z), a);
+
+	return L::fma(L::mul(fm_poly<L>(z, c, 5), z), t, t);
+}
+
+template <class L>
+static inline typename L::f fm_asin(typename L::f x)
+{
+	typename L::m big;
+	typename L::f p = fm_asin_unit<L>(L::abs(x), &big);
+	typename L::f r = L::select(big, L::fma(L::set(-2), p, L::set(1.57079632679489661923f)), p);
+
+	return L::negate_if(r, L::lt(x, L::set(0)));
+}
+
+template <class L>
+static inline typename L::f fm_acos(typename L::f x)
+{
+	typedef typename L::f F;
+
+	typename L::m big;
+	typename L::m neg = L::lt(x, L::set(0));
+
+	F p = fm_asin_unit<L>(L::abs(x), &big);
+
+	/* Near +-1 acos is 2 asin(sqrt((1 - |x|) / 2)), mirrored for x < 0 */
+	F twice = L::mul(L::set(2), p);
+	F rb = L::select(neg, L::sub(L::set(3.14159265358979323846f), twice), twice);
+	F rs = L::sub(L::set(1.57079632679489661923f), L::negate_if(p, neg));
+
+	return L::select(big, rb, rs);
+}
+
+/* atan of a in [0, 1] */
+template <class L>
+static inline typename L::f fm_atan_unit(typename L::f a)
+{
+	typedef typename L::f F;
+
+	static const float c[4] = { 8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f };
+
+	/* Above tan(pi/8), atan(a) = pi/4 + atan((a - 1) / (a + 1)) */
+	typename L::m big = L::gt(a, L::set(0.4142135623730950f));
+
+	F t = L::select(big, L::div(L::sub(a, L::set(1)), L::add(a, L::set(1))), a);
+	F z = L::mul(t, t);
+	F p = L::fma(L::mul(fm_poly<L>(z, c, 4), z), t, t);
+
+	return L::add(p, L::select(big, L::set(0.78539816339744830962f), L::set(0)));
+}
+
+template <class L>
+static inline typename L::f fm_atan(typename L::f x)
+{
+	typedef typename L::f F;
+
+	F a = L::abs(x);
+	typename L::m big = L::gt(a, L::set(1));
+
+	/* atan(a) = pi/2 - atan(1 / a) */
+	F r = fm_atan_unit<L>(L::select(big, L::div(L::set(1), L::max(a, L::set(1))), a));
+	r = L::select(big, L::sub(L::set(1.57079632679489661923f), r), r);
+
+	return L::negate_if(r, L::lt(x, L::set(0)));
+}
+
+template <class L>
+static inline typename L::f fm_atan2(typename L::f y, typename L::f x)
+{
+	typedef typename L::f F;
+
+	F ax = L::abs(x);
+	F ay = L::abs(y);
+
+	/* The smaller over the larger is in [0, 1], and 0 / FLT_MIN for the origin */
+	F r = fm_atan_unit<L>(L::div(L::min(ax, ay), L::max(L::max(ax, ay), L::set(FLT_MIN))));
+
+	r = L::select(L::gt(ay, ax), L::sub(L::set(1.57079632679489661923f), r), r);
+	r = L::select(L::lt(x, L::set(0)), L::sub(L::set(3.14159265358979323846f), r), r);
+
+	return L::negate_if(r, L::lt(y, L::set(0)));
+}
+
+template <class L>
+static inline typename L::f fm_exp(typename L::f x)
+{
+	typedef typename L::f F;
+
+	static const float c[6] = { 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f };
+
+	/* Keeps 2^n a normal number */
+	F xc = L::min(L::max(x, L::set(-87.33654475f)), L::set(88.37626266f));
+
+	/* x = n ln2 + r, with ln2 in two parts */
+	typename L::i n = L::round(L::mul(xc, L::set(1.44269504088896341f)));
+	F fn = L::cvt(n);
+
+	F r = L::keep(L::fma(fn, L::set(-0.693359375f), xc));
+	r = L::keep(L::fma(fn, L::set(2.12194440e-4f), r));
+
+	F p = L::add(L::fma(L::mul(fm_poly<L>(r, c, 6), r), r, r), L::set(1));
+	F res = L::mul(p, L::pow2i(n));
+
+	return L::select(L::lt(x, L::set(-87.33654475f)), L::set(0), res);
+}
+
+template <class L>
+static inline typename L::f fm_log(typename L::f x)
+{
+	typedef typename L::f F;
+
+	static const float c[9] = { 7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f, 1.4249322787e-1f,
+								-1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f };
+
+	F e;
+	F m = L::frexp(x, &e);
+
+	/* Center the mantissa on 1, [sqrt(1/2), sqrt(2)) */
+	typename L::m small = L::lt(m, L::set(0.707106781186547524f));
+	e = L::sub(e, L::select(small, L::set(1), L::set(0)));
+	m = L::add(L::sub(m, L::set(1)), L::select(small, m, L::set(0)));
+
+	F z = L::mul(m, m);
+	F y = L::mul(L::mul(fm_poly<L>(m, c, 9), m), z);
+
+	/* ln2 in two parts again */
+	y = L::keep(L::fma(e, L::set(-2.12194440e-4f), y));
+	y = L::fma(L::set(-0.5f), z, y);
+
+	return L::fma(e, L::set(0.693359375f), L::keep(L::add(m, y)));
+}
+
+template <class L>
+static inline typename L::f fm_pow(typename L::f x, typename L::f y)
+{
+	typename L::f r = fm_exp<L>(L::mul(y, fm_log<L>(L::max(x, L::set(FLT_MIN)))));
+	return L::select(L::gt(x, L::set(0)), r, L::set(0));
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline float fast_sin(float x)
+{
+	fm_scalar::f s, c;
+	fm_sincos<fm_scalar>(NMATH_FASTMATH_IN(x), &s, &c);
+	return NMATH_FASTMATH_OUT(s);
+}
+
+static inline float fast_cos(float x)
+{
+	fm_scalar::f s, c;
+	fm_sincos<fm_scalar>(NMATH_FASTMATH_IN(x), &s, &c);
+	return NMATH_FASTMATH_OUT(c);
+}
+
+static inline void fast_sincos(float x, float *s, float *c)
+{
+	fm_scalar::f vs, vc;
+	fm_sincos<fm_scalar>(NMATH_FASTMATH_IN(x), &vs, &vc);
+	*s = NMATH_FASTMATH_OUT(vs);
+	*c = NMATH_FASTMATH_OUT(vc);
+}
+
+static inline float fast_asin(float x)
+{
+	return NMATH_FASTMATH_OUT(fm_asin<fm_scalar>(NMATH_FASTMATH_IN(x)));
+}
+
+static inline float fast_acos(float x)
+{
+	return NMATH_FASTMATH_OUT(fm_acos<fm_scalar>(NMATH_FASTMATH_IN(x)));
+}
+
+static inline float fast_atan(float x)
+{
+	return NMATH_FASTMATH_OUT(fm_atan<fm_scalar>(NMATH_FASTMATH_IN(x)));
+}
+
+static inline float fast_atan2(float y, float x)
+{
+	return NMATH_FASTMATH_OUT(fm_atan2<fm_scalar>(NMATH_FASTMATH_IN(y), NMATH_FASTMATH_IN(x)));
+}
+
+static inline float fast_exp(float x)
+{
+	return NMATH_FASTMATH_OUT(fm_exp<fm_scalar>(NMATH_FASTMATH_IN(x)));
+}
+
+static inline float fast_log(float x)
+{
+	return NMATH_FASTMATH_OUT(fm_log<fm_scalar>(NMATH_FASTMATH_IN(x)));
+}
+
+static inline float fast_pow(float x, float y)
+{
+	return NMATH_FASTMATH_OUT(fm_pow<fm_scalar>(NMATH_FASTMATH_IN(x), NMATH_FASTMATH_IN(y)));
+}
+
+#ifdef NMATH_SIMD_SSE2
+static inline __m128 fast_sin_ps(__m128 x)
+{
+	__m128 s, c;
+	fm_sincos<fm_lane4>(x, &s, &c);
+	return s;
+}
+
+static inline __m128 fast_cos_ps(__m128 x)
+{
+	__m128 s, c;
+	fm_sincos<fm_lane4>(x, &s, &c);
+	return c;
+}
+
+static inline void fast_sincos_ps(__m128 x, __m128 *s, __m128 *c)
+{
+	fm_sincos<fm_lane4>(x, s, c);
+}
+
+static inline __m128 fast_asin_ps(__m128 x)
+{
+	return fm_asin<fm_lane4>(x);
+}
+
+static inline __m128 fast_acos_ps(__m128 x)
+{
+	return fm_acos<fm_lane4>(x);
+}
+
+static inline __m128 fast_atan_ps(__m128 x)
+{
+	return fm_atan<fm_lane4>(x);
+}
+
+static inline __m128 fast_atan2_ps(__m128 y, __m128 x)
+{
+	return fm_atan2<fm_lane4>(y, x);
+}
+
+static inline __m128 fast_exp_ps(__m128 x)
+{
+	return fm_exp<fm_lane4>(x);
+}
+
+static inline __m128 fast_log_ps(__m128 x)
+{
+	return fm_log<fm_lane4>(x);
+}
+
+static inline __m128 fast_pow_ps(__m128 x, __m128 y)
+{
+	return fm_pow<fm_lane4>(x, y);
+}
+#endif /* NMATH_SIMD_SSE2 */
+
+#ifdef NMATH_SIMD_AVX2
+static inline __m256 fast_sin_ps256(__m256 x)
+{
+	__m256 s, c;
+	fm_sincos<fm_lane8>(x, &s, &c);
+	return s;
+}
+
+static inline __m256 fast_cos_ps256(__m256 x)
+{
+	__m256 s, c;
+	fm_sincos<fm_lane8>(x, &s, &c);
+	return c;
+}
+
+static inline void fast_sincos_ps256(__m256 x, __m256 *s, __m256 *c)
+{
+	fm_sincos<fm_lane8>(x, s, c);
+}
+
+static inline __m256 fast_asin_ps256(__m256 x)
+{
+	return fm_asin<fm_lane8>(x);
+}
+
+static inline __m256 fast_acos_ps256(__m256 x)
+{
+	return fm_acos<fm_lane8>(x);
+}
+
+static inline __m256 fast_atan_ps256(__m256 x)
+{
+	return fm_atan<fm_lane8>(x);
+}
+
+static inline __m256 fast_atan2_ps256(__m256 y, __m256 x)
+{
+	return fm_atan2<fm_lane8>(y, x);
+}
+
+static inline __m256 fast_exp_ps256(__m256 x)
+{
+	return fm_exp<fm_lane8>(x);
+}
+
+static inline __m256 fast_log_ps256(__m256 x)
+{
+	return fm_log<fm_lane8>(x);
+}
+
+static inline __m256 fast_pow_ps256(__m256 x, __m256 y)
+{
+	return fm_pow<fm_lane8>(x, y);
+}
+#endif /* NMATH_SIMD_AVX2 */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_FASTMATH_INL_INCLUDED */
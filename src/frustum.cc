@@ -0,0 +1,149 @@
+/*
+
+    This file is part of libnmath.
+
+    frustum.cc
+    View frustum culling
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "frustum.h"
+#include "simd.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+void frustum_from_matrix(frustum_t *f, const mat4x4_t m, int depth)
+{
+	for (unsigned int i = 0; i < 6; ++i) {
+		const scalar_t *row = m[i / 2];
+		scalar_t sign = i & 1 ? -1 : 1;
+		scalar_t p[4];
+
+		for (unsigned int k = 0; k < 4; ++k) {
+			p[k] = m[3][k] + sign * row[k];
+		}
+
+		/* The near plane of a [0, w] depth range is the third row alone */
+		if (i == FRUSTUM_NEAR && depth == FRUSTUM_DEPTH_ZERO) {
+			for (unsigned int k = 0; k < 4; ++k) {
+				p[k] = row[k];
+			}
+		}
+
+		scalar_t length = nmath_sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+		scalar_t inv = length > 0 ? 1 / length : 1;
+
+		f->plane[i].normal = vec3_pack(p[0] * inv, p[1] * inv, p[2] * inv);
+		f->plane[i].distance = p[3] * inv;
+	}
+}
+
+/*
+	The p-vertex of a plane takes each coordinate from the minimum or the
+	maximum by the sign of the normal, which is the same for every box, so
+	the arrays are chosen once per plane and the lanes need no select.
+*/
+void frustum_cull_batch(const frustum_t *f, aabb3_soa_t boxes, unsigned int count, uint32_t *mask)
+{
+	const scalar_t *px[6], *py[6], *pz[6];
+
+	for (unsigned int i = 0; i < 6; ++i) {
+		const vec3_t &n = f->plane[i].normal;
+
+		px[i] = n.x >= 0 ? boxes.max.x : boxes.min.x;
+		py[i] = n.y >= 0 ? boxes.max.y : boxes.min.y;
+		pz[i] = n.z >= 0 ? boxes.max.z : boxes.min.z;
+	}
+
+	int words = (int)((count + 31) / 32);
+
+	#pragma omp parallel for schedule(static) if(words > 1024)
+	for (int w = 0; w < words; ++w) {
+		unsigned int first = (unsigned int)w * 32;
+		unsigned int n = count - first < 32 ? count - first : 32;
+		uint32_t bits = 0;
+		unsigned int j = 0;
+
+#ifdef NMATH_SCALAR_LANES
+		for (; j + NMATH_SCALAR_LANES <= n; j += NMATH_SCALAR_LANES) {
+			unsigned int i = first + j;
+			scalar_v visible = scalar_v_le(scalar_v_set(0), scalar_v_set(0));
+
+			for (unsigned int k = 0; k < 6; ++k) {
+				const frustum_plane_t &p = f->plane[k];
+
+				scalar_v d = scalar_v_add(scalar_v_mul(scalar_v_set(p.normal.x), scalar_v_load(px[k] + i)),
+										  scalar_v_mul(scalar_v_set(p.normal.y), scalar_v_load(py[k] + i)));
+				d = scalar_v_add(d, scalar_v_mul(scalar_v_set(p.normal.z), scalar_v_load(pz[k] + i)));
+				d = scalar_v_add(d, scalar_v_set(p.distance));
+
+				visible = scalar_v_and(visible, scalar_v_le(scalar_v_set(0), d));
+			}
+
+			bits |= (uint32_t)scalar_v_bits(visible) << j;
+		}
+#endif /* NMATH_SCALAR_LANES */
+
+		for (; j < n; ++j) {
+			unsigned int i = first + j;
+			uint32_t visible = 1;
+
+			for (unsigned int k = 0; k < 6; ++k) {
+				const frustum_plane_t &p = f->plane[k];
+				scalar_t d = p.normal.x * px[k][i] + p.normal.y * py[k][i] + p.normal.z * pz[k][i] + p.distance;
+
+				visible &= (uint32_t)(d >= 0);
+			}
+
+			bits |= visible << j;
+		}
+
+		mask[w] = bits;
+	}
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+Frustum::Frustum()
+{
+	mat4x4_t m;
+	mat4x4_identity(m);
+	frustum_from_matrix(&m_frustum, m, FRUSTUM_DEPTH_NEGATIVE_ONE);
+}
+
+Frustum::Frustum(const Matrix4x4f &m, int depth)
+{
+	frustum_from_matrix(&m_frustum, m.data, depth);
+}
+
+void Frustum::cull(const aabb3_soa_t &boxes, unsigned int count, uint32_t *mask) const
+{
+	frustum_cull_batch(&m_frustum, boxes, count, mask);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
@@ -0,0 +1,162 @@
+/*
+
+    This file is part of libnmath.
+
+    frustum.h
+    View frustum culling
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_FRUSTUM_H_INCLUDED
+#define NMATH_FRUSTUM_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "matrix.h"
+#include "aabb.h"
+
+#include <stdint.h>
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/* Depth range of the clip space of the projection */
+enum NMATH_FRUSTUM_DEPTH
+{
+	FRUSTUM_DEPTH_NEGATIVE_ONE,	/* -w <= z <= w, as in OpenGL */
+	FRUSTUM_DEPTH_ZERO			/* 0 <= z <= w, as in Direct3D and Vulkan */
+};
+
+/* Result of a classification */
+enum NMATH_FRUSTUM_CLASS
+{
+	FRUSTUM_OUTSIDE,
+	FRUSTUM_INTERSECT,
+	FRUSTUM_INSIDE
+};
+
+enum NMATH_FRUSTUM_PLANE
+{
+	FRUSTUM_LEFT,
+	FRUSTUM_RIGHT,
+	FRUSTUM_BOTTOM,
+	FRUSTUM_TOP,
+	FRUSTUM_NEAR,
+	FRUSTUM_FAR
+};
+
+#define NMATH_FRUSTUM_ALL_PLANES	0x3F
+
+/*
+	A plane of a frustum, a unit normal pointing inwards and the signed
+	distance term of the plane equation, so that a point p is on the inner
+	side if dot(normal, p) + distance >= 0. This is not the convention of
+	plane_t and Plane, hence the separate type.
+*/
+struct frustum_plane_t
+{
+	vec3_t normal;
+	scalar_t distance;
+};
+
+typedef struct frustum_plane_t frustum_plane_t;
+
+/* The six planes of a frustum, a point is inside if it is inside all */
+struct frustum_t
+{
+	frustum_plane_t plane[6];
+};
+
+typedef struct frustum_t frustum_t;
+
+/*
+	Extract the planes from a view projection matrix m, as by Gribb and
+	Hartmann, "Fast Extraction of Viewing Frustum Planes from the
+	World-View-Projection Matrix", 2001. m maps column vectors to clip
+	space, where plane i is a combination of the last row and row i / 2.
+	With a projection alone the planes are in view space, with a model
+	view projection in object space.
+*/
+NMATH_DECLSPEC void frustum_from_matrix(frustum_t *f, const mat4x4_t m, int depth);
+
+/*
+	Box tests, with the p-vertex of the box, its corner farthest along a
+	normal, and the n-vertex, the nearest corner. A box is outside if the
+	p-vertex of a plane is behind it, and inside if no n-vertex is. Boxes
+	near the edges of the frustum may be found to intersect it although
+	they are outside, the tests are conservative.
+*/
+static inline int frustum_classify_aabb(const frustum_t *f, aabb3_t b);
+static inline short frustum_overlaps_aabb(const frustum_t *f, aabb3_t b);	// p-vertices only, 0 if outside
+
+/*
+	Classification against the planes set in *planes, which are cleared as
+	the box is found inside them. Children of a box that is inside a plane
+	are inside it too, so a hierarchy passes the planes left on to them.
+*/
+static inline int frustum_classify_aabb_planes(const frustum_t *f, aabb3_t b, unsigned int *planes);
+
+static inline short frustum_overlaps_sphere(const frustum_t *f, vec3_t center, scalar_t radius);
+
+/*
+	Cull count boxes. Bit i % 32 of mask[i / 32] is set if box i is not
+	outside, as by frustum_overlaps_aabb, the bits past count in the last
+	word are cleared. The boxes are tested NMATH_SCALAR_LANES at a time
+	and the words are spread over threads with OpenMP.
+*/
+NMATH_DECLSPEC void frustum_cull_batch(const frustum_t *f, aabb3_soa_t boxes, unsigned int count, uint32_t *mask);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+class NMATH_DECLSPEC Frustum
+{
+	public:
+		Frustum();
+		Frustum(const Matrix4x4f &m, int depth = FRUSTUM_DEPTH_NEGATIVE_ONE);
+
+		inline const frustum_t *data() const;
+		inline const frustum_plane_t &plane(unsigned int i) const;
+
+		inline int classify(const BoundingBox3 &b) const;
+		inline int classify(const BoundingBox3 &b, unsigned int *planes) const;
+		inline bool overlaps(const BoundingBox3 &b) const;
+		inline bool overlaps(const Vector3f &center, scalar_t radius) const;
+
+		void cull(const aabb3_soa_t &boxes, unsigned int count, uint32_t *mask) const;	// frustum_cull_batch
+
+	private:
+		frustum_t m_frustum;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "frustum.inl"
+
+#endif /* NMATH_FRUSTUM_H_INCLUDED */
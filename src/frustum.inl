@@ -0,0 +1,152 @@
+/*
+
+    This file is part of libnmath.
+
+    frustum.inl
+    View frustum culling
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_FRUSTUM_INL_INCLUDED
+#define NMATH_FRUSTUM_INL_INCLUDED
+
+#ifndef NMATH_FRUSTUM_H_INCLUDED
+    #error "frustum.h must be included before frustum.inl"
+#endif /* NMATH_FRUSTUM_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline int frustum_classify_aabb_planes(const frustum_t *f, aabb3_t b, unsigned int *planes)
+{
+	for (unsigned int i = 0; i < 6; ++i) {
+		if (!(*planes & (1u << i))) {
+			continue;
+		}
+
+		const frustum_plane_t *p = f->plane + i;
+
+		scalar_t pd = p->normal.x * (p->normal.x >= 0 ? b.max.x : b.min.x)
+					+ p->normal.y * (p->normal.y >= 0 ? b.max.y : b.min.y)
+					+ p->normal.z * (p->normal.z >= 0 ? b.max.z : b.min.z) + p->distance;
+
+		if (pd < 0) {
+			return FRUSTUM_OUTSIDE;
+		}
+
+		scalar_t nd = p->normal.x * (p->normal.x >= 0 ? b.min.x : b.max.x)
+					+ p->normal.y * (p->normal.y >= 0 ? b.min.y : b.max.y)
+					+ p->normal.z * (p->normal.z >= 0 ? b.min.z : b.max.z) + p->distance;
+
+		if (nd >= 0) {
+			*planes &= ~(1u << i);
+		}
+	}
+
+	return *planes ? FRUSTUM_INTERSECT : FRUSTUM_INSIDE;
+}
+
+static inline int frustum_classify_aabb(const frustum_t *f, aabb3_t b)
+{
+	unsigned int planes = NMATH_FRUSTUM_ALL_PLANES;
+	return frustum_classify_aabb_planes(f, b, &planes);
+}
+
+static inline short frustum_overlaps_aabb(const frustum_t *f, aabb3_t b)
+{
+	for (unsigned int i = 0; i < 6; ++i) {
+		const frustum_plane_t *p = f->plane + i;
+
+		scalar_t pd = p->normal.x * (p->normal.x >= 0 ? b.max.x : b.min.x)
+					+ p->normal.y * (p->normal.y >= 0 ? b.max.y : b.min.y)
+					+ p->normal.z * (p->normal.z >= 0 ? b.max.z : b.min.z) + p->distance;
+
+		if (pd < 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static inline short frustum_overlaps_sphere(const frustum_t *f, vec3_t center, scalar_t radius)
+{
+	for (unsigned int i = 0; i < 6; ++i) {
+		const frustum_plane_t *p = f->plane + i;
+
+		if (vec3_dot(p->normal, center) + p->distance < -radius) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline const frustum_t *Frustum::data() const
+{
+	return &m_frustum;
+}
+
+inline const frustum_plane_t &Frustum::plane(unsigned int i) const
+{
+	return m_frustum.plane[i];
+}
+
+inline int Frustum::classify(const BoundingBox3 &b) const
+{
+	unsigned int planes = NMATH_FRUSTUM_ALL_PLANES;
+	return classify(b, &planes);
+}
+
+inline int Frustum::classify(const BoundingBox3 &b, unsigned int *planes) const
+{
+	aabb3_t box;
+	box.min = vec3_pack(b.min.x, b.min.y, b.min.z);
+	box.max = vec3_pack(b.max.x, b.max.y, b.max.z);
+
+	return frustum_classify_aabb_planes(&m_frustum, box, planes);
+}
+
+inline bool Frustum::overlaps(const BoundingBox3 &b) const
+{
+	aabb3_t box;
+	box.min = vec3_pack(b.min.x, b.min.y, b.min.z);
+	box.max = vec3_pack(b.max.x, b.max.y, b.max.z);
+
+	return frustum_overlaps_aabb(&m_frustum, box) != 0;
+}
+
+inline bool Frustum::overlaps(const Vector3f &center, scalar_t radius) const
+{
+	return frustum_overlaps_sphere(&m_frustum, vec3_pack(center.x, center.y, center.z), radius) != 0;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_FRUSTUM_INL_INCLUDED */
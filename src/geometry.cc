@@ -44,6 +44,16 @@ Geometry::Geometry(NMATH_GEOMETRY_TYPE t)
 Geometry::~Geometry()
 {}
 
+// Subclasses that don't know their own surface fall back to the bounding
+// box. That is only an approximation: the point is on the box, not
+// necessarily on the surface (a diagonal segment touches its box only at
+// two corners), and its distance is a lower bound of the true one, 0
+// inside the box. Triangle, Sphere and Plane override it.
+Vector3f Geometry::closest_point(const Vector3f &p) const
+{
+	return aabb.closest_point(p);
+}
+
 #endif	/* __cplusplus */
 
 } /* namespace NMath */
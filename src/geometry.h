@@ -59,6 +59,10 @@ class NMATH_DECLSPEC Geometry
 		Geometry(NMATH_GEOMETRY_TYPE t);
 		virtual ~Geometry();
 		virtual bool intersection(const Ray &ray, IntInfo* i_info) const = 0;
+		// Closest point of the surface to p. The default is the closest point
+		// of the aabb, which need not be on the surface and is never farther
+		// than it: override it wherever exact point queries matter.
+		virtual Vector3f closest_point(const Vector3f &p) const;
 		virtual void calc_aabb() = 0;
 
 		NMATH_GEOMETRY_TYPE type;
@@ -0,0 +1,636 @@
+/*
+
+    This file is part of libnmath.
+
+    interpolation.cc
+    Interpolation
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "interpolation.h"
+
+/* Parameters of each interleaved difference chain before it restarts */
+#define NMATH_POLY3_LANES	32
+#define NMATH_POLY3_RESEED	32
+
+namespace NMath {
+	namespace Interpolation {
+
+template <unsigned int D>
+static void poly3_eval_kernel(const poly3_t *p, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t q[D];
+
+	for (unsigned int k = 0; k < D; ++k) {
+		q[k] = p[k];
+	}
+
+	for (unsigned int i = 0; i < count; ++i, res += D) {
+		for (unsigned int k = 0; k < D; ++k) {
+			res[k] = poly3_eval(q[k], t[i]);
+		}
+	}
+}
+
+/*
+	Forward differencing. Chain j of the NMATH_POLY3_LANES chains produces
+	the points i = j (mod lanes) with the step h = lanes * dt, so the chains
+	are independent and one step of all of them writes a contiguous run of
+	lanes * D scalars. The state is kept in that output order. The
+	differences at x are
+
+		d1 = p(x + h) - p(x) = h (c1 + c2 (2x + h) + c3 (3x^2 + 3xh + h^2))
+		d2 = d1(x + h) - d1(x) = 2h^2 (c2 + 3 c3 (x + h))
+		d3 = 6 c3 h^3
+
+	Every NMATH_POLY3_RESEED steps the chains restart from the exact
+	polynomial, which bounds the accumulated rounding error.
+*/
+template <unsigned int D>
+static void poly3_uniform_kernel(const poly3_t *p, scalar_t t0, scalar_t dt, scalar_t *res, unsigned int count)
+{
+	const unsigned int lanes = NMATH_POLY3_LANES;
+	const unsigned int width = NMATH_POLY3_LANES * D;
+	const scalar_t h = dt * lanes;
+
+	scalar_t f[NMATH_POLY3_LANES * D], d1[NMATH_POLY3_LANES * D], d2[NMATH_POLY3_LANES * D], d3[NMATH_POLY3_LANES * D];
+	poly3_t q[D];
+	unsigned int i = 0;
+
+	for (unsigned int k = 0; k < D; ++k) {
+		q[k] = p[k];
+	}
+
+	for (unsigned int j = 0; j < lanes; ++j) {
+		for (unsigned int k = 0; k < D; ++k) {
+			d3[j * D + k] = 6 * q[k].c3 * h * h * h;
+		}
+	}
+
+	while (i + lanes <= count) {
+		for (unsigned int j = 0; j < lanes; ++j) {
+			scalar_t x = t0 + (scalar_t)(i + j) * dt;
+
+			for (unsigned int k = 0; k < D; ++k) {
+				f[j * D + k] = poly3_eval(q[k], x);
+				d1[j * D + k] = h * (q[k].c1 + q[k].c2 * (2 * x + h) + q[k].c3 * (3 * x * x + 3 * x * h + h * h));
+				d2[j * D + k] = 2 * h * h * (q[k].c2 + 3 * q[k].c3 * (x + h));
+			}
+		}
+
+		unsigned int steps = (count - i) / lanes;
+		scalar_t *r = res + i * D;
+
+		if (steps > NMATH_POLY3_RESEED) {
+			steps = NMATH_POLY3_RESEED;
+		}
+
+		for (unsigned int n = 0; n < steps; ++n, r += width) {
+			for (unsigned int m = 0; m < width; ++m) {
+				r[m] = f[m];
+				f[m] += d1[m];
+				d1[m] += d2[m];
+				d2[m] += d3[m];
+			}
+		}
+
+		i += steps * lanes;
+	}
+
+	for (; i < count; ++i) {
+		for (unsigned int k = 0; k < D; ++k) {
+			res[i * D + k] = poly3_eval(q[k], t0 + (scalar_t)i * dt);
+		}
+	}
+}
+
+/*
+	Vector overloads. Vector2f, Vector3f and Vector4f are plain arrays of
+	2, 3 and 4 scalars, so a batch of them is the interleaved layout of
+	poly3_eval_batch.
+*/
+template <class V>
+static inline unsigned int vec_dim()
+{
+	return sizeof(V) / sizeof(scalar_t);
+}
+
+template <class V>
+static void poly3_batch(poly3_t (*f)(scalar_t, scalar_t), const V &a, const V &b, const scalar_t *t, V *res, unsigned int count)
+{
+	poly3_t p[4];
+
+	for (unsigned int k = 0; k < vec_dim<V>(); ++k) {
+		p[k] = f(a[k], b[k]);
+	}
+
+	poly3_eval_batch(p, vec_dim<V>(), t, &res->x, count);
+}
+
+template <class V>
+static void poly3_batch(poly3_t (*f)(scalar_t, scalar_t, scalar_t), const V &a, const V &b, const V &c, const scalar_t *t, V *res, unsigned int count)
+{
+	poly3_t p[4];
+
+	for (unsigned int k = 0; k < vec_dim<V>(); ++k) {
+		p[k] = f(a[k], b[k], c[k]);
+	}
+
+	poly3_eval_batch(p, vec_dim<V>(), t, &res->x, count);
+}
+
+template <class V>
+static void poly3_batch(poly3_t (*f)(scalar_t, scalar_t, scalar_t, scalar_t), const V &a, const V &b, const V &c, const V &d,
+						const scalar_t *t, V *res, unsigned int count)
+{
+	poly3_t p[4];
+
+	for (unsigned int k = 0; k < vec_dim<V>(); ++k) {
+		p[k] = f(a[k], b[k], c[k], d[k]);
+	}
+
+	poly3_eval_batch(p, vec_dim<V>(), t, &res->x, count);
+}
+
+template <class V>
+static void cardinal_vec(const V &a, const V &b, const V &c, const V &d, scalar_t tension, const scalar_t *t, V *res, unsigned int count)
+{
+	poly3_t p[4];
+
+	for (unsigned int k = 0; k < vec_dim<V>(); ++k) {
+		p[k] = poly3_cardinal(a[k], b[k], c[k], d[k], tension);
+	}
+
+	poly3_eval_batch(p, vec_dim<V>(), t, &res->x, count);
+}
+
+/* The curves that are not polynomials, component by component */
+template <class V>
+static void blend_batch(scalar_t (*f)(scalar_t, scalar_t, scalar_t), const V &a, const V &b, const scalar_t *t, V *res, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		for (unsigned int k = 0; k < vec_dim<V>(); ++k) {
+			res[i][k] = f(a[k], b[k], t[i]);
+		}
+	}
+}
+
+/*
+	Flattening. A Bezier curve lies in the convex hull of its control
+	points and the distance to a line segment is convex, so a quadratic
+	stays within 1/2 of the distance of its middle control point from the
+	chord, and a cubic within 3/4 of the larger distance of its inner
+	control points. Curves that fail the test are split in half with de
+	Casteljau's algorithm, left half first, on an explicit stack.
+*/
+#define NMATH_FLATTEN_DEPTH	16
+
+template <class V>
+static scalar_t chord_distance_squared(const V &p, const V &a, const V &b)
+{
+	V e = b - a;
+	V w = p - a;
+	scalar_t l = dot(e, e);
+	scalar_t t = l > 0 ? dot(w, e) / l : 0;
+
+	t = t < 0 ? 0 : (t > 1 ? 1 : t);
+	w -= e * t;
+
+	return dot(w, w);
+}
+
+template <class V, unsigned int N>
+static unsigned int flatten_bezier(const V *control, scalar_t bound, scalar_t tolerance, V *res, unsigned int max)
+{
+	V stack[NMATH_FLATTEN_DEPTH + 1][N];
+	unsigned int level[NMATH_FLATTEN_DEPTH + 1];
+	unsigned int top = 1, n = 1;
+
+	/* Squared distance of the control points allowed for a flat curve */
+	const scalar_t limit = (tolerance / bound) * (tolerance / bound);
+
+	if (max) {
+		res[0] = control[0];
+	}
+
+	for (unsigned int i = 0; i < N; ++i) {
+		stack[0][i] = control[i];
+	}
+
+	level[0] = 0;
+
+	while (top) {
+		V p[N];
+		unsigned int depth = level[--top];
+		scalar_t distance = 0;
+
+		for (unsigned int i = 0; i < N; ++i) {
+			p[i] = stack[top][i];
+		}
+
+		for (unsigned int i = 1; i + 1 < N; ++i) {
+			scalar_t d = chord_distance_squared(p[i], p[0], p[N - 1]);
+			distance = d > distance ? d : distance;
+		}
+
+		if (distance <= limit || depth == NMATH_FLATTEN_DEPTH) {
+			if (n < max) {
+				res[n] = p[N - 1];
+			}
+
+			++n;
+			continue;
+		}
+
+		/* De Casteljau, the right half goes below the left one */
+		V *right = stack[top];
+		V *left = stack[top + 1];
+
+		for (unsigned int r = 0; r < N; ++r) {
+			left[r] = p[0];
+			right[N - 1 - r] = p[N - 1 - r];
+
+			for (unsigned int i = 0; i + 1 < N - r; ++i) {
+				p[i] = (p[i] + p[i + 1]) * 0.5;
+			}
+		}
+
+		level[top] = level[top + 1] = depth + 1;
+		top += 2;
+	}
+
+	return n;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+void poly3_eval_batch(const poly3_t *p, unsigned int dim, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	switch (dim) {
+		case 1: poly3_eval_kernel<1>(p, t, res, count); break;
+		case 2: poly3_eval_kernel<2>(p, t, res, count); break;
+		case 3: poly3_eval_kernel<3>(p, t, res, count); break;
+		case 4: poly3_eval_kernel<4>(p, t, res, count); break;
+
+		default:
+			for (unsigned int k = 0; k < dim; ++k) {
+				for (unsigned int i = 0; i < count; ++i) {
+					res[i * dim + k] = poly3_eval(p[k], t[i]);
+				}
+			}
+			break;
+	}
+}
+
+void poly3_eval_uniform(const poly3_t *p, unsigned int dim, scalar_t t0, scalar_t dt, scalar_t *res, unsigned int count)
+{
+	switch (dim) {
+		case 1: poly3_uniform_kernel<1>(p, t0, dt, res, count); break;
+		case 2: poly3_uniform_kernel<2>(p, t0, dt, res, count); break;
+		case 3: poly3_uniform_kernel<3>(p, t0, dt, res, count); break;
+		case 4: poly3_uniform_kernel<4>(p, t0, dt, res, count); break;
+
+		default:
+			for (unsigned int k = 0; k < dim; ++k) {
+				for (unsigned int i = 0; i < count; ++i) {
+					res[i * dim + k] = poly3_eval(p[k], t0 + (scalar_t)i * dt);
+				}
+			}
+			break;
+	}
+}
+
+void smoothstep_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	scalar_t inv = 1 / (b - a);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		scalar_t y = (t[i] - a) * inv;
+		y = y < 0 ? 0 : (y > 1 ? 1 : y);
+		res[i] = y * y * (3 - 2 * y);
+	}
+}
+
+void smoothstep_perlin_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	scalar_t inv = 1 / (b - a);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		scalar_t y = (t[i] - a) * inv;
+		y = y < 0 ? 0 : (y > 1 ? 1 : y);
+		res[i] = y * y * y * (y * (y * 6 - 15) + 10);
+	}
+}
+
+void step_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		res[i] = step(a, b, t[i]);
+	}
+}
+
+void linear_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_linear(a, b);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void cosine_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		res[i] = cosine(a, b, t[i]);
+	}
+}
+
+void acceleration_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_acceleration(a, b);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void deceleration_batch(scalar_t a, scalar_t b, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_deceleration(a, b);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void cubic_batch(scalar_t a, scalar_t b, scalar_t c, scalar_t d, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_cubic(a, b, c, d);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void hermite_batch(scalar_t tang1, scalar_t a, scalar_t b, scalar_t tang2, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_hermite(tang1, a, b, tang2);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void cardinal_batch(scalar_t a, scalar_t b, scalar_t c, scalar_t d, scalar_t p, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t q = poly3_cardinal(a, b, c, d, p);
+	poly3_eval_batch(&q, 1, t, res, count);
+}
+
+void catmullrom_batch(scalar_t a, scalar_t b, scalar_t c, scalar_t d, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_catmullrom(a, b, c, d);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void bezier_quadratic_batch(scalar_t a, scalar_t b, scalar_t c, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_bezier_quadratic(a, b, c);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+void bezier_cubic_batch(scalar_t a, scalar_t b, scalar_t c, scalar_t d, const scalar_t *t, scalar_t *res, unsigned int count)
+{
+	poly3_t p = poly3_bezier_cubic(a, b, c, d);
+	poly3_eval_batch(&p, 1, t, res, count);
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+void smoothstep_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	blend_batch(smoothstep, a, b, t, res, count);
+}
+
+void smoothstep_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	blend_batch(smoothstep, a, b, t, res, count);
+}
+
+void smoothstep_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	blend_batch(smoothstep, a, b, t, res, count);
+}
+
+void smoothstep_perlin_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	blend_batch(smoothstep_perlin, a, b, t, res, count);
+}
+
+void smoothstep_perlin_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	blend_batch(smoothstep_perlin, a, b, t, res, count);
+}
+
+void smoothstep_perlin_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	blend_batch(smoothstep_perlin, a, b, t, res, count);
+}
+
+void step_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	blend_batch(step, a, b, t, res, count);
+}
+
+void step_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	blend_batch(step, a, b, t, res, count);
+}
+
+void step_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	blend_batch(step, a, b, t, res, count);
+}
+
+void linear_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_linear, a, b, t, res, count);
+}
+
+void linear_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_linear, a, b, t, res, count);
+}
+
+void linear_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_linear, a, b, t, res, count);
+}
+
+void cosine_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	blend_batch(cosine, a, b, t, res, count);
+}
+
+void cosine_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	blend_batch(cosine, a, b, t, res, count);
+}
+
+void cosine_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	blend_batch(cosine, a, b, t, res, count);
+}
+
+void acceleration_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_acceleration, a, b, t, res, count);
+}
+
+void acceleration_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_acceleration, a, b, t, res, count);
+}
+
+void acceleration_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_acceleration, a, b, t, res, count);
+}
+
+void deceleration_batch(const Vector2f &a, const Vector2f &b, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_deceleration, a, b, t, res, count);
+}
+
+void deceleration_batch(const Vector3f &a, const Vector3f &b, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_deceleration, a, b, t, res, count);
+}
+
+void deceleration_batch(const Vector4f &a, const Vector4f &b, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_deceleration, a, b, t, res, count);
+}
+
+void cubic_batch(const Vector2f &a, const Vector2f &b, const Vector2f &c, const Vector2f &d, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_cubic, a, b, c, d, t, res, count);
+}
+
+void cubic_batch(const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_cubic, a, b, c, d, t, res, count);
+}
+
+void cubic_batch(const Vector4f &a, const Vector4f &b, const Vector4f &c, const Vector4f &d, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_cubic, a, b, c, d, t, res, count);
+}
+
+void hermite_batch(const Vector2f &t1, const Vector2f &a, const Vector2f &b, const Vector2f &t2, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_hermite, t1, a, b, t2, t, res, count);
+}
+
+void hermite_batch(const Vector3f &t1, const Vector3f &a, const Vector3f &b, const Vector3f &t2, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_hermite, t1, a, b, t2, t, res, count);
+}
+
+void hermite_batch(const Vector4f &t1, const Vector4f &a, const Vector4f &b, const Vector4f &t2, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_hermite, t1, a, b, t2, t, res, count);
+}
+
+void cardinal_batch(const Vector2f &a, const Vector2f &b, const Vector2f &c, const Vector2f &d, scalar_t p, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	cardinal_vec(a, b, c, d, p, t, res, count);
+}
+
+void cardinal_batch(const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, scalar_t p, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	cardinal_vec(a, b, c, d, p, t, res, count);
+}
+
+void cardinal_batch(const Vector4f &a, const Vector4f &b, const Vector4f &c, const Vector4f &d, scalar_t p, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	cardinal_vec(a, b, c, d, p, t, res, count);
+}
+
+void catmullrom_batch(const Vector2f &a, const Vector2f &b, const Vector2f &c, const Vector2f &d, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_catmullrom, a, b, c, d, t, res, count);
+}
+
+void catmullrom_batch(const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_catmullrom, a, b, c, d, t, res, count);
+}
+
+void catmullrom_batch(const Vector4f &a, const Vector4f &b, const Vector4f &c, const Vector4f &d, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_catmullrom, a, b, c, d, t, res, count);
+}
+
+void bezier_quadratic_batch(const Vector2f &a, const Vector2f &b, const Vector2f &c, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_bezier_quadratic, a, b, c, t, res, count);
+}
+
+void bezier_quadratic_batch(const Vector3f &a, const Vector3f &b, const Vector3f &c, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_bezier_quadratic, a, b, c, t, res, count);
+}
+
+void bezier_quadratic_batch(const Vector4f &a, const Vector4f &b, const Vector4f &c, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_bezier_quadratic, a, b, c, t, res, count);
+}
+
+void bezier_cubic_batch(const Vector2f &a, const Vector2f &b, const Vector2f &c, const Vector2f &d, const scalar_t *t, Vector2f *res, unsigned int count)
+{
+	poly3_batch(poly3_bezier_cubic, a, b, c, d, t, res, count);
+}
+
+void bezier_cubic_batch(const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, const scalar_t *t, Vector3f *res, unsigned int count)
+{
+	poly3_batch(poly3_bezier_cubic, a, b, c, d, t, res, count);
+}
+
+void bezier_cubic_batch(const Vector4f &a, const Vector4f &b, const Vector4f &c, const Vector4f &d, const scalar_t *t, Vector4f *res, unsigned int count)
+{
+	poly3_batch(poly3_bezier_cubic, a, b, c, d, t, res, count);
+}
+
+unsigned int flatten_bezier_quadratic(const Vector2f &a, const Vector2f &b, const Vector2f &c, scalar_t tolerance, Vector2f *res, unsigned int max)
+{
+	const Vector2f control[3] = {a, b, c};
+	return flatten_bezier<Vector2f, 3>(control, 0.5, tolerance, res, max);
+}
+
+unsigned int flatten_bezier_quadratic(const Vector3f &a, const Vector3f &b, const Vector3f &c, scalar_t tolerance, Vector3f *res, unsigned int max)
+{
+	const Vector3f control[3] = {a, b, c};
+	return flatten_bezier<Vector3f, 3>(control, 0.5, tolerance, res, max);
+}
+
+unsigned int flatten_bezier_cubic(const Vector2f &a, const Vector2f &b, const Vector2f &c, const Vector2f &d, scalar_t tolerance, Vector2f *res, unsigned int max)
+{
+	const Vector2f control[4] = {a, b, c, d};
+	return flatten_bezier<Vector2f, 4>(control, 0.75, tolerance, res, max);
+}
+
+unsigned int flatten_bezier_cubic(const Vector3f &a, const Vector3f &b, const Vector3f &c, const Vector3f &d, scalar_t tolerance, Vector3f *res, unsigned int max)
+{
+	const Vector3f control[4] = {a, b, c, d};
+	return flatten_bezier<Vector3f, 4>(control, 0.75, tolerance, res, max);
+}
+	} /* namespace Interpolation */
+} /* namespace NMath */
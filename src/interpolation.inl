@@ -274,6 +274,72 @@ static inline scalar_t bezier_cubic(scalar_t a, scalar_t b, scalar_t c, scalar_t
 	return linear( abc, bcd, t);
 }
 
+/*
+**	Power basis forms of the polynomial curves above, for batch evaluation.
+*/
+static inline poly3_t poly3_pack(scalar_t c0, scalar_t c1, scalar_t c2, scalar_t c3)
+{
+	poly3_t p;
+	p.c0 = c0;
+	p.c1 = c1;
+	p.c2 = c2;
+	p.c3 = c3;
+	return p;
+}
+
+static inline poly3_t poly3_linear(scalar_t a, scalar_t b)
+{
+	return poly3_pack(a, b - a, 0, 0);
+}
+
+static inline poly3_t poly3_acceleration(scalar_t a, scalar_t b)
+{
+	return poly3_pack(a, 0, b - a, 0);
+}
+
+static inline poly3_t poly3_deceleration(scalar_t a, scalar_t b)
+{
+	/* 1 - (1 - t)^2 = 2t - t^2 */
+	return poly3_pack(a, 2 * (b - a), a - b, 0);
+}
+
+static inline poly3_t poly3_cubic(scalar_t a, scalar_t b, scalar_t c, scalar_t d)
+{
+	scalar_t P = (d - c) - (a - b);
+	return poly3_pack(b, c - a, (a - b) - P, P);
+}
+
+static inline poly3_t poly3_hermite(scalar_t tang1, scalar_t a, scalar_t b, scalar_t tang2)
+{
+	/* The hermite basis matrix applied to (a, b, tang1, tang2) */
+	return poly3_pack(a, tang1, 3 * (b - a) - 2 * tang1 - tang2, 2 * (a - b) + tang1 + tang2);
+}
+
+static inline poly3_t poly3_cardinal(scalar_t a, scalar_t b, scalar_t c, scalar_t d, scalar_t p)
+{
+	return poly3_hermite(p * (c - a), b, c, p * (d - b));
+}
+
+static inline poly3_t poly3_catmullrom(scalar_t a, scalar_t b, scalar_t c, scalar_t d)
+{
+	return poly3_pack(b, 0.5 * (c - a), 0.5 * ((2 * a) - (5 * b) + (4 * c) - d), 0.5 * (-a + (3 * (b - c)) + d));
+}
+
+static inline poly3_t poly3_bezier_quadratic(scalar_t a, scalar_t b, scalar_t c)
+{
+	return poly3_pack(a, 2 * (b - a), a - 2 * b + c, 0);
+}
+
+static inline poly3_t poly3_bezier_cubic(scalar_t a, scalar_t b, scalar_t c, scalar_t d)
+{
+	return poly3_pack(a, 3 * (b - a), 3 * (a - 2 * b + c), d - a + 3 * (b - c));
+}
+
+static inline scalar_t poly3_eval(poly3_t p, scalar_t t)
+{
+	return ((p.c3 * t + p.c2) * t + p.c1) * t + p.c0;
+}
+
 	} /* namespace Interpolation */
 } /* namespace NMath */
 
@@ -683,6 +749,32 @@ inline Vector4f bezier_cubic(Vector4f a, Vector4f b, Vector4f c, Vector4f d, sca
 	);
 }
 
+inline Quaternion nlerp(const Quaternion &a, const Quaternion &b, scalar_t p)
+{
+	quat_t q = quat_nlerp(quat_pack(a.x, a.y, a.z, a.w), quat_pack(b.x, b.y, b.z, b.w), p);
+	return Quaternion(q.x, q.y, q.z, q.w);
+}
+
+inline Quaternion slerp(const Quaternion &a, const Quaternion &b, scalar_t p)
+{
+	quat_t q = quat_slerp(quat_pack(a.x, a.y, a.z, a.w), quat_pack(b.x, b.y, b.z, b.w), p);
+	return Quaternion(q.x, q.y, q.z, q.w);
+}
+
+inline void nlerp(Quaternion *res, const Quaternion *a, const Quaternion *b, scalar_t p, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		res[i] = nlerp(a[i], b[i], p);
+	}
+}
+
+inline void slerp(Quaternion *res, const Quaternion *a, const Quaternion *b, scalar_t p, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		res[i] = slerp(a[i], b[i], p);
+	}
+}
+
 	} /* namespace Interpolation */
 } /* namespace NMath */
 
@@ -0,0 +1,533 @@
+/*
+
+    This file is part of libnmath.
+
+    kdtree.cc
+    Point k-d tree
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include <stdlib.h>
+
+#include "kdtree.h"
+
+/* Levels split one node per thread before the subtrees are built in parallel */
+#define NMATH_KDTREE_LEVELS	6
+
+/* Far sides pending in a query, enough for the depth of 2^32 points */
+#define NMATH_KDTREE_STACK	32
+
+namespace NMath {
+
+static inline scalar_t &kdtree_coord(vec3_t &v, unsigned int axis)
+{
+	return (&v.x)[axis];
+}
+
+static inline scalar_t kdtree_coord(const vec3_t &v, unsigned int axis)
+{
+	return (&v.x)[axis];
+}
+
+/* Squared distance limit of a query */
+static inline scalar_t kdtree_radius_squared(scalar_t radius)
+{
+	return radius < nmath_sqrt(SCALAR_T_MAX) ? radius * radius : SCALAR_T_MAX;
+}
+
+/*
+	Build
+*/
+
+/* Cell of a subtree that is still to be split */
+struct kdtree_job_t
+{
+	unsigned int lo, hi;
+	vec3_t min, max;
+};
+
+/* Reorder [lo, hi) so that point[k] has the median coordinate along axis */
+static void kdtree_select(vec3_t *point, unsigned int *index, unsigned int axis, int lo, int hi, int k)
+{
+	while (hi - lo > 1) {
+		scalar_t pivot = kdtree_coord(point[lo + (hi - lo) / 2], axis);
+		int i = lo, j = hi - 1;
+
+		while (i <= j) {
+			while (kdtree_coord(point[i], axis) < pivot) {
+				++i;
+			}
+
+			while (kdtree_coord(point[j], axis) > pivot) {
+				--j;
+			}
+
+			if (i <= j) {
+				vec3_t p = point[i];
+				point[i] = point[j];
+				point[j] = p;
+
+				unsigned int tmp = index[i];
+				index[i++] = index[j];
+				index[j--] = tmp;
+			}
+		}
+
+		/* point[lo, j] <= pivot <= point[i, hi) */
+		if (k <= j) {
+			hi = j + 1;
+		}
+		else if (k >= i) {
+			lo = i;
+		}
+		else {
+			return;
+		}
+	}
+}
+
+/* Split the cell at the median along its longest side, into child[0] below and child[1] above */
+static void kdtree_split(kdtree_t *t, const kdtree_job_t *job, kdtree_job_t *child)
+{
+	unsigned int lo = job->lo, hi = job->hi;
+
+	if (hi - lo <= NMATH_KDTREE_BUCKET) {
+		child[0] = *job;
+		child[1].lo = child[1].hi = hi;
+		return;
+	}
+
+	vec3_t size = vec3_sub(job->max, job->min);
+	unsigned int axis = size.x >= size.y ? (size.x >= size.z ? 0 : 2) : (size.y >= size.z ? 1 : 2);
+	unsigned int mid = lo + (hi - lo) / 2;
+
+	kdtree_select(t->point, t->index, axis, lo, hi, mid);
+	t->axis[mid] = (unsigned char)axis;
+
+	scalar_t split = kdtree_coord(t->point[mid], axis);
+
+	child[0] = *job;
+	child[0].hi = mid;
+	kdtree_coord(child[0].max, axis) = split;
+
+	child[1] = *job;
+	child[1].lo = mid + 1;
+	kdtree_coord(child[1].min, axis) = split;
+}
+
+static void kdtree_build(kdtree_t *t, const kdtree_job_t *job)
+{
+	kdtree_job_t child[2];
+
+	kdtree_split(t, job, child);
+
+	if (child[0].hi == job->hi) {
+		return;
+	}
+
+	kdtree_build(t, child);
+	kdtree_build(t, child + 1);
+}
+
+/*
+	Queries
+*/
+
+/* Query of the k nearest points, a max heap by the squared distance until the end */
+class KDTreeNearestQuery
+{
+	public:
+		KDTreeNearestQuery(const vec3_t &p, scalar_t radius, unsigned int *index, scalar_t *distance, unsigned int k)
+			: point(p)
+			, radius(radius)
+			, found(0)
+			, m_index(index)
+			, m_distance(distance)
+			, m_k(k)
+		{}
+
+		inline void test(const kdtree_t *t, unsigned int i)
+		{
+			vec3_t d = vec3_sub(t->point[i], point);
+			scalar_t distance = d.x * d.x + d.y * d.y + d.z * d.z;
+
+			if (distance >= radius) {
+				return;
+			}
+
+			unsigned int j;
+
+			if (found < m_k) {
+				/* Sift up from the end */
+				j = found++;
+
+				while (j && m_distance[(j - 1) / 2] < distance) {
+					m_index[j] = m_index[(j - 1) / 2];
+					m_distance[j] = m_distance[(j - 1) / 2];
+					j = (j - 1) / 2;
+				}
+			}
+			else {
+				/* Replace the farthest and sift down */
+				j = 0;
+
+				for (;;) {
+					unsigned int c = 2 * j + 1;
+
+					if (c >= found) {
+						break;
+					}
+
+					if (c + 1 < found && m_distance[c + 1] > m_distance[c]) {
+						++c;
+					}
+
+					if (m_distance[c] <= distance) {
+						break;
+					}
+
+					m_index[j] = m_index[c];
+					m_distance[j] = m_distance[c];
+					j = c;
+				}
+			}
+
+			m_index[j] = t->index[i];
+			m_distance[j] = distance;
+
+			if (found == m_k) {
+				radius = m_distance[0];
+			}
+		}
+
+		const vec3_t point;
+		scalar_t radius;
+		unsigned int found;
+
+	private:
+		unsigned int *m_index;
+		scalar_t *m_distance;
+		unsigned int m_k;
+};
+
+/* Query of the points closer than a radius, which stays fixed */
+class KDTreeRadiusQuery
+{
+	public:
+		KDTreeRadiusQuery(const vec3_t &p, scalar_t radius, unsigned int *index, scalar_t *distance, unsigned int max)
+			: point(p)
+			, radius(radius)
+			, found(0)
+			, m_index(index)
+			, m_distance(distance)
+			, m_max(max)
+		{}
+
+		inline void test(const kdtree_t *t, unsigned int i)
+		{
+			vec3_t d = vec3_sub(t->point[i], point);
+			scalar_t distance = d.x * d.x + d.y * d.y + d.z * d.z;
+
+			if (distance >= radius) {
+				return;
+			}
+
+			if (found < m_max) {
+				m_index[found] = t->index[i];
+
+				if (m_distance) {
+					m_distance[found] = distance;
+				}
+			}
+
+			++found;
+		}
+
+		const vec3_t point;
+		const scalar_t radius;
+		unsigned int found;
+
+	private:
+		unsigned int *m_index;
+		scalar_t *m_distance;
+		unsigned int m_max;
+};
+
+/* Pending far side of a node, with the squared distance to its split plane */
+struct kdtree_entry_t
+{
+	unsigned int lo, hi;
+	scalar_t distance;
+};
+
+/*
+	Descend to the side of the query point at every node, testing the
+	node's point on the way and pushing the other side if its split plane
+	is in range. A side popped later is skipped if the radius has since
+	shrunk past its plane.
+*/
+template <class Q>
+static void kdtree_traverse(const kdtree_t *t, Q &q)
+{
+	kdtree_entry_t stack[NMATH_KDTREE_STACK];
+	unsigned int top = 0;
+	unsigned int lo = 0, hi = t->count;
+
+	for (;;) {
+		while (hi - lo > NMATH_KDTREE_BUCKET) {
+			unsigned int mid = lo + (hi - lo) / 2;
+			scalar_t d = kdtree_coord(q.point, t->axis[mid]) - kdtree_coord(t->point[mid], t->axis[mid]);
+
+			q.test(t, mid);
+
+			if (d * d < q.radius) {
+				stack[top].lo = d < 0 ? mid + 1 : lo;
+				stack[top].hi = d < 0 ? hi : mid;
+				stack[top++].distance = d * d;
+			}
+
+			if (d < 0) {
+				hi = mid;
+			}
+			else {
+				lo = mid + 1;
+			}
+		}
+
+		for (unsigned int i = lo; i < hi; ++i) {
+			q.test(t, i);
+		}
+
+		do {
+			if (!top) {
+				return;
+			}
+			--top;
+		} while (stack[top].distance >= q.radius);
+
+		lo = stack[top].lo;
+		hi = stack[top].hi;
+	}
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+int kdtree_init(kdtree_t *t, const vec3_t *point, unsigned int count)
+{
+	t->count = 0;
+	t->point = 0;
+	t->index = 0;
+	t->axis = 0;
+
+	if (!count) {
+		return 0;
+	}
+
+	/* Points, indices and axes in one block */
+	char *mem = (char *)malloc(count * (sizeof(vec3_t) + sizeof(unsigned int) + 1));
+
+	if (!mem) {
+		return -1;
+	}
+
+	t->count = count;
+	t->point = (vec3_t *)mem;
+	t->index = (unsigned int *)(t->point + count);
+	t->axis = (unsigned char *)(t->index + count);
+
+	kdtree_job_t job[2][1 << NMATH_KDTREE_LEVELS];
+
+	job[0][0].lo = 0;
+	job[0][0].hi = count;
+	job[0][0].min = job[0][0].max = point[0];
+
+	for (unsigned int i = 0; i < count; ++i) {
+		t->point[i] = point[i];
+		t->index[i] = i;
+
+		for (unsigned int k = 0; k < 3; ++k) {
+			scalar_t c = kdtree_coord(point[i], k);
+
+			if (c < kdtree_coord(job[0][0].min, k)) {
+				kdtree_coord(job[0][0].min, k) = c;
+			}
+
+			if (c > kdtree_coord(job[0][0].max, k)) {
+				kdtree_coord(job[0][0].max, k) = c;
+			}
+		}
+	}
+
+	/*
+		The upper levels split every node of a level in parallel, the
+		subtrees below them are independent and are built one per thread.
+	*/
+	int jobs = 1;
+	unsigned int cur = 0;
+
+	for (unsigned int level = 0; level < NMATH_KDTREE_LEVELS; ++level) {
+		#pragma omp parallel for schedule(dynamic) if(jobs > 1 && count > 65536)
+		for (int j = 0; j < jobs; ++j) {
+			kdtree_split(t, job[cur] + j, job[cur ^ 1] + 2 * j);
+		}
+
+		jobs *= 2;
+		cur ^= 1;
+	}
+
+	#pragma omp parallel for schedule(dynamic) if(count > 65536)
+	for (int j = 0; j < jobs; ++j) {
+		if (job[cur][j].lo < job[cur][j].hi) {
+			kdtree_build(t, job[cur] + j);
+		}
+	}
+
+	return 0;
+}
+
+void kdtree_release(kdtree_t *t)
+{
+	free(t->point);
+	t->count = 0;
+	t->point = 0;
+	t->index = 0;
+	t->axis = 0;
+}
+
+unsigned int kdtree_nearest(const kdtree_t *t, vec3_t p, unsigned int k, scalar_t max_distance,
+							unsigned int *index, scalar_t *distance)
+{
+	if (!k || !t->count) {
+		return 0;
+	}
+
+	KDTreeNearestQuery q(p, kdtree_radius_squared(max_distance), index, distance, k);
+
+	kdtree_traverse(t, q);
+
+	/* Heap sort the results, nearest first */
+	for (unsigned int n = q.found; n > 1; --n) {
+		unsigned int last_index = index[n - 1];
+		scalar_t last = distance[n - 1];
+		unsigned int j = 0;
+
+		index[n - 1] = index[0];
+		distance[n - 1] = distance[0];
+
+		for (;;) {
+			unsigned int c = 2 * j + 1;
+
+			if (c >= n - 1) {
+				break;
+			}
+
+			if (c + 1 < n - 1 && distance[c + 1] > distance[c]) {
+				++c;
+			}
+
+			if (distance[c] <= last) {
+				break;
+			}
+
+			index[j] = index[c];
+			distance[j] = distance[c];
+			j = c;
+		}
+
+		index[j] = last_index;
+		distance[j] = last;
+	}
+
+	return q.found;
+}
+
+unsigned int kdtree_radius(const kdtree_t *t, vec3_t p, scalar_t radius, unsigned int max,
+						   unsigned int *index, scalar_t *distance)
+{
+	if (!t->count || radius < 0) {
+		return 0;
+	}
+
+	KDTreeRadiusQuery q(p, kdtree_radius_squared(radius), index, distance, max);
+
+	kdtree_traverse(t, q);
+
+	return q.found;
+}
+
+void kdtree_nearest_batch(const kdtree_t *t, const vec3_t *p, unsigned int count, unsigned int k, scalar_t max_distance,
+						  unsigned int *index, scalar_t *distance, unsigned int *found)
+{
+	#pragma omp parallel for schedule(dynamic, 64) if(count > 256)
+	for (int i = 0; i < (int)count; ++i) {
+		unsigned int n = kdtree_nearest(t, p[i], k, max_distance, index + (size_t)i * k, distance + (size_t)i * k);
+
+		if (found) {
+			found[i] = n;
+		}
+	}
+}
+
+void kdtree_radius_batch(const kdtree_t *t, const vec3_t *p, unsigned int count, scalar_t radius, unsigned int max,
+						 unsigned int *index, scalar_t *distance, unsigned int *found)
+{
+	#pragma omp parallel for schedule(dynamic, 64) if(count > 256)
+	for (int i = 0; i < (int)count; ++i) {
+		unsigned int n = kdtree_radius(t, p[i], radius, max, index + (size_t)i * max,
+									   distance ? distance + (size_t)i * max : 0);
+
+		if (found) {
+			found[i] = n;
+		}
+	}
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+KDTree::KDTree(const Vector3f *point, unsigned int count)
+{
+	/* Vector3f holds the same three scalars as vec3_t */
+	m_valid = !kdtree_init(&m_tree, (const vec3_t *)point, count);
+}
+
+KDTree::~KDTree()
+{
+	kdtree_release(&m_tree);
+}
+
+void KDTree::nearest(const Vector3f *p, unsigned int count, unsigned int k, unsigned int *index, scalar_t *distance,
+					 unsigned int *found, scalar_t max_distance) const
+{
+	kdtree_nearest_batch(&m_tree, (const vec3_t *)p, count, k, max_distance, index, distance, found);
+}
+
+void KDTree::radius(const Vector3f *p, unsigned int count, scalar_t radius, unsigned int max, unsigned int *index,
+					scalar_t *distance, unsigned int *found) const
+{
+	kdtree_radius_batch(&m_tree, (const vec3_t *)p, count, radius, max, index, distance, found);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
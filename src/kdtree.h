@@ -0,0 +1,142 @@
+/*
+
+    This file is part of libnmath.
+
+    kdtree.h
+    Point k-d tree
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_KDTREE_H_INCLUDED
+#define NMATH_KDTREE_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+
+/* Points in a leaf, which is scanned instead of split further */
+#define NMATH_KDTREE_BUCKET	8
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	Implicit k-d tree over points. The points are copied and reordered so
+	that the node of the range [lo, hi) is the median at lo + (hi - lo) / 2,
+	with the lower half of the range before it and the upper half after.
+	There are no pointers, the tree is the point array itself plus one byte
+	per node for the split axis, and ranges of up to NMATH_KDTREE_BUCKET
+	points are leaves.
+
+	The build selects the median along the longest side of each cell in
+	O(n log n). The lower levels are independent subtrees and are built in
+	parallel with OpenMP. The queries keep a stack of the far sides to
+	visit, which they skip once the split plane is out of range.
+
+	The distances of the results are squared.
+*/
+struct kdtree_t
+{
+	unsigned int count;
+	vec3_t *point;			/* in tree order */
+	unsigned int *index;	/* of each point in the array given to kdtree_init */
+	unsigned char *axis;	/* split axis of the node at each median */
+};
+
+typedef struct kdtree_t kdtree_t;
+
+/* Return 0 on success, -1 if the allocation failed */
+NMATH_DECLSPEC int kdtree_init(kdtree_t *t, const vec3_t *point, unsigned int count);
+NMATH_DECLSPEC void kdtree_release(kdtree_t *t);
+
+/*
+	The k points nearest to p, not farther than max_distance, nearest
+	first. Write their indices and squared distances to arrays of k
+	entries. Return how many were found, at most k.
+*/
+NMATH_DECLSPEC unsigned int kdtree_nearest(const kdtree_t *t, vec3_t p, unsigned int k, scalar_t max_distance,
+										   unsigned int *index, scalar_t *distance);
+
+/*
+	The points closer than radius to p, in no particular order. Write at most
+	max of them and return how many there are, which is more than max if
+	the buffers were too small. distance may be 0.
+*/
+NMATH_DECLSPEC unsigned int kdtree_radius(const kdtree_t *t, vec3_t p, scalar_t radius, unsigned int max,
+										  unsigned int *index, scalar_t *distance);
+
+/*
+	Batch queries for count points, spread over threads with OpenMP. The
+	results of query i start at index + i * k (or i * max), and found[i]
+	is what the single query returns. found may be 0.
+*/
+NMATH_DECLSPEC void kdtree_nearest_batch(const kdtree_t *t, const vec3_t *p, unsigned int count, unsigned int k, scalar_t max_distance,
+										 unsigned int *index, scalar_t *distance, unsigned int *found);
+NMATH_DECLSPEC void kdtree_radius_batch(const kdtree_t *t, const vec3_t *p, unsigned int count, scalar_t radius, unsigned int max,
+										unsigned int *index, scalar_t *distance, unsigned int *found);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/*
+	A tree that owns a reordered copy of the points, so it is not copyable.
+	valid() is false only if the copy could not be allocated, the tree is
+	then empty and the queries find nothing.
+*/
+class NMATH_DECLSPEC KDTree
+{
+	public:
+		KDTree(const Vector3f *point, unsigned int count);
+		~KDTree();
+
+		inline bool valid() const;
+		inline unsigned int count() const;
+		inline const kdtree_t *data() const;
+
+		inline unsigned int nearest(const Vector3f &p, unsigned int k, unsigned int *index, scalar_t *distance,
+									scalar_t max_distance = SCALAR_T_MAX) const;
+		inline unsigned int radius(const Vector3f &p, scalar_t radius, unsigned int max, unsigned int *index, scalar_t *distance) const;
+
+		void nearest(const Vector3f *p, unsigned int count, unsigned int k, unsigned int *index, scalar_t *distance,
+					 unsigned int *found, scalar_t max_distance = SCALAR_T_MAX) const;
+		void radius(const Vector3f *p, unsigned int count, scalar_t radius, unsigned int max, unsigned int *index,
+					scalar_t *distance, unsigned int *found) const;
+
+	private:
+		KDTree(const KDTree &);
+		KDTree &operator =(const KDTree &);
+
+		kdtree_t m_tree;
+		bool m_valid;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "kdtree.inl"
+
+#endif /* NMATH_KDTREE_H_INCLUDED */
@@ -0,0 +1,74 @@
+/*
+
+    This file is part of libnmath.
+
+    kdtree.inl
+    Point k-d tree
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_KDTREE_INL_INCLUDED
+#define NMATH_KDTREE_INL_INCLUDED
+
+#ifndef NMATH_KDTREE_H_INCLUDED
+    #error "kdtree.h must be included before kdtree.inl"
+#endif /* NMATH_KDTREE_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline bool KDTree::valid() const
+{
+	return m_valid;
+}
+
+inline unsigned int KDTree::count() const
+{
+	return m_tree.count;
+}
+
+inline const kdtree_t *KDTree::data() const
+{
+	return &m_tree;
+}
+
+inline unsigned int KDTree::nearest(const Vector3f &p, unsigned int k, unsigned int *index, scalar_t *distance,
+									scalar_t max_distance) const
+{
+	return kdtree_nearest(&m_tree, vec3_pack(p.x, p.y, p.z), k, max_distance, index, distance);
+}
+
+inline unsigned int KDTree::radius(const Vector3f &p, scalar_t radius, unsigned int max, unsigned int *index, scalar_t *distance) const
+{
+	return kdtree_radius(&m_tree, vec3_pack(p.x, p.y, p.z), radius, max, index, distance);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_KDTREE_INL_INCLUDED */
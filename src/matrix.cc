@@ -27,6 +27,7 @@
 
 #include "matrix.h"
 #include "vector.h"
+#include "simd.h"
 
 #ifdef __cplusplus
     #include <cmath>
@@ -361,23 +362,368 @@ void mat4x4_adjoint(mat4x4_t res, mat4x4_t m)
 	}
 }
 
+/*
+	General 4x4 inverse
+
+	The inverse is computed as adj(m) / det(m), with the cofactors expanded
+	over 2x2 sub-determinants instead of 3x3 ones. Both the determinant and
+	the adjugate share the same 12 sub-determinants, which brings the cost
+	down to roughly a third of the full cofactor expansion.
+
+	When SSE is available, the matrix is partitioned into four 2x2 blocks
+	| A B | and the blockwise adjugate formulation is used:
+	| C D |
+
+		|M| = |A||D| + |B||C| - tr((A#B)(D#C))
+		X#  = |D|A - B(D#C)          Y# = |B|C - D(A#B)#
+		Z#  = |C|B - A(D#C)#         W# = |A|D - C(A#B)
+
+	where # denotes the adjugate and the inverse is | X Y | = | X# Y# |# / |M|
+	                                                | Z W |   | Z# W# |
+
+	The kernels write the result to res and return the determinant. The
+	result is undefined when the determinant is zero.
+*/
+#if defined(NMATH_SIMD_SSE) && defined(MATH_SINGLE_PRECISION)
+
+#define NMATH_SHUFFLE_PS(a, b, x, y, z, w) _mm_shuffle_ps((a), (b), _MM_SHUFFLE((w), (z), (y), (x)))
+#define NMATH_SWIZZLE_PS(a, x, y, z, w) NMATH_SHUFFLE_PS((a), (a), (x), (y), (z), (w))
+
+/* 2x2 blocks are stored row major in a single register: (m00, m01, m10, m11) */
+static inline __m128 mat2x2_mul_ps(__m128 a, __m128 b)
+{
+	return _mm_add_ps(_mm_mul_ps(a, NMATH_SWIZZLE_PS(b, 0, 3, 0, 3)),
+					  _mm_mul_ps(NMATH_SWIZZLE_PS(a, 1, 0, 3, 2), NMATH_SWIZZLE_PS(b, 2, 1, 2, 1)));
+}
+
+/* adj(a) * b */
+static inline __m128 mat2x2_adjmul_ps(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(NMATH_SWIZZLE_PS(a, 3, 3, 0, 0), b),
+					  _mm_mul_ps(NMATH_SWIZZLE_PS(a, 1, 1, 2, 2), NMATH_SWIZZLE_PS(b, 2, 3, 0, 1)));
+}
+
+/* a * adj(b) */
+static inline __m128 mat2x2_muladj_ps(__m128 a, __m128 b)
+{
+	return _mm_sub_ps(_mm_mul_ps(a, NMATH_SWIZZLE_PS(b, 3, 0, 3, 0)),
+					  _mm_mul_ps(NMATH_SWIZZLE_PS(a, 1, 0, 3, 2), NMATH_SWIZZLE_PS(b, 2, 1, 2, 1)));
+}
+
+static scalar_t mat4x4_inverse_kernel(scalar_t res[4][4], const scalar_t m[4][4])
+{
+	__m128 r0 = _mm_loadu_ps(m[0]);
+	__m128 r1 = _mm_loadu_ps(m[1]);
+	__m128 r2 = _mm_loadu_ps(m[2]);
+	__m128 r3 = _mm_loadu_ps(m[3]);
+
+	__m128 a = NMATH_SHUFFLE_PS(r0, r1, 0, 1, 0, 1);
+	__m128 b = NMATH_SHUFFLE_PS(r0, r1, 2, 3, 2, 3);
+	__m128 c = NMATH_SHUFFLE_PS(r2, r3, 0, 1, 0, 1);
+	__m128 d = NMATH_SHUFFLE_PS(r2, r3, 2, 3, 2, 3);
+
+	/* (|A|, |B|, |C|, |D|) */
+	__m128 det_sub = _mm_sub_ps(
+		_mm_mul_ps(NMATH_SHUFFLE_PS(r0, r2, 0, 2, 0, 2), NMATH_SHUFFLE_PS(r1, r3, 1, 3, 1, 3)),
+		_mm_mul_ps(NMATH_SHUFFLE_PS(r0, r2, 1, 3, 1, 3), NMATH_SHUFFLE_PS(r1, r3, 0, 2, 0, 2)));
+
+	__m128 det_a = NMATH_SWIZZLE_PS(det_sub, 0, 0, 0, 0);
+	__m128 det_b = NMATH_SWIZZLE_PS(det_sub, 1, 1, 1, 1);
+	__m128 det_c = NMATH_SWIZZLE_PS(det_sub, 2, 2, 2, 2);
+	__m128 det_d = NMATH_SWIZZLE_PS(det_sub, 3, 3, 3, 3);
+
+	__m128 dc = mat2x2_adjmul_ps(d, c);
+	__m128 ab = mat2x2_adjmul_ps(a, b);
+
+	__m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), mat2x2_mul_ps(b, dc));
+	__m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), mat2x2_mul_ps(c, ab));
+	__m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), mat2x2_muladj_ps(d, ab));
+	__m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), mat2x2_muladj_ps(a, dc));
+
+	/* tr((A#B)(D#C)), summed across all lanes */
+	__m128 tr = _mm_mul_ps(ab, NMATH_SWIZZLE_PS(dc, 0, 2, 1, 3));
+	tr = _mm_add_ps(tr, NMATH_SWIZZLE_PS(tr, 1, 0, 3, 2));
+	tr = _mm_add_ps(tr, NMATH_SWIZZLE_PS(tr, 2, 3, 0, 1));
+
+	__m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), tr);
+
+	/* The sign pattern of the 2x2 adjugate is folded into the reciprocal */
+	__m128 rdet = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det);
+
+	x = _mm_mul_ps(x, rdet);
+	y = _mm_mul_ps(y, rdet);
+	z = _mm_mul_ps(z, rdet);
+	w = _mm_mul_ps(w, rdet);
+
+	/* The remaining adjugate swizzle is combined with the store */
+	_mm_storeu_ps(res[0], NMATH_SHUFFLE_PS(x, y, 3, 1, 3, 1));
+	_mm_storeu_ps(res[1], NMATH_SHUFFLE_PS(x, y, 2, 0, 2, 0));
+	_mm_storeu_ps(res[2], NMATH_SHUFFLE_PS(z, w, 3, 1, 3, 1));
+	_mm_storeu_ps(res[3], NMATH_SHUFFLE_PS(z, w, 2, 0, 2, 0));
+
+	return _mm_cvtss_f32(det);
+}
+
+#undef NMATH_SWIZZLE_PS
+#undef NMATH_SHUFFLE_PS
+
+#elif defined(NMATH_SIMD_SSE2) && !defined(MATH_SINGLE_PRECISION)
+
+/* 2x2 blocks are stored as two rows: r0 = (m00, m01), r1 = (m10, m11) */
+struct mat2x2_pd { __m128d r0, r1; };
+
+static inline __m128d mat2x2_bcast_lo_pd(__m128d v) { return _mm_unpacklo_pd(v, v); }
+static inline __m128d mat2x2_bcast_hi_pd(__m128d v) { return _mm_unpackhi_pd(v, v); }
+
+static inline mat2x2_pd mat2x2_load_pd(const scalar_t *row0, const scalar_t *row1)
+{
+	mat2x2_pd res;
+	res.r0 = _mm_loadu_pd(row0);
+	res.r1 = _mm_loadu_pd(row1);
+	return res;
+}
+
+/* |a| in both lanes */
+static inline __m128d mat2x2_det_pd(const mat2x2_pd &a)
+{
+	__m128d p = _mm_mul_pd(a.r0, _mm_shuffle_pd(a.r1, a.r1, 1));
+	return _mm_sub_pd(mat2x2_bcast_lo_pd(p), mat2x2_bcast_hi_pd(p));
+}
+
+static inline mat2x2_pd mat2x2_mul_pd(const mat2x2_pd &a, const mat2x2_pd &b)
+{
+	mat2x2_pd res;
+	res.r0 = _mm_add_pd(_mm_mul_pd(mat2x2_bcast_lo_pd(a.r0), b.r0), _mm_mul_pd(mat2x2_bcast_hi_pd(a.r0), b.r1));
+	res.r1 = _mm_add_pd(_mm_mul_pd(mat2x2_bcast_lo_pd(a.r1), b.r0), _mm_mul_pd(mat2x2_bcast_hi_pd(a.r1), b.r1));
+	return res;
+}
+
+static inline mat2x2_pd mat2x2_adj_pd(const mat2x2_pd &a)
+{
+	mat2x2_pd res;
+	res.r0 = _mm_xor_pd(_mm_shuffle_pd(a.r1, a.r0, 3), _mm_setr_pd(0.0, -0.0)); /* ( m11, -m01) */
+	res.r1 = _mm_xor_pd(_mm_shuffle_pd(a.r1, a.r0, 0), _mm_setr_pd(-0.0, 0.0)); /* (-m10,  m00) */
+	return res;
+}
+
+/* s * a - b */
+static inline mat2x2_pd mat2x2_scale_sub_pd(__m128d s, const mat2x2_pd &a, const mat2x2_pd &b)
+{
+	mat2x2_pd res;
+	res.r0 = _mm_sub_pd(_mm_mul_pd(s, a.r0), b.r0);
+	res.r1 = _mm_sub_pd(_mm_mul_pd(s, a.r1), b.r1);
+	return res;
+}
+
+static scalar_t mat4x4_inverse_kernel(scalar_t res[4][4], const scalar_t m[4][4])
+{
+	mat2x2_pd a = mat2x2_load_pd(&m[0][0], &m[1][0]);
+	mat2x2_pd b = mat2x2_load_pd(&m[0][2], &m[1][2]);
+	mat2x2_pd c = mat2x2_load_pd(&m[2][0], &m[3][0]);
+	mat2x2_pd d = mat2x2_load_pd(&m[2][2], &m[3][2]);
+
+	__m128d det_a = mat2x2_det_pd(a);
+	__m128d det_b = mat2x2_det_pd(b);
+	__m128d det_c = mat2x2_det_pd(c);
+	__m128d det_d = mat2x2_det_pd(d);
+
+	mat2x2_pd ab = mat2x2_mul_pd(mat2x2_adj_pd(a), b);
+	mat2x2_pd dc = mat2x2_mul_pd(mat2x2_adj_pd(d), c);
+
+	mat2x2_pd x = mat2x2_scale_sub_pd(det_d, a, mat2x2_mul_pd(b, dc));
+	mat2x2_pd w = mat2x2_scale_sub_pd(det_a, d, mat2x2_mul_pd(c, ab));
+	mat2x2_pd y = mat2x2_scale_sub_pd(det_b, c, mat2x2_mul_pd(d, mat2x2_adj_pd(ab)));
+	mat2x2_pd z = mat2x2_scale_sub_pd(det_c, b, mat2x2_mul_pd(a, mat2x2_adj_pd(dc)));
+
+	/* tr((A#B)(D#C)), summed across both lanes */
+	__m128d tr = _mm_add_pd(_mm_mul_pd(ab.r0, _mm_unpacklo_pd(dc.r0, dc.r1)),
+							_mm_mul_pd(ab.r1, _mm_unpackhi_pd(dc.r0, dc.r1)));
+	tr = _mm_add_pd(tr, _mm_shuffle_pd(tr, tr, 1));
+
+	__m128d det = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(det_a, det_d), _mm_mul_pd(det_b, det_c)), tr);
+	__m128d rdet = _mm_div_pd(_mm_set1_pd(1.0), det);
+
+	x = mat2x2_adj_pd(x);
+	y = mat2x2_adj_pd(y);
+	z = mat2x2_adj_pd(z);
+	w = mat2x2_adj_pd(w);
+
+	_mm_storeu_pd(&res[0][0], _mm_mul_pd(x.r0, rdet));
+	_mm_storeu_pd(&res[0][2], _mm_mul_pd(y.r0, rdet));
+	_mm_storeu_pd(&res[1][0], _mm_mul_pd(x.r1, rdet));
+	_mm_storeu_pd(&res[1][2], _mm_mul_pd(y.r1, rdet));
+	_mm_storeu_pd(&res[2][0], _mm_mul_pd(z.r0, rdet));
+	_mm_storeu_pd(&res[2][2], _mm_mul_pd(w.r0, rdet));
+	_mm_storeu_pd(&res[3][0], _mm_mul_pd(z.r1, rdet));
+	_mm_storeu_pd(&res[3][2], _mm_mul_pd(w.r1, rdet));
+
+	return _mm_cvtsd_f64(det);
+}
+
+#else
+
+static scalar_t mat4x4_inverse_kernel(scalar_t res[4][4], const scalar_t m[4][4])
+{
+	/* 2x2 sub-determinants of the upper and lower half */
+	scalar_t s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	scalar_t s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	scalar_t s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	scalar_t s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	scalar_t s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	scalar_t s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+
+	scalar_t c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	scalar_t c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	scalar_t c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	scalar_t c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	scalar_t c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	scalar_t c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+
+	scalar_t det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	scalar_t rdet = 1.0 / det;
+
+	mat4x4_t tmp;
+
+	tmp[0][0] = ( m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * rdet;
+	tmp[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * rdet;
+	tmp[0][2] = ( m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * rdet;
+	tmp[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * rdet;
+
+	tmp[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * rdet;
+	tmp[1][1] = ( m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * rdet;
+	tmp[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * rdet;
+	tmp[1][3] = ( m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * rdet;
+
+	tmp[2][0] = ( m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * rdet;
+	tmp[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * rdet;
+	tmp[2][2] = ( m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * rdet;
+	tmp[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * rdet;
+
+	tmp[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * rdet;
+	tmp[3][1] = ( m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * rdet;
+	tmp[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * rdet;
+	tmp[3][3] = ( m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * rdet;
+
+	memcpy(res, tmp, sizeof(mat4x4_t));
+
+	return det;
+}
+
+#endif /* NMATH_SIMD_SSE */
+
+/*
+	Affine inverse
+	| R t |^-1   | R^-1  -R^-1 t |
+	| 0 1 |    = | 0      1      |
+*/
+static scalar_t mat4x4_inverse_affine_kernel(scalar_t res[4][4], const scalar_t m[4][4])
+{
+	scalar_t i00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+	scalar_t i01 = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+	scalar_t i02 = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	scalar_t i10 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	scalar_t i11 = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+	scalar_t i12 = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+	scalar_t i20 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+	scalar_t i21 = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+	scalar_t i22 = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+
+	scalar_t det = m[0][0] * i00 + m[0][1] * i10 + m[0][2] * i20;
+	scalar_t rdet = 1.0 / det;
+
+	scalar_t tx = m[0][3], ty = m[1][3], tz = m[2][3];
+
+	i00 *= rdet; i01 *= rdet; i02 *= rdet;
+	i10 *= rdet; i11 *= rdet; i12 *= rdet;
+	i20 *= rdet; i21 *= rdet; i22 *= rdet;
+
+	res[0][0] = i00; res[0][1] = i01; res[0][2] = i02; res[0][3] = -(i00 * tx + i01 * ty + i02 * tz);
+	res[1][0] = i10; res[1][1] = i11; res[1][2] = i12; res[1][3] = -(i10 * tx + i11 * ty + i12 * tz);
+	res[2][0] = i20; res[2][1] = i21; res[2][2] = i22; res[2][3] = -(i20 * tx + i21 * ty + i22 * tz);
+	res[3][0] = 0;   res[3][1] = 0;   res[3][2] = 0;   res[3][3] = 1;
+
+	return det;
+}
+
+/*
+	Rigid body inverse
+	| R t |^-1   | R^T  -R^T t |
+	| 0 1 |    = | 0     1     |
+*/
+static void mat4x4_inverse_rigid_kernel(scalar_t res[4][4], const scalar_t m[4][4])
+{
+	scalar_t tx = m[0][3], ty = m[1][3], tz = m[2][3];
+
+	scalar_t r01 = m[0][1], r02 = m[0][2], r12 = m[1][2];
+
+	res[0][0] = m[0][0];
+	res[1][1] = m[1][1];
+	res[2][2] = m[2][2];
+
+	res[0][1] = m[1][0]; res[1][0] = r01;
+	res[0][2] = m[2][0]; res[2][0] = r02;
+	res[1][2] = m[2][1]; res[2][1] = r12;
+
+	res[0][3] = -(res[0][0] * tx + res[0][1] * ty + res[0][2] * tz);
+	res[1][3] = -(res[1][0] * tx + res[1][1] * ty + res[1][2] * tz);
+	res[2][3] = -(res[2][0] * tx + res[2][1] * ty + res[2][2] * tz);
+
+	res[3][0] = 0; res[3][1] = 0; res[3][2] = 0; res[3][3] = 1;
+}
+
 void mat4x4_inverse(mat4x4_t res, mat4x4_t m)
 {
-	int i, j;
-	mat4x4_t adj;
-	scalar_t det;
+	mat4x4_t inv;
 
-	det = mat4x4_determinant(m);
+	if (!mat4x4_inverse_kernel(inv, m)) {
+		return;
+	}
 
-	if (!det){
+	mat4x4_copy(res, inv);
+}
+
+void mat4x4_inverse_affine(mat4x4_t res, mat4x4_t m)
+{
+	mat4x4_t inv;
+
+	if (!mat4x4_inverse_affine_kernel(inv, m)) {
 		return;
 	}
 
-	mat4x4_adjoint(adj, m);
+	mat4x4_copy(res, inv);
+}
 
-	for (i=0; i<4; ++i) {
-		for (j=0; j<4; ++j) {
-			res[i][j] = adj[i][j] / det;
+void mat4x4_inverse_rigid(mat4x4_t res, mat4x4_t m)
+{
+	mat4x4_inverse_rigid_kernel(res, m);
+}
+
+void mat4x4_mul_batch(mat4x4_t *res, const mat4x4_t *m1, const mat4x4_t *m2, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		mat4x4_mul(res[i], m1[i], m2[i]);
+	}
+}
+
+void mat4x4_mul_batch_parent(mat4x4_t *res, const mat4x4_t parent, const mat4x4_t *m, unsigned int count)
+{
+	mat4x4_t p;
+	memcpy(p, parent, sizeof(mat4x4_t)); /* parent may live inside res */
+
+	for (unsigned int i=0; i<count; ++i) {
+		mat4x4_mul(res[i], p, m[i]);
+	}
+}
+
+void mat4x4_mul_hierarchy(mat4x4_t *world, const mat4x4_t *local, const int *parent, unsigned int count)
+{
+	/* Parents precede their children, so a single forward pass suffices */
+	for (unsigned int i=0; i<count; ++i) {
+		if (parent[i] < 0) {
+			memcpy(world[i], local[i], sizeof(mat4x4_t));
+		}
+		else {
+			mat4x4_mul(world[i], world[parent[i]], local[i]);
 		}
 	}
 }
@@ -405,25 +751,6 @@ void mat4x4_print(FILE *fp, mat4x4_t m)
 
 const Matrix3x3f Matrix3x3f::identity(1, 0, 0, 0, 1, 0, 0, 0, 1);
 
-Matrix3x3f::Matrix3x3f()
-{
-    *this = identity;
-}
-
-Matrix3x3f::Matrix3x3f(	scalar_t m11, scalar_t m12, scalar_t m13,
-						scalar_t m21, scalar_t m22, scalar_t m23,
-						scalar_t m31, scalar_t m32, scalar_t m33)
-{
-	data[0][0] = m11; data[0][1] = m12; data[0][2] = m13;
-	data[1][0] = m21; data[1][1] = m22; data[1][2] = m23;
-	data[2][0] = m31; data[2][1] = m32; data[2][2] = m33;
-}
-
-Matrix3x3f::Matrix3x3f(const mat3x3_t m)
-{
-	memcpy(data, m, sizeof(mat3x3_t));
-}
-
 Matrix3x3f::Matrix3x3f(const Matrix4x4f &mat4)
 {
     for (int i=0; i<3; ++i) {
@@ -755,27 +1082,6 @@ std::ostream &operator <<(std::ostream &out, const Matrix3x3f &mat)
 
 const Matrix4x4f Matrix4x4f::identity(1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1);
 
-Matrix4x4f::Matrix4x4f()
-{
-    *this = identity;
-}
-
-Matrix4x4f::Matrix4x4f(scalar_t m11, scalar_t m12, scalar_t m13, scalar_t m14,
-                       scalar_t m21, scalar_t m22, scalar_t m23, scalar_t m24,
-                       scalar_t m31, scalar_t m32, scalar_t m33, scalar_t m34,
-                       scalar_t m41, scalar_t m42, scalar_t m43, scalar_t m44)
-{
-    data[0][0] = m11; data[0][1] = m12; data[0][2] = m13; data[0][3] = m14;
-    data[1][0] = m21; data[1][1] = m22; data[1][2] = m23; data[1][3] = m24;
-    data[2][0] = m31; data[2][1] = m32; data[2][2] = m33; data[2][3] = m34;
-    data[3][0] = m41; data[3][1] = m42; data[3][2] = m43; data[3][3] = m44;
-}
-
-Matrix4x4f::Matrix4x4f(const mat4x4_t m)
-{
-    memcpy(data, m, sizeof(mat4x4_t));
-}
-
 Matrix4x4f::Matrix4x4f(const Matrix3x3f &mat3)
 {
     reset_identity();
@@ -816,16 +1122,7 @@ Matrix4x4f operator -(const Matrix4x4f &m1, const Matrix4x4f &m2)
 Matrix4x4f operator *(const Matrix4x4f &m1, const Matrix4x4f &m2)
 {
     Matrix4x4f res;
-
-	for (int i=0; i<4; ++i) {
-		for (int j=0; j<4; ++j) {
-			res.data[i][j] = m1.data[i][0] * m2.data[0][j] + 
-							 m1.data[i][1] * m2.data[1][j] + 
-							 m1.data[i][2] * m1.data[i][2] +
-							 m1.data[i][3] * m2.data[3][j];
-        }
-    }
-
+	mat4x4_mul(res.data, m1.data, m2.data);
     return res;
 }
 
@@ -851,18 +1148,7 @@ void operator -=(Matrix4x4f &m1, const Matrix4x4f &m2)
 
 void operator *=(Matrix4x4f &m1, const Matrix4x4f &m2)
 {
-    Matrix4x4f res;
-
-	for (int i=0; i<4; ++i) {
-        for (int j=0; j<4; ++j) {
-			res.data[i][j] = m1.data[i][0] * m2.data[0][j] + 
-							 m1.data[i][1] * m2.data[1][j] + 
-							 m1.data[i][2] * m1.data[i][2] +
-							 m1.data[i][3] * m2.data[3][j];
-        }
-    }
-
-    memcpy(m1.data, res.data, 16 * sizeof(scalar_t));
+	mat4x4_mul(m1.data, m1.data, m2.data);
 }
 
 Matrix4x4f operator *(const Matrix4x4f &mat, scalar_t r)
@@ -1151,8 +1437,39 @@ Matrix4x4f Matrix4x4f::adjoint() const
 
 Matrix4x4f Matrix4x4f::inverse() const
 {
-	Matrix4x4f adjMat = adjoint();
-    return adjMat * (1.0f / determinant());
+	Matrix4x4f res;
+	mat4x4_inverse_kernel(res.data, data);
+	return res;
+}
+
+Matrix4x4f Matrix4x4f::inverse_affine() const
+{
+	Matrix4x4f res;
+	mat4x4_inverse_affine_kernel(res.data, data);
+	return res;
+}
+
+Matrix4x4f Matrix4x4f::inverse_rigid() const
+{
+	Matrix4x4f res;
+	mat4x4_inverse_rigid_kernel(res.data, data);
+	return res;
+}
+
+void Matrix4x4f::mul(Matrix4x4f *res, const Matrix4x4f *m1, const Matrix4x4f *m2, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		mat4x4_mul(res[i].data, m1[i].data, m2[i].data);
+	}
+}
+
+void Matrix4x4f::mul(Matrix4x4f *res, const Matrix4x4f &parent, const Matrix4x4f *m, unsigned int count)
+{
+	Matrix4x4f p = parent;
+
+	for (unsigned int i=0; i<count; ++i) {
+		mat4x4_mul(res[i].data, p.data, m[i].data);
+	}
 }
 
 std::ostream &operator <<(std::ostream &out, const Matrix4x4f &mat)
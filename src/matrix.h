@@ -98,7 +98,12 @@ static inline void mat4x4_set_column(mat4x4_t m, vec4_t v, int idx);
 static inline void mat4x4_set_row(mat4x4_t m, vec4_t v, int idx);
 
 static inline void mat4x4_add(mat4x4_t res, mat4x4_t m1, mat4x4_t m2);
-static inline void mat4x4_mul(mat4x4_t res, mat4x4_t m1, mat4x4_t m2);
+static inline void mat4x4_mul(mat4x4_t res, const mat4x4_t m1, const mat4x4_t m2);
+
+/* Batched concatenation */
+NMATH_DECLSPEC void mat4x4_mul_batch(mat4x4_t *res, const mat4x4_t *m1, const mat4x4_t *m2, unsigned int count);  /* res[i] = m1[i] * m2[i] */
+NMATH_DECLSPEC void mat4x4_mul_batch_parent(mat4x4_t *res, const mat4x4_t parent, const mat4x4_t *m, unsigned int count); /* res[i] = parent * m[i] */
+NMATH_DECLSPEC void mat4x4_mul_hierarchy(mat4x4_t *world, const mat4x4_t *local, const int *parent, unsigned int count); /* parent[i] < i, or -1 for roots */
 
 NMATH_DECLSPEC void mat4x4_translate(mat4x4_t m, scalar_t x, scalar_t y, scalar_t z);
 NMATH_DECLSPEC void mat4x4_rotate(mat4x4_t m, scalar_t x, scalar_t y, scalar_t z);
@@ -112,6 +117,8 @@ NMATH_DECLSPEC void mat4x4_transpose(mat4x4_t res, mat4x4_t m);
 NMATH_DECLSPEC scalar_t mat4x4_determinant(mat4x4_t m);
 NMATH_DECLSPEC void mat4x4_adjoint(mat4x4_t res, mat4x4_t m);
 NMATH_DECLSPEC void mat4x4_inverse(mat4x4_t res, mat4x4_t m);
+NMATH_DECLSPEC void mat4x4_inverse_affine(mat4x4_t res, mat4x4_t m); /* m must have (0, 0, 0, 1) as its last row */
+NMATH_DECLSPEC void mat4x4_inverse_rigid(mat4x4_t res, mat4x4_t m);  /* m must be a pure rotation plus translation */
 
 NMATH_DECLSPEC void mat4x4_to_m3x3(mat3x3_t dest, mat4x4_t src);
 
@@ -125,11 +132,11 @@ class NMATH_DECLSPEC Matrix3x3f
 	friend class Matrix4x4f;
 	public:
 		/* Constructors */
-		Matrix3x3f();
-		Matrix3x3f(scalar_t m11, scalar_t m12, scalar_t m13,
-				   scalar_t m21, scalar_t m22, scalar_t m23,
-				   scalar_t m31, scalar_t m32, scalar_t m33);
-		Matrix3x3f(const mat3x3_t m);
+		inline Matrix3x3f();
+		inline Matrix3x3f(scalar_t m11, scalar_t m12, scalar_t m13,
+						  scalar_t m21, scalar_t m22, scalar_t m23,
+						  scalar_t m31, scalar_t m32, scalar_t m33);
+		inline Matrix3x3f(const mat3x3_t m);
 		Matrix3x3f(const Matrix4x4f &mat4);
 
 		/* Binary operators */
@@ -198,12 +205,12 @@ class NMATH_DECLSPEC Matrix4x4f
 	friend class Matrix3x3f;
 	public:
 		/* Constructors */
-		Matrix4x4f();
-		Matrix4x4f(scalar_t m11, scalar_t m12, scalar_t m13, scalar_t m14,
-				   scalar_t m21, scalar_t m22, scalar_t m23, scalar_t m24,
-				   scalar_t m31, scalar_t m32, scalar_t m33, scalar_t m34,
-				   scalar_t m41, scalar_t m42, scalar_t m43, scalar_t m44);
-		Matrix4x4f(const mat4x4_t m);
+		inline Matrix4x4f();
+		inline Matrix4x4f(scalar_t m11, scalar_t m12, scalar_t m13, scalar_t m14,
+						  scalar_t m21, scalar_t m22, scalar_t m23, scalar_t m24,
+						  scalar_t m31, scalar_t m32, scalar_t m33, scalar_t m34,
+						  scalar_t m41, scalar_t m42, scalar_t m43, scalar_t m44);
+		inline Matrix4x4f(const mat4x4_t m);
 		Matrix4x4f(const Matrix3x3f &mat3);
 
 		/* Binary operators */
@@ -256,6 +263,12 @@ class NMATH_DECLSPEC Matrix4x4f
 		scalar_t determinant() const;
 		Matrix4x4f adjoint() const;
 		Matrix4x4f inverse() const;
+		Matrix4x4f inverse_affine() const;	/* assumes (0, 0, 0, 1) as the last row */
+		Matrix4x4f inverse_rigid() const;	/* assumes an orthonormal upper 3x3 part */
+
+		/* Batched concatenation */
+		static void mul(Matrix4x4f *res, const Matrix4x4f *m1, const Matrix4x4f *m2, unsigned int count);
+		static void mul(Matrix4x4f *res, const Matrix4x4f &parent, const Matrix4x4f *m, unsigned int count);
 
 		friend std::ostream &operator <<(std::ostream &out, const Matrix4x4f &mat);
 
@@ -32,6 +32,8 @@
     #error "matrix.h must be included before matrix.inl"
 #endif /* NMATH_MATRIX_H_INCLUDED */
 
+#include "simd.h"
+
 #ifdef __cplusplus
 	#include <cstring>
 #else
@@ -159,32 +161,95 @@ static inline void mat4x4_add(mat4x4_t res, mat4x4_t m1, mat4x4_t m2)
 	}
 }
 
-static inline void mat4x4_mul(mat4x4_t res, mat4x4_t m1, mat4x4_t m2)
+/*
+	The product is computed one row at a time as a linear combination of
+	the rows of m2, which maps directly to SIMD registers. All of m2 and
+	the current row of m1 are loaded before anything is stored, so res
+	can alias either operand.
+*/
+static inline void mat4x4_mul(mat4x4_t res, const mat4x4_t m1, const mat4x4_t m2)
 {
-	res[0][0] = m1[0][0] * m2[0][0] + m1[0][1] * m2[1][0] + m1[0][2] * m2[2][0] + m1[0][3] * m2[3][0];
-	res[0][1] = m1[0][0] * m2[0][1] + m1[0][1] * m2[1][1] + m1[0][2] * m2[2][1] + m1[0][3] * m2[3][1];
-	res[0][2] = m1[0][0] * m2[0][2] + m1[0][1] * m2[1][2] + m1[0][2] * m2[2][2] + m1[0][3] * m2[3][2];
-	res[0][3] = m1[0][0] * m2[0][3] + m1[0][1] * m2[1][3] + m1[0][2] * m2[2][3] + m1[0][3] * m2[3][3];
+#if defined(NMATH_SIMD_AVX) && !defined(MATH_SINGLE_PRECISION)
+	__m256d b0 = _mm256_loadu_pd(m2[0]);
+	__m256d b1 = _mm256_loadu_pd(m2[1]);
+	__m256d b2 = _mm256_loadu_pd(m2[2]);
+	__m256d b3 = _mm256_loadu_pd(m2[3]);
+
+	for (int i=0; i<4; ++i) {
+		__m256d r = _mm256_mul_pd(_mm256_broadcast_sd(&m1[i][0]), b0);
+		r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(&m1[i][1]), b1));
+		r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(&m1[i][2]), b2));
+		r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_broadcast_sd(&m1[i][3]), b3));
+		_mm256_storeu_pd(res[i], r);
+	}
+#elif defined(NMATH_SIMD_SSE2) && !defined(MATH_SINGLE_PRECISION)
+	__m128d b0l = _mm_loadu_pd(&m2[0][0]), b0h = _mm_loadu_pd(&m2[0][2]);
+	__m128d b1l = _mm_loadu_pd(&m2[1][0]), b1h = _mm_loadu_pd(&m2[1][2]);
+	__m128d b2l = _mm_loadu_pd(&m2[2][0]), b2h = _mm_loadu_pd(&m2[2][2]);
+	__m128d b3l = _mm_loadu_pd(&m2[3][0]), b3h = _mm_loadu_pd(&m2[3][2]);
+
+	for (int i=0; i<4; ++i) {
+		__m128d a0 = _mm_set1_pd(m1[i][0]);
+		__m128d a1 = _mm_set1_pd(m1[i][1]);
+		__m128d a2 = _mm_set1_pd(m1[i][2]);
+		__m128d a3 = _mm_set1_pd(m1[i][3]);
+
+		__m128d rl = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, b0l), _mm_mul_pd(a1, b1l)),
+								_mm_add_pd(_mm_mul_pd(a2, b2l), _mm_mul_pd(a3, b3l)));
+		__m128d rh = _mm_add_pd(_mm_add_pd(_mm_mul_pd(a0, b0h), _mm_mul_pd(a1, b1h)),
+								_mm_add_pd(_mm_mul_pd(a2, b2h), _mm_mul_pd(a3, b3h)));
+
+		_mm_storeu_pd(&res[i][0], rl);
+		_mm_storeu_pd(&res[i][2], rh);
+	}
+#elif defined(NMATH_SIMD_SSE) && defined(MATH_SINGLE_PRECISION)
+	__m128 b0 = _mm_loadu_ps(m2[0]);
+	__m128 b1 = _mm_loadu_ps(m2[1]);
+	__m128 b2 = _mm_loadu_ps(m2[2]);
+	__m128 b3 = _mm_loadu_ps(m2[3]);
 
-	res[1][0] = m1[1][0] * m2[0][0] + m1[1][1] * m2[1][0] + m1[1][2] * m2[2][0] + m1[1][3] * m2[3][0];
-	res[1][1] = m1[1][0] * m2[0][1] + m1[1][1] * m2[1][1] + m1[1][2] * m2[2][1] + m1[1][3] * m2[3][1];
-	res[1][2] = m1[1][0] * m2[0][2] + m1[1][1] * m2[1][2] + m1[1][2] * m2[2][2] + m1[1][3] * m2[3][2];
-	res[1][3] = m1[1][0] * m2[0][3] + m1[1][1] * m2[1][3] + m1[1][2] * m2[2][3] + m1[1][3] * m2[3][3];
+	for (int i=0; i<4; ++i) {
+		__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m1[i][0]), b0), _mm_mul_ps(_mm_set1_ps(m1[i][1]), b1)),
+							  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m1[i][2]), b2), _mm_mul_ps(_mm_set1_ps(m1[i][3]), b3)));
+		_mm_storeu_ps(res[i], r);
+	}
+#else
+	mat4x4_t tmp;
 
-	res[2][0] = m1[2][0] * m2[0][0] + m1[2][1] * m2[1][0] + m1[2][2] * m2[2][0] + m1[2][3] * m2[3][0];
-	res[2][1] = m1[2][0] * m2[0][1] + m1[2][1] * m2[1][1] + m1[2][2] * m2[2][1] + m1[2][3] * m2[3][1];
-	res[2][2] = m1[2][0] * m2[0][2] + m1[2][1] * m2[1][2] + m1[2][2] * m2[2][2] + m1[2][3] * m2[3][2];
-	res[2][3] = m1[2][0] * m2[0][3] + m1[2][1] * m2[1][3] + m1[2][2] * m2[2][3] + m1[2][3] * m2[3][3];
+	for (int i=0; i<4; ++i) {
+		for (int j=0; j<4; ++j) {
+			tmp[i][j] = m1[i][0] * m2[0][j] + m1[i][1] * m2[1][j] + m1[i][2] * m2[2][j] + m1[i][3] * m2[3][j];
+		}
+	}
 
-	res[3][0] = m1[3][0] * m2[0][0] + m1[3][1] * m2[1][0] + m1[3][2] * m2[2][0] + m1[3][3] * m2[3][0];
-	res[3][1] = m1[3][0] * m2[0][1] + m1[3][1] * m2[1][1] + m1[3][2] * m2[2][1] + m1[3][3] * m2[3][1];
-	res[3][2] = m1[3][0] * m2[0][2] + m1[3][1] * m2[1][2] + m1[3][2] * m2[2][2] + m1[3][3] * m2[3][2];
-	res[3][3] = m1[3][0] * m2[0][3] + m1[3][1] * m2[1][3] + m1[3][2] * m2[2][3] + m1[3][3] * m2[3][3];
+	memcpy(res, tmp, sizeof(mat4x4_t));
+#endif /* NMATH_SIMD_AVX */
 }
 
 #ifdef __cplusplus
 }   /* extern "C" */
 
+/*
+	The constructors are inline and the identity comes from a constant
+	table, so matrices built from constants fold into plain stores.
+*/
+inline Matrix3x3f::Matrix3x3f()
+{
+	mat3x3_identity(data);
+}
+
+inline Matrix3x3f::Matrix3x3f(scalar_t m11, scalar_t m12, scalar_t m13,
+							  scalar_t m21, scalar_t m22, scalar_t m23,
+							  scalar_t m31, scalar_t m32, scalar_t m33)
+{
+	mat3x3_pack(data, m11, m12, m13, m21, m22, m23, m31, m32, m33);
+}
+
+inline Matrix3x3f::Matrix3x3f(const mat3x3_t m)
+{
+	memcpy(data, m, sizeof(mat3x3_t));
+}
+
 inline scalar_t *Matrix3x3f::operator [](int index)
 {
     return data[index < 9 ? index : 8];
@@ -197,7 +262,25 @@ inline const scalar_t *Matrix3x3f::operator [](int index) const
 
 inline void Matrix3x3f::reset_identity()
 {
-    memcpy(data, identity.data, 9 * sizeof(scalar_t));
+    mat3x3_identity(data);
+}
+
+inline Matrix4x4f::Matrix4x4f()
+{
+	mat4x4_identity(data);
+}
+
+inline Matrix4x4f::Matrix4x4f(scalar_t m11, scalar_t m12, scalar_t m13, scalar_t m14,
+							  scalar_t m21, scalar_t m22, scalar_t m23, scalar_t m24,
+							  scalar_t m31, scalar_t m32, scalar_t m33, scalar_t m34,
+							  scalar_t m41, scalar_t m42, scalar_t m43, scalar_t m44)
+{
+	mat4x4_pack(data, m11, m12, m13, m14, m21, m22, m23, m24, m31, m32, m33, m34, m41, m42, m43, m44);
+}
+
+inline Matrix4x4f::Matrix4x4f(const mat4x4_t m)
+{
+	memcpy(data, m, sizeof(mat4x4_t));
 }
 
 inline scalar_t *Matrix4x4f::operator [](int index)
@@ -212,7 +295,7 @@ inline const scalar_t *Matrix4x4f::operator [](int index) const
 
 inline void Matrix4x4f::reset_identity()
 {
-    memcpy(data, identity.data, 16 * sizeof(scalar_t));
+    mat4x4_identity(data);
 }
 
 #endif /* extern "C" */
@@ -0,0 +1,185 @@
+/*
+
+    This file is part of libnmath.
+
+    mutil.cc
+    Mathematical utilities
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "mutil.h"
+
+namespace NMath {
+
+/*
+	Vector width of invsqrt_batch in elements of scalar_t. Below AVX-512
+	the double precision paths take the estimate on floats.
+*/
+#ifdef MATH_SINGLE_PRECISION
+	#if defined(NMATH_SIMD_AVX512)
+		#define NMATH_RSQRT_WIDTH 16
+	#elif defined(NMATH_SIMD_AVX)
+		#define NMATH_RSQRT_WIDTH 8
+	#elif defined(NMATH_SIMD_SSE)
+		#define NMATH_RSQRT_WIDTH 4
+	#endif /* NMATH_SIMD_AVX512 */
+#else
+	#if defined(NMATH_SIMD_AVX512)
+		#define NMATH_RSQRT_WIDTH 8
+	#elif defined(NMATH_SIMD_SSE2)
+		#define NMATH_RSQRT_WIDTH 4
+	#endif /* NMATH_SIMD_AVX512 */
+#endif /* MATH_SINGLE_PRECISION */
+
+#ifdef NMATH_RSQRT_WIDTH
+/*
+	One group of NMATH_RSQRT_WIDTH elements. The Newton iteration is
+	y' = y (1.5 - 0.5 x y^2), and lanes with x <= 0 are cleared last, the
+	estimate there is infinite or nan.
+*/
+static inline void invsqrt_lanes(scalar_t *res, const scalar_t *x, int newton)
+{
+#if defined(MATH_SINGLE_PRECISION) && defined(NMATH_SIMD_AVX512)
+	__m512 vx = _mm512_loadu_ps(x);
+	__m512 y = _mm512_rsqrt14_ps(vx);
+
+	if (newton) {
+		__m512 hx = _mm512_mul_ps(_mm512_set1_ps(0.5f), vx);
+		y = _mm512_mul_ps(y, _mm512_fnmadd_ps(hx, _mm512_mul_ps(y, y), _mm512_set1_ps(1.5f)));
+	}
+
+	_mm512_storeu_ps(res, _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(vx, _mm512_setzero_ps(), _CMP_GT_OQ), y));
+
+#elif defined(MATH_SINGLE_PRECISION) && defined(NMATH_SIMD_AVX)
+	__m256 vx = _mm256_loadu_ps(x);
+	__m256 y = _mm256_rsqrt_ps(vx);
+
+	if (newton) {
+		__m256 hx = _mm256_mul_ps(_mm256_set1_ps(0.5f), vx);
+		y = _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(hx, _mm256_mul_ps(y, y))));
+	}
+
+	_mm256_storeu_ps(res, _mm256_and_ps(y, _mm256_cmp_ps(vx, _mm256_setzero_ps(), _CMP_GT_OQ)));
+
+#elif defined(MATH_SINGLE_PRECISION)
+	__m128 vx = _mm_loadu_ps(x);
+	__m128 y = _mm_rsqrt_ps(vx);
+
+	if (newton) {
+		__m128 hx = _mm_mul_ps(_mm_set1_ps(0.5f), vx);
+		y = _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(hx, _mm_mul_ps(y, y))));
+	}
+
+	_mm_storeu_ps(res, _mm_and_ps(y, _mm_cmpgt_ps(vx, _mm_setzero_ps())));
+
+#elif defined(NMATH_SIMD_AVX512)
+	__m512d vx = _mm512_loadu_pd(x);
+	__m512d y = _mm512_rsqrt14_pd(vx);
+
+	if (newton) {
+		__m512d hx = _mm512_mul_pd(_mm512_set1_pd(0.5), vx);
+		y = _mm512_mul_pd(y, _mm512_fnmadd_pd(hx, _mm512_mul_pd(y, y), _mm512_set1_pd(1.5)));
+	}
+
+	_mm512_storeu_pd(res, _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(vx, _mm512_setzero_pd(), _CMP_GT_OQ), y));
+
+#elif defined(NMATH_SIMD_AVX)
+	__m256d vx = _mm256_loadu_pd(x);
+	__m256d y = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(vx)));
+
+	if (newton) {
+		__m256d hx = _mm256_mul_pd(_mm256_set1_pd(0.5), vx);
+		y = _mm256_mul_pd(y, _mm256_sub_pd(_mm256_set1_pd(1.5), _mm256_mul_pd(hx, _mm256_mul_pd(y, y))));
+	}
+
+	_mm256_storeu_pd(res, _mm256_and_pd(y, _mm256_cmp_pd(vx, _mm256_setzero_pd(), _CMP_GT_OQ)));
+
+#else
+	__m128d x0 = _mm_loadu_pd(x);
+	__m128d x1 = _mm_loadu_pd(x + 2);
+	__m128 e = _mm_rsqrt_ps(_mm_movelh_ps(_mm_cvtpd_ps(x0), _mm_cvtpd_ps(x1)));
+	__m128d y0 = _mm_cvtps_pd(e);
+	__m128d y1 = _mm_cvtps_pd(_mm_movehl_ps(e, e));
+
+	if (newton) {
+		__m128d half = _mm_set1_pd(0.5);
+		__m128d three_halves = _mm_set1_pd(1.5);
+		y0 = _mm_mul_pd(y0, _mm_sub_pd(three_halves, _mm_mul_pd(_mm_mul_pd(half, x0), _mm_mul_pd(y0, y0))));
+		y1 = _mm_mul_pd(y1, _mm_sub_pd(three_halves, _mm_mul_pd(_mm_mul_pd(half, x1), _mm_mul_pd(y1, y1))));
+	}
+
+	_mm_storeu_pd(res, _mm_and_pd(y0, _mm_cmpgt_pd(x0, _mm_setzero_pd())));
+	_mm_storeu_pd(res + 2, _mm_and_pd(y1, _mm_cmpgt_pd(x1, _mm_setzero_pd())));
+#endif /* MATH_SINGLE_PRECISION && NMATH_SIMD_AVX512 */
+}
+#endif /* NMATH_RSQRT_WIDTH */
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+void invsqrt_batch(scalar_t *res, const scalar_t *x, unsigned int count, int accuracy)
+{
+	unsigned int i = 0;
+
+	if (accuracy == RSQRT_EXACT) {
+		for (; i < count; ++i) {
+			res[i] = x[i] > 0 ? 1 / nmath_sqrt(x[i]) : 0;
+		}
+		return;
+	}
+
+#ifdef NMATH_RSQRT_WIDTH
+	int newton = (accuracy == RSQRT_NEWTON);
+
+	for (; i + NMATH_RSQRT_WIDTH <= count; i += NMATH_RSQRT_WIDTH) {
+		invsqrt_lanes(res + i, x + i, newton);
+	}
+
+	/* The remainder goes through a padded group so that every element gets the same code */
+	if (i < count) {
+		scalar_t bx[NMATH_RSQRT_WIDTH];
+		scalar_t br[NMATH_RSQRT_WIDTH];
+		unsigned int n = count - i;
+
+		for (unsigned int k = 0; k < NMATH_RSQRT_WIDTH; ++k) {
+			bx[k] = k < n ? x[i + k] : 1;
+		}
+
+		invsqrt_lanes(br, bx, newton);
+
+		for (unsigned int k = 0; k < n; ++k) {
+			res[i + k] = br[k];
+		}
+	}
+#else
+	for (; i < count; ++i) {
+		float v = (float)x[i];
+		res[i] = v > 0 ? (accuracy == RSQRT_NEWTON ? approx_invsqrt2(v) : approx_invsqrt1(v)) : 0;
+	}
+#endif /* NMATH_RSQRT_WIDTH */
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
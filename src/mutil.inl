@@ -46,29 +46,36 @@ extern "C" {
 	The creator is unknown but traced back as: 	John Carmack -> Michael Abrash ->
 	Terje Matheson -> Gary Tarollii -> Greg Walsh & Cleve Moler
 
-	A faster alternative is to use SSE rsqrtss
+	With SSE the first approximation is the rsqrtss estimate instead, which
+	is both faster and 12 bits accurate where the integer trick gives 5.
 */
+static inline float approx_invsqrt_estimate(float x)
+{
+#ifdef NMATH_SIMD_SSE
+	return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+	union { float f; int i; } u;
+	u.f = x;
+	u.i = 0x5f3759df - (u.i >> 1);
+	return u.f;
+#endif /* NMATH_SIMD_SSE */
+}
+
 static inline float approx_invsqrt1(float x)
 {
-	float xcopy = x;
-	float xhalf = 0.5f * xcopy;
-	int i = *(long *)&xcopy;
-	i = 0x5f3759df - (i >> 1);
-	xcopy = *(float *)&i;
-	xcopy *= (1.5f - xhalf * xcopy * xcopy);
-	return xcopy;
+	float xhalf = 0.5f * x;
+	float y = approx_invsqrt_estimate(x);
+	y *= (1.5f - xhalf * y * y);
+	return y;
 }
 
 static inline float approx_invsqrt2(float x)
 {
-	float xcopy = x;
-	float xhalf = 0.5f * xcopy;
-	int i = *(long *)&xcopy;
-	i = 0x5f3759df - (i >> 1);
-	xcopy = *(float *)&i;
-	xcopy *= (1.5f - xhalf * xcopy * xcopy);
-	xcopy *= (1.5f - xhalf * xcopy * xcopy);
-	return xcopy;
+	float xhalf = 0.5f * x;
+	float y = approx_invsqrt_estimate(x);
+	y *= (1.5f - xhalf * y * y);
+	y *= (1.5f - xhalf * y * y);
+	return y;
 }
 
 /* Conversion between radians and degrees */
@@ -94,6 +94,14 @@ bool Plane::intersection(const Ray &ray, IntInfo* i_info) const
 	return true;
 }
 
+Vector3f Plane::closest_point(const Vector3f &p) const
+{
+	// the same point of the plane as in intersection()
+	Vector3f v = Vector3f(nmath_abs(normal.x), nmath_abs(normal.y), nmath_abs(normal.z)) * distance;
+
+	return p - normal * (dot(p - v, normal) / dot(normal, normal));
+}
+
 void Plane::calc_aabb()
 {
 	// The plane is infoinite so the bounding box is infinity as well
@@ -62,6 +62,7 @@ class NMATH_DECLSPEC Plane: public Geometry
 		Plane();
 
 		bool intersection(const Ray &ray, IntInfo* i_info) const;
+		Vector3f closest_point(const Vector3f &p) const;
 		void calc_aabb();
 
 		Vector3f normal;
@@ -79,6 +79,25 @@ namespace NMath {
 
 #endif /* MATH_SINGLE_PRECISION */
 
+/* Fast approximations in place of the C library, see fastmath.h */
+#ifdef MATH_FAST_TRANSCENDENTALS
+	#undef nmath_sin
+	#undef nmath_cos
+	#undef nmath_asin
+	#undef nmath_acos
+	#undef nmath_atan
+	#undef nmath_atan2
+	#undef nmath_pow
+
+	#define nmath_sin	NMath::fast_sin
+	#define nmath_cos	NMath::fast_cos
+	#define nmath_asin	NMath::fast_asin
+	#define nmath_acos	NMath::fast_acos
+	#define nmath_atan	NMath::fast_atan
+	#define nmath_atan2	NMath::fast_atan2
+	#define nmath_pow	NMath::fast_pow
+#endif /* MATH_FAST_TRANSCENDENTALS */
+
 /* Infinity */
 #ifndef INFINITY
 	#define INFINITY SCALAR_T_MAX
@@ -96,6 +115,13 @@ const scalar_t SCALAR_XSMALL   = 1.e-6;   /* 0.000001 */
 const scalar_t SCALAR_XXSMALL  = 1.e-8;   /* 0.00000001 */
 const scalar_t SCALAR_XXXSMALL = 1.e-12;  /* 0.000000000001 */
 
+/* Largest scalar_t below 1, the upper bound of [0, 1) samples */
+#ifdef MATH_SINGLE_PRECISION
+const scalar_t SCALAR_ONE_MINUS_EPSILON = 0.99999994f;
+#else
+const scalar_t SCALAR_ONE_MINUS_EPSILON = 0.99999999999999989;
+#endif /* MATH_SINGLE_PRECISION */
+
 /* PI */
 const scalar_t PI_DOUBLE	= 6.283185307179586232;
 const scalar_t PI			= 3.14159265358979323846;
@@ -126,4 +152,8 @@ const scalar_t RADIAN = 0.017453292519943;
     #define M_E	NMath::EULER_E
 #endif /* M_E */
 
+#ifdef MATH_FAST_TRANSCENDENTALS
+	#include "fastmath.h"
+#endif /* MATH_FAST_TRANSCENDENTALS */
+
 #endif /* NMATH_PRECISION_H_INCLUDED */
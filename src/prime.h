@@ -29,6 +29,13 @@
 #define NMATH_PRIME_H_INCLUDED
 
 #include "defs.h"
+#include "declspec.h"
+
+#include <stdint.h>
+
+/* The table holds all primes below the limit */
+#define NMATH_PRIME_TABLE_LIMIT 65536
+#define NMATH_PRIME_TABLE_SIZE  6542
 
 namespace NMath {
 
@@ -36,10 +43,54 @@ namespace NMath {
 extern "C" {
 #endif	/* __cplusplus */
 
+/*
+	Numbers below the table limit are looked up, larger ones go through a
+	Miller-Rabin test with a witness set that is exact for every 64-bit
+	value, so the cost is a few dozen modular multiplications regardless
+	of the magnitude.
+*/
 static inline int isPrime(unsigned long i);
 static inline unsigned long getNextPrime(unsigned long i);
 static inline unsigned long getPrevPrime(unsigned long i);
 
+/* Primes below NMATH_PRIME_TABLE_LIMIT in increasing order, a constant array in the library */
+NMATH_DECLSPEC const uint16_t *prime_table(void);
+
+NMATH_DECLSPEC int prime_test(unsigned long i);
+NMATH_DECLSPEC unsigned long prime_next(unsigned long i);
+NMATH_DECLSPEC unsigned long prime_prev(unsigned long i);
+
+/* res[j] = isPrime(n[j]), in parallel when built with OpenMP */
+NMATH_DECLSPEC void prime_test_batch(const unsigned long *n, int *res, unsigned int count);
+
+/*
+	Segmented sieve of Eratosthenes over [lo, hi).
+
+	Only odd numbers are stored, one bit each, so a range of n numbers
+	takes n / 16 bytes. The range is sieved in cache sized segments, in
+	parallel when built with OpenMP. The sieving primes come from the
+	table, or for ranges beyond 2^32 from a sieve of their own.
+*/
+struct prime_sieve_t
+{
+	unsigned long lo, hi;
+	unsigned long first;	/* first odd number of the range, bit 0 */
+	unsigned long bits;		/* odd numbers in the range */
+	uint32_t *set;
+};
+
+typedef struct prime_sieve_t prime_sieve_t;
+
+/* Return 0 on success, -1 if the bitset could not be allocated */
+NMATH_DECLSPEC int prime_sieve_init(prime_sieve_t *s, unsigned long lo, unsigned long hi);
+NMATH_DECLSPEC void prime_sieve_release(prime_sieve_t *s);
+
+static inline int prime_sieve_test(const prime_sieve_t *s, unsigned long i);
+NMATH_DECLSPEC unsigned long prime_sieve_count(const prime_sieve_t *s);
+
+/* Writes up to max primes of the range in increasing order and returns how many were written */
+NMATH_DECLSPEC unsigned long prime_sieve_list(const prime_sieve_t *s, unsigned long *res, unsigned long max);
+
 #ifdef __cplusplus
 }   /* extern "C" */
 #endif
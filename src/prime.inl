@@ -43,47 +43,35 @@ extern "C" {
 
 static inline int isPrime(unsigned long i)
 {
-    if (i <= 1) {
-        return false;
-	} else if (i == 2) {
-        return true;
+    if (i < 4) {
+        return i >= 2;
 	} else if (!(i % 2)) {
-        return false;
+        return 0;
 	}
 
-	long si = sqrt(i);
-
-	for (long j = 2; j <= si; ++j) {
-		if (!(i % j)) {
-			return 0;
-		}
-	}
-
-	return 1;
+	return prime_test(i);
 }
 
 static inline unsigned long getNextPrime(unsigned long i)
 {
-    static const unsigned long limit = getPrevPrime(LONG_MAX);
-
-    if (i >= limit) { // Avoid endless loop traps
-        return limit;
-	}
-
-    while(!isPrime(++i));
-
-	return i;
+	return prime_next(i);
 }
 
 static inline unsigned long getPrevPrime(unsigned long i)
 {
-    if (i <= 2) { // Avoid endless loop traps
-        return 2;
-	}
+	return prime_prev(i);
+}
 
-    while(!isPrime(--i));
+static inline int prime_sieve_test(const prime_sieve_t *s, unsigned long i)
+{
+	if (i == 2) {
+		return s->lo <= 2 && 2 < s->hi;
+	} else if (!(i & 1) || i < s->first || i >= s->hi) {
+		return 0;
+	}
 
-    return i;
+	unsigned long k = (i - s->first) / 2;
+	return (s->set[k / 32] >> (k % 32)) & 1;
 }
 
 #ifdef __cplusplus
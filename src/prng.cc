@@ -0,0 +1,330 @@
+/*
+
+    This file is part of libnmath.
+
+    prng.cc
+    Pseudo-random number generators
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "prng.h"
+#include "simd.h"
+
+namespace NMath {
+
+/*
+	Philox in SIMD lanes
+	Every lane runs the rounds for its own counter, consecutive blocks in
+	consecutive lanes. The 32x32 -> 64 bit products are formed with
+	_mm_mul_epu32, which only multiplies the even lanes, so the odd lanes
+	are shifted down and multiplied separately. Lanes are grouped in 128-bit
+	halves, so the AVX2 code is the SSE2 code twice over.
+*/
+#if defined(NMATH_SIMD_AVX2)
+	#define NMATH_PHILOX_LANES 8
+
+	typedef __m256i philox_lane_t;
+
+	static inline philox_lane_t philox_set1(uint32_t a) { return _mm256_set1_epi32((int)a); }
+	static inline philox_lane_t philox_xor(philox_lane_t a, philox_lane_t b) { return _mm256_xor_si256(a, b); }
+	static inline philox_lane_t philox_add(philox_lane_t a, philox_lane_t b) { return _mm256_add_epi32(a, b); }
+
+	static inline philox_lane_t philox_iota(void)
+	{
+		return _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	}
+
+	static inline void philox_mulhilo(philox_lane_t a, philox_lane_t m, philox_lane_t *hi, philox_lane_t *lo)
+	{
+		philox_lane_t even = _mm256_shuffle_epi32(_mm256_mul_epu32(a, m), _MM_SHUFFLE(3, 1, 2, 0));
+		philox_lane_t odd = _mm256_shuffle_epi32(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), m), _MM_SHUFFLE(3, 1, 2, 0));
+		*lo = _mm256_unpacklo_epi32(even, odd);
+		*hi = _mm256_unpackhi_epi32(even, odd);
+	}
+
+	/* Transposes the lanes back to blocks and stores 8 consecutive blocks */
+	static inline void philox_store(uint32_t *res, philox_lane_t c0, philox_lane_t c1, philox_lane_t c2, philox_lane_t c3)
+	{
+		philox_lane_t t0 = _mm256_unpacklo_epi32(c0, c1);
+		philox_lane_t t1 = _mm256_unpacklo_epi32(c2, c3);
+		philox_lane_t t2 = _mm256_unpackhi_epi32(c0, c1);
+		philox_lane_t t3 = _mm256_unpackhi_epi32(c2, c3);
+
+		philox_lane_t r0 = _mm256_unpacklo_epi64(t0, t1);	/* blocks 0, 4 */
+		philox_lane_t r1 = _mm256_unpackhi_epi64(t0, t1);	/* blocks 1, 5 */
+		philox_lane_t r2 = _mm256_unpacklo_epi64(t2, t3);	/* blocks 2, 6 */
+		philox_lane_t r3 = _mm256_unpackhi_epi64(t2, t3);	/* blocks 3, 7 */
+
+		_mm256_storeu_si256((__m256i *)(res),      _mm256_permute2x128_si256(r0, r1, 0x20));
+		_mm256_storeu_si256((__m256i *)(res + 8),  _mm256_permute2x128_si256(r2, r3, 0x20));
+		_mm256_storeu_si256((__m256i *)(res + 16), _mm256_permute2x128_si256(r0, r1, 0x31));
+		_mm256_storeu_si256((__m256i *)(res + 24), _mm256_permute2x128_si256(r2, r3, 0x31));
+	}
+#elif defined(NMATH_SIMD_SSE2)
+	#define NMATH_PHILOX_LANES 4
+
+	typedef __m128i philox_lane_t;
+
+	static inline philox_lane_t philox_set1(uint32_t a) { return _mm_set1_epi32((int)a); }
+	static inline philox_lane_t philox_xor(philox_lane_t a, philox_lane_t b) { return _mm_xor_si128(a, b); }
+	static inline philox_lane_t philox_add(philox_lane_t a, philox_lane_t b) { return _mm_add_epi32(a, b); }
+
+	static inline philox_lane_t philox_iota(void)
+	{
+		return _mm_setr_epi32(0, 1, 2, 3);
+	}
+
+	static inline void philox_mulhilo(philox_lane_t a, philox_lane_t m, philox_lane_t *hi, philox_lane_t *lo)
+	{
+		philox_lane_t even = _mm_shuffle_epi32(_mm_mul_epu32(a, m), _MM_SHUFFLE(3, 1, 2, 0));
+		philox_lane_t odd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(a, 32), m), _MM_SHUFFLE(3, 1, 2, 0));
+		*lo = _mm_unpacklo_epi32(even, odd);
+		*hi = _mm_unpackhi_epi32(even, odd);
+	}
+
+	/* Transposes the lanes back to blocks and stores 4 consecutive blocks */
+	static inline void philox_store(uint32_t *res, philox_lane_t c0, philox_lane_t c1, philox_lane_t c2, philox_lane_t c3)
+	{
+		philox_lane_t t0 = _mm_unpacklo_epi32(c0, c1);
+		philox_lane_t t1 = _mm_unpacklo_epi32(c2, c3);
+		philox_lane_t t2 = _mm_unpackhi_epi32(c0, c1);
+		philox_lane_t t3 = _mm_unpackhi_epi32(c2, c3);
+
+		_mm_storeu_si128((__m128i *)(res),      _mm_unpacklo_epi64(t0, t1));
+		_mm_storeu_si128((__m128i *)(res + 4),  _mm_unpackhi_epi64(t0, t1));
+		_mm_storeu_si128((__m128i *)(res + 8),  _mm_unpacklo_epi64(t2, t3));
+		_mm_storeu_si128((__m128i *)(res + 12), _mm_unpackhi_epi64(t2, t3));
+	}
+#endif /* NMATH_SIMD_AVX2 */
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline void prng_philox_advance(prng_philox_t *s, uint64_t blocks)
+{
+	uint64_t c = ((uint64_t)s->ctr[1] << 32 | s->ctr[0]) + blocks;
+	s->ctr[0] = (uint32_t)c;
+	s->ctr[1] = (uint32_t)(c >> 32);
+}
+
+/* Writes the next count blocks, 4 outputs each, and advances the counter */
+static void prng_philox_blocks(prng_philox_t *s, uint32_t *res, unsigned int count)
+{
+	unsigned int i = 0;
+
+#ifdef NMATH_PHILOX_LANES
+	while (count - i >= NMATH_PHILOX_LANES) {
+		/* The lanes would carry into ctr[1] */
+		if (s->ctr[0] > 0xFFFFFFFF - (NMATH_PHILOX_LANES - 1)) {
+			prng_philox4x32(res + 4 * i, s->ctr, s->key);
+			prng_philox_advance(s, 1);
+			++i;
+			continue;
+		}
+
+		philox_lane_t c0 = philox_add(philox_set1(s->ctr[0]), philox_iota());
+		philox_lane_t c1 = philox_set1(s->ctr[1]);
+		philox_lane_t c2 = philox_set1(s->ctr[2]);
+		philox_lane_t c3 = philox_set1(s->ctr[3]);
+
+		const philox_lane_t m0 = philox_set1(NMATH_PHILOX_M0);
+		const philox_lane_t m1 = philox_set1(NMATH_PHILOX_M1);
+
+		uint32_t k0 = s->key[0], k1 = s->key[1];
+
+		for (int r=0; r<10; ++r) {
+			philox_lane_t hi0, lo0, hi1, lo1;
+			philox_mulhilo(c0, m0, &hi0, &lo0);
+			philox_mulhilo(c2, m1, &hi1, &lo1);
+
+			c0 = philox_xor(philox_xor(hi1, c1), philox_set1(k0));
+			c1 = lo1;
+			c2 = philox_xor(philox_xor(hi0, c3), philox_set1(k1));
+			c3 = lo0;
+
+			k0 += NMATH_PHILOX_W0;
+			k1 += NMATH_PHILOX_W1;
+		}
+
+		philox_store(res + 4 * i, c0, c1, c2, c3);
+		prng_philox_advance(s, NMATH_PHILOX_LANES);
+		i += NMATH_PHILOX_LANES;
+	}
+#endif /* NMATH_PHILOX_LANES */
+
+	for (; i < count; ++i) {
+		prng_philox4x32(res + 4 * i, s->ctr, s->key);
+		prng_philox_advance(s, 1);
+	}
+}
+
+void prng_philox_jump(prng_philox_t *s, uint64_t n)
+{
+	uint64_t left = 4 - s->idx;
+
+	if (n < left) {
+		s->idx += (unsigned int)n;
+		return;
+	}
+
+	n -= left;
+	prng_philox_advance(s, n / 4);
+	s->idx = 4;
+
+	/* Land inside a block */
+	if (n % 4) {
+		prng_philox4x32(s->buf, s->ctr, s->key);
+		prng_philox_advance(s, 1);
+		s->idx = (unsigned int)(n % 4);
+	}
+}
+
+/*
+	The bulk functions drain the current block, then generate whole blocks
+	straight into the output, or into a small staging buffer for the
+	floating point conversions, and finally buffer the partial block so
+	that single value calls resume from the right position.
+*/
+#define NMATH_PHILOX_CHUNK 64	/* blocks per staging buffer */
+
+void prng_philox_fill_u32(prng_philox_t *s, uint32_t *res, unsigned int count)
+{
+	unsigned int i = 0;
+
+	while (i < count && s->idx < 4) {
+		res[i++] = s->buf[s->idx++];
+	}
+
+	unsigned int blocks = (count - i) / 4;
+	prng_philox_blocks(s, res + i, blocks);
+	i += blocks * 4;
+
+	while (i < count) {
+		res[i++] = prng_philox_u32(s);
+	}
+}
+
+/* a + (b - a) * u, which can round up to b, is clamped to max */
+static void prng_philox_fill_float_range(prng_philox_t *s, float *res, unsigned int count, float a, float scale, float max)
+{
+	unsigned int i = 0;
+	uint32_t tmp[NMATH_PHILOX_CHUNK * 4];
+
+	while (i < count && s->idx < 4) {
+		float r = a + scale * prng_philox_float(s);
+		res[i++] = r > max ? max : r;
+	}
+
+	while (count - i >= 4) {
+		unsigned int blocks = (count - i) / 4;
+
+		if (blocks > NMATH_PHILOX_CHUNK) {
+			blocks = NMATH_PHILOX_CHUNK;
+		}
+
+		prng_philox_blocks(s, tmp, blocks);
+
+		/* The top 24 bits fit in a signed int, which converts in SIMD */
+		for (unsigned int j=0; j<blocks*4; ++j) {
+			float r = a + scale * ((float)(int)(tmp[j] >> 8) * (1.0f / 16777216.0f));
+			res[i + j] = r > max ? max : r;
+		}
+
+		i += blocks * 4;
+	}
+
+	while (i < count) {
+		float r = a + scale * prng_philox_float(s);
+		res[i++] = r > max ? max : r;
+	}
+}
+
+static void prng_philox_fill_double_range(prng_philox_t *s, double *res, unsigned int count, double a, double scale, double max)
+{
+	unsigned int i = 0;
+	uint32_t tmp[NMATH_PHILOX_CHUNK * 4];
+
+	/* Two outputs per value, blocks can only be used from an even position */
+	if (s->idx & 1) {
+		while (i < count) {
+			double r = a + scale * prng_philox_double(s);
+			res[i++] = r > max ? max : r;
+		}
+
+		return;
+	}
+
+	while (i < count && s->idx < 4) {
+		double r = a + scale * prng_philox_double(s);
+		res[i++] = r > max ? max : r;
+	}
+
+	while (count - i >= 2) {
+		unsigned int blocks = (count - i) / 2;
+
+		if (blocks > NMATH_PHILOX_CHUNK) {
+			blocks = NMATH_PHILOX_CHUNK;
+		}
+
+		prng_philox_blocks(s, tmp, blocks);
+
+		for (unsigned int j=0; j<blocks*2; ++j) {
+			double hi = (double)(int)(tmp[2 * j] >> 5);
+			double lo = (double)(int)(tmp[2 * j + 1] >> 6);
+			double r = a + scale * ((hi * 67108864.0 + lo) * (1.0 / 9007199254740992.0));
+			res[i + j] = r > max ? max : r;
+		}
+
+		i += blocks * 2;
+	}
+
+	while (i < count) {
+		double r = a + scale * prng_philox_double(s);
+		res[i++] = r > max ? max : r;
+	}
+}
+
+/* [0, 1) needs no clamp, 1 is never reached */
+void prng_philox_fill_float(prng_philox_t *s, float *res, unsigned int count)
+{
+	prng_philox_fill_float_range(s, res, count, 0, 1, 1);
+}
+
+void prng_philox_fill_double(prng_philox_t *s, double *res, unsigned int count)
+{
+	prng_philox_fill_double_range(s, res, count, 0, 1, 1);
+}
+
+void prng_philox_fill(prng_philox_t *s, scalar_t *res, unsigned int count, scalar_t a, scalar_t b)
+{
+#ifdef MATH_SINGLE_PRECISION
+	prng_philox_fill_float_range(s, res, count, a, b - a, prng_range_max(a, b));
+#else
+	prng_philox_fill_double_range(s, res, count, a, b - a, prng_range_max(a, b));
+#endif /* MATH_SINGLE_PRECISION */
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
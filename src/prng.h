@@ -29,21 +29,75 @@
 #define NMATH_PRNG_H_INCLUDED
 
 #include "defs.h"
+#include "declspec.h"
 #include "vector.h"
 #include "types.h"
 
+#include <stdint.h>
+
 namespace NMath {
 
 #ifdef __cplusplus
 extern "C" {
 #endif	/* __cplusplus */
 
+/*
+	The two generators below keep hidden global state and are not thread
+	safe. Use the counter based generator for anything concurrent or
+	reproducible.
+*/
+
 /* returns a random number between min and max using the C built-in PRNG in uniform manner */
 static inline scalar_t prng_c(scalar_t a, scalar_t b);
 
 /* Multiply with carry method by George Marsaglia */
 static inline scalar_t prng_multiplyWithCarry(scalar_t a, scalar_t b);
 
+/*
+	Philox4x32-10 counter based generator (Salmon et al., "Parallel random
+	numbers: as easy as 1, 2, 3", SC 2011).
+
+	The generator is a keyed bijection of a 128-bit counter, so the n-th
+	output is computed directly from (key, n) with no serial dependency.
+	The state object only tracks a position in that sequence: the seed
+	selects the key and the stream id occupies the upper half of the
+	counter, which gives 2^64 independent streams of 2^66 numbers each.
+	Give every thread, tile or pixel its own stream id and the results are
+	deterministic regardless of scheduling.
+
+	The bulk functions evaluate 4 (SSE2) or 8 (AVX2) blocks at a time in
+	SIMD lanes and produce exactly the same sequence as the scalar code.
+*/
+struct prng_philox_t
+{
+	uint32_t ctr[4];	/* counter of the next block */
+	uint32_t key[2];
+	uint32_t buf[4];	/* current block */
+	unsigned int idx;	/* next unused entry of buf, 4 if empty */
+};
+
+typedef struct prng_philox_t prng_philox_t;
+
+/* Stateless block function, 4 outputs per counter value */
+static inline void prng_philox4x32(uint32_t res[4], const uint32_t ctr[4], const uint32_t key[2]);
+
+static inline void prng_philox_seed(prng_philox_t *s, uint64_t seed, uint64_t stream);
+static inline uint32_t prng_philox_u32(prng_philox_t *s);
+static inline float prng_philox_float(prng_philox_t *s);           /* [0, 1) */
+static inline double prng_philox_double(prng_philox_t *s);         /* [0, 1), 53 bits, consumes 2 outputs */
+static inline scalar_t prng_philox(prng_philox_t *s, scalar_t a, scalar_t b);  /* [a, b) */
+
+/* The largest value of [a, b), the scalar just below b, or a if the range is empty */
+static inline scalar_t prng_range_max(scalar_t a, scalar_t b);
+
+NMATH_DECLSPEC void prng_philox_jump(prng_philox_t *s, uint64_t n);                /* skips n 32-bit outputs */
+
+/* Bulk generation, equivalent to calling the single value functions count times */
+NMATH_DECLSPEC void prng_philox_fill_u32(prng_philox_t *s, uint32_t *res, unsigned int count);
+NMATH_DECLSPEC void prng_philox_fill_float(prng_philox_t *s, float *res, unsigned int count);
+NMATH_DECLSPEC void prng_philox_fill_double(prng_philox_t *s, double *res, unsigned int count);
+NMATH_DECLSPEC void prng_philox_fill(prng_philox_t *s, scalar_t *res, unsigned int count, scalar_t a, scalar_t b);  /* [a, b) */
+
 #ifdef __cplusplus
 }   /* extern "C" */
 #endif
@@ -207,6 +207,115 @@ static inline scalar_t prng_multiplyWithCarry(scalar_t a, scalar_t b)
     return (scalar_t)(((m_z << 16) + m_w ) * (b - a) / 0xFFFFFFFF) + a;
 }
 
+/* Philox4x32-10 */
+#define NMATH_PHILOX_M0 0xD2511F53
+#define NMATH_PHILOX_M1 0xCD9E8D57
+#define NMATH_PHILOX_W0 0x9E3779B9
+#define NMATH_PHILOX_W1 0xBB67AE85
+
+static inline void prng_philox4x32(uint32_t res[4], const uint32_t ctr[4], const uint32_t key[2])
+{
+	uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+	uint32_t k0 = key[0], k1 = key[1];
+
+	for (int i=0; i<10; ++i) {
+		uint64_t p0 = (uint64_t)NMATH_PHILOX_M0 * c0;
+		uint64_t p1 = (uint64_t)NMATH_PHILOX_M1 * c2;
+
+		c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+		c1 = (uint32_t)p1;
+		c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+		c3 = (uint32_t)p0;
+
+		k0 += NMATH_PHILOX_W0;
+		k1 += NMATH_PHILOX_W1;
+	}
+
+	res[0] = c0;
+	res[1] = c1;
+	res[2] = c2;
+	res[3] = c3;
+}
+
+static inline void prng_philox_seed(prng_philox_t *s, uint64_t seed, uint64_t stream)
+{
+	s->key[0] = (uint32_t)seed;
+	s->key[1] = (uint32_t)(seed >> 32);
+	s->ctr[0] = 0;
+	s->ctr[1] = 0;
+	s->ctr[2] = (uint32_t)stream;
+	s->ctr[3] = (uint32_t)(stream >> 32);
+	s->idx = 4;
+}
+
+static inline uint32_t prng_philox_u32(prng_philox_t *s)
+{
+	if (s->idx == 4) {
+		prng_philox4x32(s->buf, s->ctr, s->key);
+		s->idx = 0;
+
+		/* 64-bit increment of the lower half of the counter */
+		if (!++s->ctr[0]) {
+			++s->ctr[1];
+		}
+	}
+
+	return s->buf[s->idx++];
+}
+
+static inline float prng_philox_float(prng_philox_t *s)
+{
+	/* The top 24 bits fill the mantissa exactly, the result never rounds up to 1 */
+	return (float)(prng_philox_u32(s) >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline double prng_philox_double(prng_philox_t *s)
+{
+	uint32_t hi = prng_philox_u32(s) >> 5;
+	uint32_t lo = prng_philox_u32(s) >> 6;
+	return (hi * 67108864.0 + lo) * (1.0 / 9007199254740992.0);
+}
+
+static inline scalar_t prng_range_max(scalar_t a, scalar_t b)
+{
+	if (!(a < b)) {
+		return a;
+	}
+
+	/* The largest normal below 0, denormals may be flushed under -ffast-math */
+	if (b == 0) {
+#ifdef MATH_SINGLE_PRECISION
+		return -FLT_MIN;
+#else
+		return -DBL_MIN;
+#endif /* MATH_SINGLE_PRECISION */
+	}
+
+	/* Finite scalars of one sign are ordered as their bit patterns */
+#ifdef MATH_SINGLE_PRECISION
+	union { float f; int32_t i; } u;
+#else
+	union { double f; int64_t i; } u;
+#endif /* MATH_SINGLE_PRECISION */
+
+	u.f = b;
+	u.i += b > 0 ? -1 : 1;
+	return u.f;
+}
+
+static inline scalar_t prng_philox(prng_philox_t *s, scalar_t a, scalar_t b)
+{
+#ifdef MATH_SINGLE_PRECISION
+	scalar_t r = a + (b - a) * prng_philox_float(s);
+#else
+	scalar_t r = a + (b - a) * prng_philox_double(s);
+#endif /* MATH_SINGLE_PRECISION */
+
+	/* u < 1, but the product and the sum may still round up to b */
+	scalar_t max = prng_range_max(a, b);
+	return r > max ? max : r;
+}
+
 #ifdef __cplusplus
 }   /* extern "C" */
 #endif
@@ -0,0 +1,219 @@
+/*
+
+    This file is part of libnmath.
+
+    quaternion.cc
+    Quaternion
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "quaternion.h"
+
+#ifdef __cplusplus
+    #include <cmath>
+#else
+    #include <math.h>
+#endif  /* __cplusplus */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+void quat_to_mat3x3(mat3x3_t m, quat_t q)
+{
+	scalar_t x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+	scalar_t xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+	scalar_t xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+	scalar_t wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+	m[0][0] = 1 - (yy + zz); m[0][1] = xy - wz;       m[0][2] = xz + wy;
+	m[1][0] = xy + wz;       m[1][1] = 1 - (xx + zz); m[1][2] = yz - wx;
+	m[2][0] = xz - wy;       m[2][1] = yz + wx;       m[2][2] = 1 - (xx + yy);
+}
+
+void quat_to_mat4x4(mat4x4_t m, quat_t q)
+{
+	scalar_t x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+	scalar_t xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+	scalar_t xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+	scalar_t wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+	m[0][0] = 1 - (yy + zz); m[0][1] = xy - wz;       m[0][2] = xz + wy;       m[0][3] = 0;
+	m[1][0] = xy + wz;       m[1][1] = 1 - (xx + zz); m[1][2] = yz - wx;       m[1][3] = 0;
+	m[2][0] = xz - wy;       m[2][1] = yz + wx;       m[2][2] = 1 - (xx + yy); m[2][3] = 0;
+	m[3][0] = 0;             m[3][1] = 0;             m[3][2] = 0;             m[3][3] = 1;
+}
+
+/*
+	Shepperd's method: the largest of the four diagonal combinations is
+	used as the divisor, which keeps the conversion stable for any
+	rotation angle.
+*/
+static quat_t quat_from_rotation(scalar_t m00, scalar_t m01, scalar_t m02,
+								 scalar_t m10, scalar_t m11, scalar_t m12,
+								 scalar_t m20, scalar_t m21, scalar_t m22)
+{
+	quat_t q;
+	scalar_t trace = m00 + m11 + m22;
+
+	if (trace > 0) {
+		scalar_t s = nmath_sqrt(trace + 1) * 2;
+		scalar_t rs = 1.0 / s;
+		q.w = 0.25 * s;
+		q.x = (m21 - m12) * rs;
+		q.y = (m02 - m20) * rs;
+		q.z = (m10 - m01) * rs;
+	}
+	else if (m00 > m11 && m00 > m22) {
+		scalar_t s = nmath_sqrt(1 + m00 - m11 - m22) * 2;
+		scalar_t rs = 1.0 / s;
+		q.w = (m21 - m12) * rs;
+		q.x = 0.25 * s;
+		q.y = (m01 + m10) * rs;
+		q.z = (m02 + m20) * rs;
+	}
+	else if (m11 > m22) {
+		scalar_t s = nmath_sqrt(1 + m11 - m00 - m22) * 2;
+		scalar_t rs = 1.0 / s;
+		q.w = (m02 - m20) * rs;
+		q.x = (m01 + m10) * rs;
+		q.y = 0.25 * s;
+		q.z = (m12 + m21) * rs;
+	}
+	else {
+		scalar_t s = nmath_sqrt(1 + m22 - m00 - m11) * 2;
+		scalar_t rs = 1.0 / s;
+		q.w = (m10 - m01) * rs;
+		q.x = (m02 + m20) * rs;
+		q.y = (m12 + m21) * rs;
+		q.z = 0.25 * s;
+	}
+
+	return q;
+}
+
+quat_t quat_from_mat3x3(const mat3x3_t m)
+{
+	return quat_from_rotation(m[0][0], m[0][1], m[0][2],
+							  m[1][0], m[1][1], m[1][2],
+							  m[2][0], m[2][1], m[2][2]);
+}
+
+quat_t quat_from_mat4x4(const mat4x4_t m)
+{
+	return quat_from_rotation(m[0][0], m[0][1], m[0][2],
+							  m[1][0], m[1][1], m[1][2],
+							  m[2][0], m[2][1], m[2][2]);
+}
+
+/*
+	Batch operations
+	The loops carry no dependencies between iterations and the inline
+	kernels expand in place, so the compiler is free to vectorize them.
+*/
+
+void quat_mul_batch(quat_t *res, const quat_t *q1, const quat_t *q2, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		res[i] = quat_mul(q1[i], q2[i]);
+	}
+}
+
+void quat_normalize_batch(quat_t *q, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		q[i] = quat_normalize(q[i]);
+	}
+}
+
+void quat_rotate_batch(vec3_t *res, const quat_t *q, const vec3_t *v, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		res[i] = quat_rotate(q[i], v[i]);
+	}
+}
+
+void quat_nlerp_batch(quat_t *res, const quat_t *q1, const quat_t *q2, scalar_t t, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		res[i] = quat_nlerp(q1[i], q2[i], t);
+	}
+}
+
+void quat_slerp_batch(quat_t *res, const quat_t *q1, const quat_t *q2, scalar_t t, unsigned int count)
+{
+	for (unsigned int i=0; i<count; ++i) {
+		res[i] = quat_slerp(q1[i], q2[i], t);
+	}
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+const Quaternion Quaternion::identity(0, 0, 0, 1);
+
+Quaternion::Quaternion(const Matrix3x3f &m)
+{
+	quat_t q = quat_from_rotation(m[0][0], m[0][1], m[0][2],
+								  m[1][0], m[1][1], m[1][2],
+								  m[2][0], m[2][1], m[2][2]);
+	x = q.x;
+	y = q.y;
+	z = q.z;
+	w = q.w;
+}
+
+Quaternion::Quaternion(const Matrix4x4f &m)
+{
+	quat_t q = quat_from_rotation(m[0][0], m[0][1], m[0][2],
+								  m[1][0], m[1][1], m[1][2],
+								  m[2][0], m[2][1], m[2][2]);
+	x = q.x;
+	y = q.y;
+	z = q.z;
+	w = q.w;
+}
+
+Matrix3x3f Quaternion::to_matrix3x3() const
+{
+	mat3x3_t m;
+	quat_to_mat3x3(m, quat_pack(x, y, z, w));
+	return Matrix3x3f(m);
+}
+
+Matrix4x4f Quaternion::to_matrix4x4() const
+{
+	mat4x4_t m;
+	quat_to_mat4x4(m, quat_pack(x, y, z, w));
+	return Matrix4x4f(m);
+}
+
+std::ostream& operator <<(std::ostream& out, const Quaternion &q)
+{
+	out << "[ " << q.x << ", " << q.y << ", " << q.z << ", " << q.w << " ]";
+	return out;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
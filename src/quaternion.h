@@ -0,0 +1,151 @@
+/*
+
+    This file is part of libnmath.
+
+    quaternion.h
+    Quaternion
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_QUATERNION_H_INCLUDED
+#define NMATH_QUATERNION_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "matrix.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	Unit quaternions represent rotations as q = (sin(a/2) * axis, cos(a/2)).
+	The conversions follow the matrix convention of this library, i.e.
+	column vectors transformed as M * v.
+*/
+static inline quat_t quat_pack(scalar_t x, scalar_t y, scalar_t z, scalar_t w);
+static inline quat_t quat_identity(void);
+static inline quat_t quat_from_axis_angle(vec3_t axis, scalar_t angle);  /* axis must be normalized */
+
+static inline quat_t quat_add(quat_t q1, quat_t q2);
+static inline quat_t quat_sub(quat_t q1, quat_t q2);
+static inline quat_t quat_scale(quat_t q, scalar_t s);
+static inline quat_t quat_mul(quat_t q1, quat_t q2);                     /* rotation q2 followed by q1 */
+
+static inline scalar_t quat_dot(quat_t q1, quat_t q2);
+static inline scalar_t quat_length(quat_t q);
+static inline scalar_t quat_length_sq(quat_t q);
+static inline quat_t quat_normalize(quat_t q);
+static inline quat_t quat_conjugate(quat_t q);
+static inline quat_t quat_inverse(quat_t q);
+
+static inline vec3_t quat_rotate(quat_t q, vec3_t v);                    /* q must be normalized */
+
+static inline quat_t quat_nlerp(quat_t q1, quat_t q2, scalar_t t);
+static inline quat_t quat_slerp(quat_t q1, quat_t q2, scalar_t t);
+
+NMATH_DECLSPEC void quat_to_mat3x3(mat3x3_t m, quat_t q);
+NMATH_DECLSPEC void quat_to_mat4x4(mat4x4_t m, quat_t q);
+NMATH_DECLSPEC quat_t quat_from_mat3x3(const mat3x3_t m);               /* m must be a pure rotation */
+NMATH_DECLSPEC quat_t quat_from_mat4x4(const mat4x4_t m);               /* uses the upper 3x3 part */
+
+/* Batch operations over arrays of joints */
+NMATH_DECLSPEC void quat_mul_batch(quat_t *res, const quat_t *q1, const quat_t *q2, unsigned int count);
+NMATH_DECLSPEC void quat_normalize_batch(quat_t *q, unsigned int count);
+NMATH_DECLSPEC void quat_rotate_batch(vec3_t *res, const quat_t *q, const vec3_t *v, unsigned int count);
+NMATH_DECLSPEC void quat_nlerp_batch(quat_t *res, const quat_t *q1, const quat_t *q2, scalar_t t, unsigned int count);
+NMATH_DECLSPEC void quat_slerp_batch(quat_t *res, const quat_t *q1, const quat_t *q2, scalar_t t, unsigned int count);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+class NMATH_DECLSPEC Quaternion
+{
+	public:
+		/* Constructors */
+		inline Quaternion(scalar_t aX = 0.0, scalar_t aY = 0.0, scalar_t aZ = 0.0, scalar_t aW = 1.0);
+		inline Quaternion(const Vector3f &axis, scalar_t angle);	/* axis must be normalized */
+		Quaternion(const Matrix3x3f &m);
+		Quaternion(const Matrix4x4f &m);
+
+		/* Array subscript */
+		inline scalar_t& operator [](unsigned int index);
+		inline const scalar_t& operator [](unsigned int index) const;
+
+		/* Unary operator */
+		friend inline const Quaternion operator -(const Quaternion &q);
+
+		/* Arithmetic operators */
+		friend inline const Quaternion operator +(const Quaternion &q1, const Quaternion &q2);
+		friend inline const Quaternion operator -(const Quaternion &q1, const Quaternion &q2);
+		friend inline const Quaternion operator *(const Quaternion &q1, const Quaternion &q2);
+		friend inline const Quaternion operator *(const Quaternion &q, scalar_t r);
+		friend inline const Quaternion operator *(scalar_t r, const Quaternion &q);
+
+		/* Vector rotation */
+		friend inline const Vector3f operator *(const Quaternion &q, const Vector3f &v);
+
+		/* Compound assignment operators */
+		friend inline Quaternion &operator +=(Quaternion &q1, const Quaternion &q2);
+		friend inline Quaternion &operator -=(Quaternion &q1, const Quaternion &q2);
+		friend inline Quaternion &operator *=(Quaternion &q1, const Quaternion &q2);
+		friend inline Quaternion &operator *=(Quaternion &q, scalar_t r);
+
+		/* Stream operations */
+		friend std::ostream& operator <<(std::ostream& out, const Quaternion &q);
+
+		/* - Length */
+		inline scalar_t length() const;
+		inline scalar_t length_squared() const;
+		/* - Normalization */
+		inline void normalize();
+		inline Quaternion normalized() const;
+		/* - Conjugation / Inversion */
+		inline void conjugate();
+		inline Quaternion conjugated() const;
+		inline Quaternion inverse() const;
+
+		/* Rotation */
+		inline Vector3f rotate(const Vector3f &v) const;		/* the quaternion must be normalized */
+
+		/* Conversion */
+		Matrix3x3f to_matrix3x3() const;
+		Matrix4x4f to_matrix4x4() const;
+
+		static const Quaternion identity;
+
+		scalar_t x, y, z, w;
+};
+
+NMATH_DECLSPEC inline scalar_t dot(const Quaternion &q1, const Quaternion &q2);
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "quaternion.inl"
+
+#endif /* NMATH_QUATERNION_H_INCLUDED */
@@ -0,0 +1,371 @@
+/*
+
+    This file is part of libnmath.
+
+    quaternion.inl
+    Quaternion inline functions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_QUATERNION_INL_INCLUDED
+#define NMATH_QUATERNION_INL_INCLUDED
+
+#ifndef NMATH_QUATERNION_H_INCLUDED
+    #error "quaternion.h must be included before quaternion.inl"
+#endif /* NMATH_QUATERNION_H_INCLUDED */
+
+#include "precision.h"
+#include "types.h"
+
+#ifdef __cplusplus
+    #include <cmath>
+#else
+    #include <math.h>
+#endif  /* __cplusplus */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/* Below this angle (cos ~ 0.9995) slerp falls back to nlerp */
+#define NMATH_QUAT_SLERP_THRESHOLD 0.9995
+
+static inline quat_t quat_pack(scalar_t x, scalar_t y, scalar_t z, scalar_t w)
+{
+	quat_t q;
+	q.x = x;
+	q.y = y;
+	q.z = z;
+	q.w = w;
+	return q;
+}
+
+static inline quat_t quat_identity(void)
+{
+	return quat_pack(0, 0, 0, 1);
+}
+
+static inline quat_t quat_from_axis_angle(vec3_t axis, scalar_t angle)
+{
+	scalar_t s = nmath_sin(angle * 0.5);
+	return quat_pack(axis.x * s, axis.y * s, axis.z * s, nmath_cos(angle * 0.5));
+}
+
+static inline quat_t quat_add(quat_t q1, quat_t q2)
+{
+	q1.x += q2.x;
+	q1.y += q2.y;
+	q1.z += q2.z;
+	q1.w += q2.w;
+	return q1;
+}
+
+static inline quat_t quat_sub(quat_t q1, quat_t q2)
+{
+	q1.x -= q2.x;
+	q1.y -= q2.y;
+	q1.z -= q2.z;
+	q1.w -= q2.w;
+	return q1;
+}
+
+static inline quat_t quat_scale(quat_t q, scalar_t s)
+{
+	q.x *= s;
+	q.y *= s;
+	q.z *= s;
+	q.w *= s;
+	return q;
+}
+
+static inline quat_t quat_mul(quat_t q1, quat_t q2)
+{
+	return quat_pack(q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+					 q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+					 q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+					 q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z);
+}
+
+static inline scalar_t quat_dot(quat_t q1, quat_t q2)
+{
+	return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+static inline scalar_t quat_length(quat_t q)
+{
+	return nmath_sqrt(quat_dot(q, q));
+}
+
+static inline scalar_t quat_length_sq(quat_t q)
+{
+	return quat_dot(q, q);
+}
+
+static inline quat_t quat_normalize(quat_t q)
+{
+	scalar_t len = quat_length(q);
+
+	if (!len) {
+		return q;
+	}
+
+	return quat_scale(q, 1.0 / len);
+}
+
+static inline quat_t quat_conjugate(quat_t q)
+{
+	return quat_pack(-q.x, -q.y, -q.z, q.w);
+}
+
+static inline quat_t quat_inverse(quat_t q)
+{
+	scalar_t len_sq = quat_dot(q, q);
+
+	if (!len_sq) {
+		return q;
+	}
+
+	return quat_scale(quat_conjugate(q), 1.0 / len_sq);
+}
+
+static inline vec3_t quat_rotate(quat_t q, vec3_t v)
+{
+	/*
+		v' = v + w * t + cross(q.xyz, t), where t = 2 * cross(q.xyz, v)
+		This takes 15 multiplications against 27 for the sandwich product
+		q * v * q^-1 and 9 (plus the conversion) for a rotation matrix.
+	*/
+	scalar_t tx = q.y * v.z - q.z * v.y;
+	scalar_t ty = q.z * v.x - q.x * v.z;
+	scalar_t tz = q.x * v.y - q.y * v.x;
+
+	tx += tx;
+	ty += ty;
+	tz += tz;
+
+	return vec3_pack(v.x + q.w * tx + (q.y * tz - q.z * ty),
+					 v.y + q.w * ty + (q.z * tx - q.x * tz),
+					 v.z + q.w * tz + (q.x * ty - q.y * tx));
+}
+
+static inline quat_t quat_nlerp(quat_t q1, quat_t q2, scalar_t t)
+{
+	/* Take the shortest arc */
+	if (quat_dot(q1, q2) < 0) {
+		q2 = quat_scale(q2, -1);
+	}
+
+	return quat_normalize(quat_add(q1, quat_scale(quat_sub(q2, q1), t)));
+}
+
+static inline quat_t quat_slerp(quat_t q1, quat_t q2, scalar_t t)
+{
+	scalar_t cos_omega = quat_dot(q1, q2);
+
+	/* Take the shortest arc */
+	if (cos_omega < 0) {
+		q2 = quat_scale(q2, -1);
+		cos_omega = -cos_omega;
+	}
+
+	/* The arc is too short for sin(omega) to be a safe divisor */
+	if (cos_omega > NMATH_QUAT_SLERP_THRESHOLD) {
+		return quat_normalize(quat_add(q1, quat_scale(quat_sub(q2, q1), t)));
+	}
+
+	scalar_t omega = nmath_acos(cos_omega);
+	scalar_t rsin_omega = 1.0 / nmath_sin(omega);
+
+	scalar_t s1 = nmath_sin((1 - t) * omega) * rsin_omega;
+	scalar_t s2 = nmath_sin(t * omega) * rsin_omega;
+
+	return quat_add(quat_scale(q1, s1), quat_scale(q2, s2));
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/* Quaternion functions */
+inline Quaternion::Quaternion(scalar_t aX, scalar_t aY, scalar_t aZ, scalar_t aW)
+	: x(aX), y(aY), z(aZ), w(aW)
+{}
+
+inline Quaternion::Quaternion(const Vector3f &axis, scalar_t angle)
+{
+	scalar_t s = nmath_sin(angle * 0.5);
+	x = axis.x * s;
+	y = axis.y * s;
+	z = axis.z * s;
+	w = nmath_cos(angle * 0.5);
+}
+
+inline scalar_t& Quaternion::operator [](unsigned int index)
+{
+	return index ? (index == 1 ? y : (index == 2 ? z : w)) : x;
+}
+
+inline const scalar_t& Quaternion::operator [](unsigned int index) const
+{
+	return index ? (index == 1 ? y : (index == 2 ? z : w)) : x;
+}
+
+inline const Quaternion operator -(const Quaternion &q)
+{
+	return Quaternion(-q.x, -q.y, -q.z, -q.w);
+}
+
+inline const Quaternion operator +(const Quaternion &q1, const Quaternion &q2)
+{
+	return Quaternion(q1.x + q2.x, q1.y + q2.y, q1.z + q2.z, q1.w + q2.w);
+}
+
+inline const Quaternion operator -(const Quaternion &q1, const Quaternion &q2)
+{
+	return Quaternion(q1.x - q2.x, q1.y - q2.y, q1.z - q2.z, q1.w - q2.w);
+}
+
+inline const Quaternion operator *(const Quaternion &q1, const Quaternion &q2)
+{
+	return Quaternion(q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+					  q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+					  q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+					  q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z);
+}
+
+inline const Quaternion operator *(const Quaternion &q, scalar_t r)
+{
+	return Quaternion(q.x * r, q.y * r, q.z * r, q.w * r);
+}
+
+inline const Quaternion operator *(scalar_t r, const Quaternion &q)
+{
+	return Quaternion(q.x * r, q.y * r, q.z * r, q.w * r);
+}
+
+inline const Vector3f operator *(const Quaternion &q, const Vector3f &v)
+{
+	return q.rotate(v);
+}
+
+inline Quaternion &operator +=(Quaternion &q1, const Quaternion &q2)
+{
+	q1.x += q2.x;
+	q1.y += q2.y;
+	q1.z += q2.z;
+	q1.w += q2.w;
+	return q1;
+}
+
+inline Quaternion &operator -=(Quaternion &q1, const Quaternion &q2)
+{
+	q1.x -= q2.x;
+	q1.y -= q2.y;
+	q1.z -= q2.z;
+	q1.w -= q2.w;
+	return q1;
+}
+
+inline Quaternion &operator *=(Quaternion &q1, const Quaternion &q2)
+{
+	return q1 = q1 * q2;
+}
+
+inline Quaternion &operator *=(Quaternion &q, scalar_t r)
+{
+	q.x *= r;
+	q.y *= r;
+	q.z *= r;
+	q.w *= r;
+	return q;
+}
+
+inline scalar_t Quaternion::length() const
+{
+	return nmath_sqrt(x*x + y*y + z*z + w*w);
+}
+
+inline scalar_t Quaternion::length_squared() const
+{
+	return x*x + y*y + z*z + w*w;
+}
+
+inline void Quaternion::normalize()
+{
+	scalar_t len = length();
+
+	if (!len)
+		return;
+
+	*this *= 1.0 / len;
+}
+
+inline Quaternion Quaternion::normalized() const
+{
+	scalar_t len = length();
+	return (len != 0) ? *this * (1.0 / len) : *this;
+}
+
+inline void Quaternion::conjugate()
+{
+	x = -x;
+	y = -y;
+	z = -z;
+}
+
+inline Quaternion Quaternion::conjugated() const
+{
+	return Quaternion(-x, -y, -z, w);
+}
+
+inline Quaternion Quaternion::inverse() const
+{
+	scalar_t len_sq = length_squared();
+	return (len_sq != 0) ? conjugated() * (1.0 / len_sq) : *this;
+}
+
+inline Vector3f Quaternion::rotate(const Vector3f &v) const
+{
+	/* See quat_rotate */
+	scalar_t tx = y * v.z - z * v.y;
+	scalar_t ty = z * v.x - x * v.z;
+	scalar_t tz = x * v.y - y * v.x;
+
+	tx += tx;
+	ty += ty;
+	tz += tz;
+
+	return Vector3f(v.x + w * tx + (y * tz - z * ty),
+					v.y + w * ty + (z * tx - x * tz),
+					v.z + w * tz + (x * ty - y * tx));
+}
+
+inline scalar_t dot(const Quaternion &q1, const Quaternion &q2)
+{
+	return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_QUATERNION_INL_INCLUDED */
@@ -40,6 +40,40 @@ inline Vector3f sphere();
 inline Vector3f hemisphere(const Vector3f &normal, const Vector3f &direction);
 inline Vector3f lobe(const Vector3f &normal, const Vector3f &direction, const scalar_t exponent);
 
+/*
+	Deterministic sampling
+
+	The functions below map a pair of uniform numbers in [0, 1), taken
+	from any generator or low discrepancy sequence, to the domain. The
+	local frame has y along the normal, as above. The basis around the
+	normal is computed once and reused for every sample.
+*/
+struct Basis
+{
+	Vector3f tangent, normal, bitangent;
+};
+
+/* Branchless basis around a normalized vector (Duff et al., JCGT 2017) */
+inline Basis basis(const Vector3f &normal);
+inline Vector3f to_world(const Basis &b, const Vector3f &local);
+
+inline Vector2f disk_concentric(scalar_t u, scalar_t v);        /* Shirley-Chiu, unit disk */
+inline Vector3f sphere(scalar_t u, scalar_t v);
+inline Vector3f hemisphere_uniform(scalar_t u, scalar_t v);
+inline Vector3f hemisphere_cosine(scalar_t u, scalar_t v);      /* projected concentric disk */
+inline Vector3f lobe(scalar_t u, scalar_t v, scalar_t exponent); /* cos^exponent around y */
+
+inline Vector3f hemisphere_uniform(scalar_t u, scalar_t v, const Basis &b);
+inline Vector3f hemisphere_cosine(scalar_t u, scalar_t v, const Basis &b);
+inline Vector3f lobe(scalar_t u, scalar_t v, scalar_t exponent, const Basis &b);
+
+/* Batch versions, res[i] is the sample for uv[i] */
+inline void disk_concentric(Vector2f *res, const Vector2f *uv, unsigned int count);
+inline void sphere(Vector3f *res, const Vector2f *uv, unsigned int count);
+inline void hemisphere_uniform(Vector3f *res, const Vector2f *uv, unsigned int count, const Basis &b);
+inline void hemisphere_cosine(Vector3f *res, const Vector2f *uv, unsigned int count, const Basis &b);
+inline void lobe(Vector3f *res, const Vector2f *uv, unsigned int count, scalar_t exponent, const Basis &b);
+
 #endif /* __cplusplus */
 
 	} /* namespace Sample */
@@ -50,12 +50,7 @@ inline Vector3f sphere()
 	scalar_t u = prng_c(0.0f, 1.0f);
 	scalar_t v = prng_c(0.0f, 1.0f);
 
-	scalar_t theta = 2.0 * PI * u;
-	scalar_t phi = nmath_acos(2.0f * v - 1.0f);
-
-	return Vector3f(nmath_cos(theta) * nmath_sin(phi),
-					nmath_cos(phi),
-					nmath_sin(theta) * nmath_sin(phi));
+	return sphere(u, v);
 }
 
 inline Vector3f hemisphere(const Vector3f &normal, const Vector3f &direction)
@@ -124,6 +119,144 @@ inline Vector3f lobe(const Vector3f &normal, const Vector3f &direction, const sc
 	return (vc * nmath_pow(vdotr, exponent)).normalized();
 }
 
+inline Basis basis(const Vector3f &normal)
+{
+	/* The sign select replaces the branch of Frisvad's original construction */
+	scalar_t sign = normal.z >= 0 ? 1 : -1;
+	scalar_t a = -1 / (sign + normal.z);
+	scalar_t b = normal.x * normal.y * a;
+
+	Basis res;
+	res.tangent = Vector3f(1 + sign * normal.x * normal.x * a, sign * b, -sign * normal.x);
+	res.normal = normal;
+	res.bitangent = Vector3f(b, sign + normal.y * normal.y * a, -normal.y);
+	return res;
+}
+
+inline Vector3f to_world(const Basis &b, const Vector3f &local)
+{
+	return Vector3f(b.tangent.x * local.x + b.normal.x * local.y + b.bitangent.x * local.z,
+					b.tangent.y * local.x + b.normal.y * local.y + b.bitangent.y * local.z,
+					b.tangent.z * local.x + b.normal.z * local.y + b.bitangent.z * local.z);
+}
+
+inline Vector2f disk_concentric(scalar_t u, scalar_t v)
+{
+	/* Maps concentric squares to concentric circles, preserving stratification */
+	scalar_t a = 2 * u - 1;
+	scalar_t b = 2 * v - 1;
+
+	if (a == 0 && b == 0) {
+		return Vector2f(0, 0);
+	}
+
+	scalar_t r, phi;
+
+	if (a * a > b * b) {
+		r = a;
+		phi = PI_QUARTER * (b / a);
+	}
+	else {
+		r = b;
+		phi = PI_HALF - PI_QUARTER * (a / b);
+	}
+
+	return Vector2f(r * nmath_cos(phi), r * nmath_sin(phi));
+}
+
+inline Vector3f sphere(scalar_t u, scalar_t v)
+{
+	scalar_t theta = PI_DOUBLE * u;
+	scalar_t y = 2 * v - 1;
+	scalar_t r = nmath_sqrt(1 - y * y > 0 ? 1 - y * y : 0);
+
+	return Vector3f(nmath_cos(theta) * r, y, nmath_sin(theta) * r);
+}
+
+inline Vector3f hemisphere_uniform(scalar_t u, scalar_t v)
+{
+	scalar_t theta = PI_DOUBLE * u;
+	scalar_t y = v;
+	scalar_t r = nmath_sqrt(1 - y * y > 0 ? 1 - y * y : 0);
+
+	return Vector3f(nmath_cos(theta) * r, y, nmath_sin(theta) * r);
+}
+
+inline Vector3f hemisphere_cosine(scalar_t u, scalar_t v)
+{
+	/* Malley's method, the disk projected up onto the hemisphere */
+	Vector2f d = disk_concentric(u, v);
+	scalar_t y2 = 1 - d.x * d.x - d.y * d.y;
+
+	return Vector3f(d.x, nmath_sqrt(y2 > 0 ? y2 : 0), d.y);
+}
+
+inline Vector3f lobe(scalar_t u, scalar_t v, scalar_t exponent)
+{
+	scalar_t theta = PI_DOUBLE * u;
+	scalar_t y = nmath_pow(v, 1 / (exponent + 1));
+	scalar_t r = nmath_sqrt(1 - y * y > 0 ? 1 - y * y : 0);
+
+	return Vector3f(nmath_cos(theta) * r, y, nmath_sin(theta) * r);
+}
+
+inline Vector3f hemisphere_uniform(scalar_t u, scalar_t v, const Basis &b)
+{
+	return to_world(b, hemisphere_uniform(u, v));
+}
+
+inline Vector3f hemisphere_cosine(scalar_t u, scalar_t v, const Basis &b)
+{
+	return to_world(b, hemisphere_cosine(u, v));
+}
+
+inline Vector3f lobe(scalar_t u, scalar_t v, scalar_t exponent, const Basis &b)
+{
+	return to_world(b, lobe(u, v, exponent));
+}
+
+inline void disk_concentric(Vector2f *res, const Vector2f *uv, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		res[i] = disk_concentric(uv[i].x, uv[i].y);
+	}
+}
+
+inline void sphere(Vector3f *res, const Vector2f *uv, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		res[i] = sphere(uv[i].x, uv[i].y);
+	}
+}
+
+inline void hemisphere_uniform(Vector3f *res, const Vector2f *uv, unsigned int count, const Basis &b)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		res[i] = to_world(b, hemisphere_uniform(uv[i].x, uv[i].y));
+	}
+}
+
+inline void hemisphere_cosine(Vector3f *res, const Vector2f *uv, unsigned int count, const Basis &b)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		res[i] = to_world(b, hemisphere_cosine(uv[i].x, uv[i].y));
+	}
+}
+
+inline void lobe(Vector3f *res, const Vector2f *uv, unsigned int count, scalar_t exponent, const Basis &b)
+{
+	/* The exponent is loop invariant */
+	const scalar_t inv = 1 / (exponent + 1);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		scalar_t theta = PI_DOUBLE * uv[i].x;
+		scalar_t y = nmath_pow(uv[i].y, inv);
+		scalar_t r = nmath_sqrt(1 - y * y > 0 ? 1 - y * y : 0);
+
+		res[i] = to_world(b, Vector3f(nmath_cos(theta) * r, y, nmath_sin(theta) * r));
+	}
+}
+
 #endif /* __cplusplus */
 
 	} /* namespace Sample */
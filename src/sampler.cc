@@ -0,0 +1,295 @@
+/*
+
+    This file is part of libnmath.
+
+    sampler.cc
+    Low discrepancy and stratified samplers
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "sampler.h"
+#include "prime.h"
+
+namespace NMath {
+
+/*
+	Sobol direction numbers, column i of the generator matrix of every
+	dimension, expanded to 32 bits from the primitive polynomials and
+	initial values of Joe and Kuo (new-joe-kuo-6). The first dimension is
+	the van der Corput sequence.
+*/
+static const uint32_t sobol_matrix[NMATH_SOBOL_DIMENSIONS][32] = {
+	{
+		0x80000000, 0x40000000, 0x20000000, 0x10000000, 0x08000000, 0x04000000, 0x02000000, 0x01000000,
+		0x00800000, 0x00400000, 0x00200000, 0x00100000, 0x00080000, 0x00040000, 0x00020000, 0x00010000,
+		0x00008000, 0x00004000, 0x00002000, 0x00001000, 0x00000800, 0x00000400, 0x00000200, 0x00000100,
+		0x00000080, 0x00000040, 0x00000020, 0x00000010, 0x00000008, 0x00000004, 0x00000002, 0x00000001
+	},
+	{
+		0x80000000, 0xC0000000, 0xA0000000, 0xF0000000, 0x88000000, 0xCC000000, 0xAA000000, 0xFF000000,
+		0x80800000, 0xC0C00000, 0xA0A00000, 0xF0F00000, 0x88880000, 0xCCCC0000, 0xAAAA0000, 0xFFFF0000,
+		0x80008000, 0xC000C000, 0xA000A000, 0xF000F000, 0x88008800, 0xCC00CC00, 0xAA00AA00, 0xFF00FF00,
+		0x80808080, 0xC0C0C0C0, 0xA0A0A0A0, 0xF0F0F0F0, 0x88888888, 0xCCCCCCCC, 0xAAAAAAAA, 0xFFFFFFFF
+	},
+	{
+		0x80000000, 0xC0000000, 0x60000000, 0x90000000, 0xE8000000, 0x5C000000, 0x8E000000, 0xC5000000,
+		0x68800000, 0x9CC00000, 0xEE600000, 0x55900000, 0x80680000, 0xC09C0000, 0x60EE0000, 0x90550000,
+		0xE8808000, 0x5CC0C000, 0x8E606000, 0xC5909000, 0x6868E800, 0x9C9C5C00, 0xEEEE8E00, 0x5555C500,
+		0x8000E880, 0xC0005CC0, 0x60008E60, 0x9000C590, 0xE8006868, 0x5C009C9C, 0x8E00EEEE, 0xC5005555
+	},
+	{
+		0x80000000, 0xC0000000, 0x20000000, 0x50000000, 0xF8000000, 0x74000000, 0xA2000000, 0x93000000,
+		0xD8800000, 0x25400000, 0x59E00000, 0xE6D00000, 0x78080000, 0xB40C0000, 0x82020000, 0xC3050000,
+		0x208F8000, 0x51474000, 0xFBEA2000, 0x75D93000, 0xA0858800, 0x914E5400, 0xDBE79E00, 0x25DB6D00,
+		0x58800080, 0xE54000C0, 0x79E00020, 0xB6D00050, 0x800800F8, 0xC00C0074, 0x200200A2, 0x50050093
+	},
+	{
+		0x80000000, 0x40000000, 0x20000000, 0xB0000000, 0xF8000000, 0xDC000000, 0x7A000000, 0x9D000000,
+		0x5A800000, 0x2FC00000, 0xA1600000, 0xF0B00000, 0xDA880000, 0x6FC40000, 0x81620000, 0x40BB0000,
+		0x22878000, 0xB3C9C000, 0xFB65A000, 0xDDB2D000, 0x78022800, 0x9C0B3C00, 0x5A0FB600, 0x2D0DDB00,
+		0xA2878080, 0xF3C9C040, 0xDB65A020, 0x6DB2D0B0, 0x800228F8, 0x400B3CDC, 0x200FB67A, 0xB00DDB9D
+	},
+	{
+		0x80000000, 0x40000000, 0x60000000, 0x30000000, 0xC8000000, 0x24000000, 0x56000000, 0xFB000000,
+		0xE0800000, 0x70400000, 0xA8600000, 0x14300000, 0x9EC80000, 0xDF240000, 0xB6D60000, 0x8BBB0000,
+		0x48008000, 0x64004000, 0x36006000, 0xCB003000, 0x2880C800, 0x54402400, 0xFE605600, 0xEF30FB00,
+		0x7E48E080, 0xAF647040, 0x1EB6A860, 0x9F8B1430, 0xD6C81EC8, 0xBB249F24, 0x80D6D6D6, 0x40BBBBBB
+	},
+	{
+		0x80000000, 0xC0000000, 0xA0000000, 0xD0000000, 0x58000000, 0x94000000, 0x3E000000, 0xE3000000,
+		0xBE800000, 0x23C00000, 0x1E200000, 0xF3100000, 0x46780000, 0x67840000, 0x78460000, 0x84670000,
+		0xC6788000, 0xA784C000, 0xD846A000, 0x5467D000, 0x9E78D800, 0x33845400, 0xE6469E00, 0xB7673300,
+		0x20F86680, 0x104477C0, 0xF8668020, 0x4477C010, 0x668020F8, 0x77C01044, 0x8020F866, 0xC0104477
+	},
+	{
+		0x80000000, 0x40000000, 0xA0000000, 0x50000000, 0x88000000, 0x24000000, 0x12000000, 0x2D000000,
+		0x76800000, 0x9E400000, 0x08200000, 0x64100000, 0xB2280000, 0x7D140000, 0xFEA20000, 0xBA490000,
+		0x1A248000, 0x491B4000, 0xC4B5A000, 0xE3739000, 0xF6800800, 0xDE400400, 0xA8200A00, 0x34100500,
+		0x3A280880, 0x59140240, 0xECA20120, 0x974902D0, 0x6CA48768, 0xD75B49E4, 0xCC95A082, 0x87639641
+	},
+	{
+		0x80000000, 0x40000000, 0xA0000000, 0x50000000, 0x28000000, 0xD4000000, 0x6A000000, 0x71000000,
+		0x38800000, 0x58400000, 0xEA200000, 0x31100000, 0x98A80000, 0x08540000, 0xC22A0000, 0xE5250000,
+		0xF2B28000, 0x79484000, 0xFAA42000, 0xBD731000, 0x18A80800, 0x48540400, 0x622A0A00, 0xB5250500,
+		0xDAB28280, 0xAD484D40, 0x90A426A0, 0xCC731710, 0x20280B88, 0x10140184, 0x880A04A2, 0x84350611
+	},
+	{
+		0x80000000, 0x40000000, 0xE0000000, 0xB0000000, 0x98000000, 0x94000000, 0x8A000000, 0x5B000000,
+		0x33800000, 0xD9C00000, 0x72200000, 0x3F100000, 0xC1B80000, 0xA6EC0000, 0x53860000, 0x29F50000,
+		0x0A3A8000, 0x1B2AC000, 0xD392E000, 0x69FF7000, 0xEA380800, 0xAB2C0400, 0x4BA60E00, 0xFDE50B00,
+		0x60028980, 0xF006C940, 0x7834E8A0, 0x241A75B0, 0x123A8B38, 0xCF2AC99C, 0xB992E922, 0x82FF78F1
+	},
+	{
+		0x80000000, 0x40000000, 0xA0000000, 0x10000000, 0x08000000, 0x6C000000, 0x9E000000, 0x23000000,
+		0x57800000, 0xADC00000, 0x7FA00000, 0x91D00000, 0x49880000, 0xCED40000, 0x880A0000, 0x2C0F0000,
+		0x3E0D8000, 0x3317C000, 0x5FB06000, 0xC1F8B000, 0xE18D8800, 0xB2D7C400, 0x1E106A00, 0x6328B100,
+		0xF7858880, 0xBDC3C2C0, 0x77BA63E0, 0xFDF7B330, 0xD7800DF8, 0xEDC0081C, 0xDFA0041A, 0x81D00A2D
+	},
+	{
+		0x80000000, 0x40000000, 0x20000000, 0x30000000, 0x58000000, 0xAC000000, 0x96000000, 0x2B000000,
+		0xD4800000, 0x09400000, 0xE2A00000, 0x52500000, 0x4E280000, 0xC71C0000, 0x629E0000, 0x12670000,
+		0x6E138000, 0xF731C000, 0x3A98A000, 0xBE449000, 0xF83B8800, 0xDC2DC400, 0xEE06A200, 0xB7239300,
+		0x1AA80D80, 0x8E5C0EC0, 0xA03E0B60, 0x703701B0, 0x783B88C8, 0x9C2DCA54, 0xCE06A74A, 0x87239795
+	},
+	{
+		0x80000000, 0xC0000000, 0xA0000000, 0x50000000, 0xF8000000, 0x8C000000, 0xE2000000, 0x33000000,
+		0x0F800000, 0x21400000, 0x95A00000, 0x5E700000, 0xD8080000, 0x1C240000, 0xBA160000, 0xEF370000,
+		0x15868000, 0x9E6FC000, 0x781B6000, 0x4C349000, 0x420E8800, 0x630BCC00, 0xF7AD6A00, 0xAD739500,
+		0x77800780, 0x6D4004C0, 0xD7A00420, 0x3D700630, 0x2F880F78, 0xB1640AD4, 0xCDB6077A, 0x824706D7
+	},
+	{
+		0x80000000, 0xC0000000, 0x60000000, 0x90000000, 0x38000000, 0xC4000000, 0x42000000, 0xA3000000,
+		0xF1800000, 0xAA400000, 0xFCE00000, 0x85100000, 0xE0080000, 0x500C0000, 0x58060000, 0x54090000,
+		0x7A038000, 0x670C4000, 0xB3842000, 0x094A3000, 0x0D6F1800, 0x2F5AA400, 0x1CE7CE00, 0xD5145100,
+		0xB8000080, 0x040000C0, 0x22000060, 0x33000090, 0xC9800038, 0x6E4000C4, 0xBEE00042, 0x261000A3
+	},
+	{
+		0x80000000, 0x40000000, 0x20000000, 0xF0000000, 0xA8000000, 0x54000000, 0x9A000000, 0x9D000000,
+		0x1E800000, 0x5CC00000, 0x7D200000, 0x8D100000, 0x24880000, 0x71C40000, 0xEBA20000, 0x75DF0000,
+		0x6BA28000, 0x35D14000, 0x4BA3A000, 0xC5D2D000, 0xE3A16800, 0x91DB8C00, 0x79AEF200, 0x0CDF4100,
+		0x672A8080, 0x50154040, 0x1A01A020, 0xDD0DD0F0, 0x3E83E8A8, 0xACCACC54, 0xD52D529A, 0xD91D919D
+	},
+	{
+		0x80000000, 0xC0000000, 0x20000000, 0xD0000000, 0xD8000000, 0xC4000000, 0x46000000, 0x85000000,
+		0xA5800000, 0x76C00000, 0xADA00000, 0x6AB00000, 0x2DA80000, 0xAABC0000, 0x0DAA0000, 0x7AB10000,
+		0xD5A78000, 0xBEBD4000, 0x93A3E000, 0x3BB51000, 0x3629B800, 0x4D727C00, 0x9B836200, 0x27C4D700,
+		0xB629B880, 0x8D727CC0, 0xBB836220, 0xF7C4D7D0, 0x6E29B858, 0x49727C04, 0xFD836266, 0x72C4D755
+	}
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+uint32_t sobol_u32(uint32_t index, unsigned int dim)
+{
+	const uint32_t *v = sobol_matrix[dim];
+	uint32_t x = 0;
+
+	for (; index; index >>= 1, ++v) {
+		if (index & 1) {
+			x ^= *v;
+		}
+	}
+
+	return x;
+}
+
+scalar_t radical_inverse_scrambled(uint32_t base, uint32_t index, uint32_t seed)
+{
+	const scalar_t inv_base = (scalar_t)1 / (scalar_t)base;
+
+#ifdef MATH_SINGLE_PRECISION
+	const scalar_t limit = 1.0f / 16777216.0f;
+#else
+	const scalar_t limit = 1.0 / 9007199254740992.0;
+#endif /* MATH_SINGLE_PRECISION */
+
+	uint64_t reversed = 0;
+	scalar_t inv_base_n = 1;
+
+	/*
+		Leading zero digits are scrambled too, so keep going until the
+		digits fall below the precision of the result. Each digit is shifted
+		by an amount hashed from the digits above it.
+	*/
+	for (uint32_t n = 0; inv_base_n >= limit; ++n) {
+		uint32_t next = index / base;
+		uint32_t digit = index - next * base;
+
+		uint32_t h = sampler_hash_combine(seed ^ n, (uint32_t)reversed ^ (uint32_t)(reversed >> 32));
+		digit = (digit + h) % base;
+
+		reversed = reversed * base + digit;
+		inv_base_n *= inv_base;
+		index = next;
+	}
+
+	scalar_t r = (scalar_t)reversed * inv_base_n;
+	return r < SCALAR_ONE_MINUS_EPSILON ? r : SCALAR_ONE_MINUS_EPSILON;
+}
+
+void halton_init(halton_t *h, unsigned int dimensions)
+{
+	if (dimensions > NMATH_HALTON_DIMENSIONS) {
+		dimensions = NMATH_HALTON_DIMENSIONS;
+	}
+
+	h->dimensions = dimensions;
+
+	const uint16_t *primes = prime_table();
+
+	for (unsigned int i = 0; i < dimensions; ++i) {
+		h->base[i] = primes[i];
+	}
+}
+
+void stratified_1d(prng_philox_t *s, scalar_t *res, unsigned int count, int jitter)
+{
+	const scalar_t inv = (scalar_t)1 / (scalar_t)count;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		scalar_t offset = jitter ? prng_philox(s, 0, 1) : (scalar_t)0.5;
+		scalar_t r = ((scalar_t)i + offset) * inv;
+		res[i] = r < SCALAR_ONE_MINUS_EPSILON ? r : SCALAR_ONE_MINUS_EPSILON;
+	}
+}
+
+void stratified_2d(prng_philox_t *s, vec2_t *res, unsigned int nx, unsigned int ny, int jitter)
+{
+	const scalar_t inv_x = (scalar_t)1 / (scalar_t)nx;
+	const scalar_t inv_y = (scalar_t)1 / (scalar_t)ny;
+
+	for (unsigned int y = 0; y < ny; ++y) {
+		for (unsigned int x = 0; x < nx; ++x, ++res) {
+			scalar_t ox = jitter ? prng_philox(s, 0, 1) : (scalar_t)0.5;
+			scalar_t oy = jitter ? prng_philox(s, 0, 1) : (scalar_t)0.5;
+			scalar_t u = ((scalar_t)x + ox) * inv_x;
+			scalar_t v = ((scalar_t)y + oy) * inv_y;
+			res->x = u < SCALAR_ONE_MINUS_EPSILON ? u : SCALAR_ONE_MINUS_EPSILON;
+			res->y = v < SCALAR_ONE_MINUS_EPSILON ? v : SCALAR_ONE_MINUS_EPSILON;
+		}
+	}
+}
+
+void latin_hypercube(prng_philox_t *s, scalar_t *res, unsigned int count, unsigned int dims)
+{
+	const scalar_t inv = (scalar_t)1 / (scalar_t)count;
+
+	for (unsigned int d = 0; d < dims; ++d) {
+		/* Jitter along the diagonal, then shuffle the dimension (Fisher-Yates) */
+		for (unsigned int i = 0; i < count; ++i) {
+			scalar_t r = ((scalar_t)i + prng_philox(s, 0, 1)) * inv;
+			res[i * dims + d] = r < SCALAR_ONE_MINUS_EPSILON ? r : SCALAR_ONE_MINUS_EPSILON;
+		}
+
+		for (unsigned int i = count; i > 1; --i) {
+			unsigned int j = (unsigned int)(((uint64_t)prng_philox_u32(s) * i) >> 32);
+			scalar_t t = res[(i - 1) * dims + d];
+			res[(i - 1) * dims + d] = res[j * dims + d];
+			res[j * dims + d] = t;
+		}
+	}
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+Sampler::Sampler(NMATH_SAMPLER_SEQUENCE sequence, uint32_t seed)
+	: m_sequence(sequence), m_seed(seed), m_pixel_seed(0), m_index(0), m_dim(0)
+{
+	halton_init(&m_halton, sequence == SAMPLER_HALTON ? NMATH_HALTON_DIMENSIONS : 0);
+	prng_philox_seed(&m_rng, seed, 0);
+}
+
+void Sampler::start(uint32_t x, uint32_t y, uint32_t index)
+{
+	m_pixel_seed = sampler_hash_combine(sampler_hash_combine(m_seed, x), y);
+	m_index = index;
+	m_dim = 0;
+
+	/* One stream per pixel and sample */
+	prng_philox_seed(&m_rng, m_seed, (uint64_t)m_pixel_seed << 32 | index);
+}
+
+scalar_t Sampler::next_1d()
+{
+	unsigned int dim = m_dim++;
+
+	if (m_sequence == SAMPLER_SOBOL && dim < NMATH_SOBOL_DIMENSIONS) {
+		return sobol_scrambled(m_index, dim, m_pixel_seed);
+	}
+	else if (m_sequence == SAMPLER_HALTON && dim < m_halton.dimensions) {
+		return halton_scrambled(&m_halton, m_index, dim, m_pixel_seed);
+	}
+
+	return prng_philox(&m_rng, 0, 1);
+}
+
+Vector2f Sampler::next_2d()
+{
+	scalar_t u = next_1d();
+	scalar_t v = next_1d();
+	return Vector2f(u, v);
+}
+
+} /* namespace NMath */
@@ -0,0 +1,171 @@
+/*
+
+    This file is part of libnmath.
+
+    sampler.h
+    Low discrepancy and stratified samplers
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SAMPLER_H_INCLUDED
+#define NMATH_SAMPLER_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "prng.h"
+
+#include <stdint.h>
+
+/* Dimensions with tabulated Sobol direction numbers */
+#define NMATH_SOBOL_DIMENSIONS	16
+
+/* Dimensions a halton_t holds prime bases for */
+#define NMATH_HALTON_DIMENSIONS	64
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	Quasi Monte Carlo sequences fill the sample domain far more evenly than
+	independent random points, so an integral converges roughly as 1/N
+	instead of 1/sqrt(N).
+
+	All sequences are indexed, any sample is computed directly from its
+	index and dimension. The scrambled variants apply a randomization that
+	keeps the stratification of the sequence intact. Derive the seed from
+	the pixel, tile or thread to decorrelate neighbouring estimates: the
+	same seed always gives the same points.
+*/
+
+/* Integer hashing, for deriving seeds */
+static inline uint32_t sampler_hash(uint32_t x);
+static inline uint32_t sampler_hash_combine(uint32_t seed, uint32_t v);
+
+static inline uint32_t reverse_bits32(uint32_t x);
+
+/*
+	Nested uniform (Owen) scrambling of the bits of x, most significant bit
+	first, with the hash of Laine and Karras as improved by Burley
+	("Practical Hash-based Owen Scrambling", JCGT 2020).
+*/
+static inline uint32_t owen_scramble(uint32_t x, uint32_t seed);
+
+/* Maps 32 random bits to [0, 1) */
+static inline scalar_t sampler_unit(uint32_t x);
+
+/*
+	Sobol sequence, with the primitive polynomials and direction numbers of
+	Joe and Kuo. Every power of two prefix of the sequence is a (0, m, 2)
+	net in the first two dimensions. dim must be below NMATH_SOBOL_DIMENSIONS.
+
+	The scrambled variant shuffles the index and Owen scrambles every
+	dimension, both driven by the seed. Both preserve the stratification
+	of power of two sample counts.
+*/
+NMATH_DECLSPEC uint32_t sobol_u32(uint32_t index, unsigned int dim);
+static inline scalar_t sobol(uint32_t index, unsigned int dim);
+static inline scalar_t sobol_scrambled(uint32_t index, unsigned int dim, uint32_t seed);
+
+/*
+	Radical inverse of index in the given base, and its scrambled variant
+	which permutes every digit depending on the digits before it, the
+	Owen scrambling of base b.
+*/
+static inline scalar_t radical_inverse(uint32_t base, uint32_t index);
+NMATH_DECLSPEC scalar_t radical_inverse_scrambled(uint32_t base, uint32_t index, uint32_t seed);
+
+/* Halton sequence, dimension i uses the radical inverse in the i-th prime */
+struct halton_t
+{
+	unsigned int dimensions;
+	uint32_t base[NMATH_HALTON_DIMENSIONS];
+};
+
+typedef struct halton_t halton_t;
+
+NMATH_DECLSPEC void halton_init(halton_t *h, unsigned int dimensions);
+static inline scalar_t halton(const halton_t *h, uint32_t index, unsigned int dim);
+static inline scalar_t halton_scrambled(const halton_t *h, uint32_t index, unsigned int dim, uint32_t seed);
+
+/*
+	Stratified sampling. The domain is split in count equal strata, or in
+	nx * ny cells, with one sample per stratum, jittered randomly inside it
+	or placed at its center. The Latin hypercube variant stratifies every
+	one of the dims dimensions independently, res holds count points of
+	dims consecutive values each.
+*/
+NMATH_DECLSPEC void stratified_1d(prng_philox_t *s, scalar_t *res, unsigned int count, int jitter);
+NMATH_DECLSPEC void stratified_2d(prng_philox_t *s, vec2_t *res, unsigned int nx, unsigned int ny, int jitter);
+NMATH_DECLSPEC void latin_hypercube(prng_philox_t *s, scalar_t *res, unsigned int count, unsigned int dims);
+
+enum NMATH_SAMPLER_SEQUENCE
+{
+	SAMPLER_RANDOM,
+	SAMPLER_HALTON,
+	SAMPLER_SOBOL
+};
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/*
+	Per pixel sample generator. start() selects a pixel and sample index,
+	then successive calls return successive dimensions of that sample.
+	Every pixel gets its own scrambling, so the error across pixels is
+	uncorrelated noise rather than structured artifacts. Dimensions beyond
+	those of the sequence fall back to the Philox generator, keyed on the
+	pixel and sample, so the output is deterministic.
+*/
+class NMATH_DECLSPEC Sampler
+{
+	public:
+		Sampler(NMATH_SAMPLER_SEQUENCE sequence, uint32_t seed = 0);
+
+		void start(uint32_t x, uint32_t y, uint32_t index);
+
+		scalar_t next_1d();
+		Vector2f next_2d();
+
+	private:
+		NMATH_SAMPLER_SEQUENCE m_sequence;
+		uint32_t m_seed;
+
+		uint32_t m_pixel_seed;
+		uint32_t m_index;
+		unsigned int m_dim;
+
+		halton_t m_halton;
+		prng_philox_t m_rng;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "sampler.inl"
+
+#endif /* NMATH_SAMPLER_H_INCLUDED */
@@ -0,0 +1,143 @@
+/*
+
+    This file is part of libnmath.
+
+    sampler.inl
+    Low discrepancy and stratified samplers
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SAMPLER_INL_INCLUDED
+#define NMATH_SAMPLER_INL_INCLUDED
+
+#ifndef NMATH_SAMPLER_H_INCLUDED
+    #error "sampler.h must be included before sampler.inl"
+#endif /* NMATH_SAMPLER_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline uint32_t sampler_hash(uint32_t x)
+{
+	/* Wellons' lowbias32 finalizer */
+	x ^= x >> 16;
+	x *= 0x7FEB352D;
+	x ^= x >> 15;
+	x *= 0x846CA68B;
+	x ^= x >> 16;
+	return x;
+}
+
+static inline uint32_t sampler_hash_combine(uint32_t seed, uint32_t v)
+{
+	return sampler_hash(seed ^ (v + 0x9E3779B9 + (seed << 6) + (seed >> 2)));
+}
+
+static inline uint32_t reverse_bits32(uint32_t x)
+{
+	x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+	x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+	x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+	x = ((x >> 8) & 0x00FF00FF) | ((x & 0x00FF00FF) << 8);
+	return (x >> 16) | (x << 16);
+}
+
+static inline uint32_t owen_scramble(uint32_t x, uint32_t seed)
+{
+	/*
+		Every bit of the product depends only on the bits below it, so in
+		reversed order every bit is flipped depending on the more
+		significant ones, which is exactly a nested scramble.
+	*/
+	x = reverse_bits32(x);
+	x ^= x * 0x3D20ADEA;
+	x += seed;
+	x *= (seed >> 16) | 1;
+	x ^= x * 0x05526C56;
+	x ^= x * 0x53A22864;
+	return reverse_bits32(x);
+}
+
+static inline scalar_t sampler_unit(uint32_t x)
+{
+#ifdef MATH_SINGLE_PRECISION
+	/* 24 bits, so that the result never rounds up to 1 */
+	return (scalar_t)(x >> 8) * (1.0f / 16777216.0f);
+#else
+	return (scalar_t)x * (1.0 / 4294967296.0);
+#endif /* MATH_SINGLE_PRECISION */
+}
+
+static inline scalar_t sobol(uint32_t index, unsigned int dim)
+{
+	return sampler_unit(sobol_u32(index, dim));
+}
+
+static inline scalar_t sobol_scrambled(uint32_t index, unsigned int dim, uint32_t seed)
+{
+	/*
+		The Sobol generator matrices are upper triangular, so the leading m
+		bits of a sample only depend on the trailing m bits of the index,
+		which the shuffle permutes among themselves.
+	*/
+	uint32_t x = sobol_u32(owen_scramble(index, seed), dim);
+	return sampler_unit(owen_scramble(x, sampler_hash_combine(seed, dim)));
+}
+
+static inline scalar_t radical_inverse(uint32_t base, uint32_t index)
+{
+	const scalar_t inv_base = (scalar_t)1 / (scalar_t)base;
+
+	uint64_t reversed = 0;
+	scalar_t inv_base_n = 1;
+
+	while (index) {
+		uint32_t next = index / base;
+		uint32_t digit = index - next * base;
+		reversed = reversed * base + digit;
+		inv_base_n *= inv_base;
+		index = next;
+	}
+
+	scalar_t r = (scalar_t)reversed * inv_base_n;
+	return r < SCALAR_ONE_MINUS_EPSILON ? r : SCALAR_ONE_MINUS_EPSILON;
+}
+
+static inline scalar_t halton(const halton_t *h, uint32_t index, unsigned int dim)
+{
+	return radical_inverse(h->base[dim], index);
+}
+
+static inline scalar_t halton_scrambled(const halton_t *h, uint32_t index, unsigned int dim, uint32_t seed)
+{
+	return radical_inverse_scrambled(h->base[dim], index, sampler_hash_combine(seed, dim));
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_SAMPLER_INL_INCLUDED */
@@ -0,0 +1,140 @@
+/*
+
+    This file is part of libnmath.
+
+    simd.h
+    SIMD instruction set selection
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SIMD_H_INCLUDED
+#define NMATH_SIMD_H_INCLUDED
+
+#include "precision.h"
+
+/*
+	The vector code paths are selected at compile time from the
+	instruction sets that the compiler targets (-msse2, -mavx, ...).
+	Define NMATH_NO_SIMD to force the portable scalar implementations.
+*/
+#ifndef NMATH_NO_SIMD
+	#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+		#define NMATH_SIMD_SSE
+	#endif /* __SSE__ */
+
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define NMATH_SIMD_SSE2
+	#endif /* __SSE2__ */
+
+	#if defined(__AVX__)
+		#define NMATH_SIMD_AVX
+	#endif /* __AVX__ */
+
+	#if defined(__AVX2__)
+		#define NMATH_SIMD_AVX2
+	#endif /* __AVX2__ */
+
+	#if defined(__AVX512F__)
+		#define NMATH_SIMD_AVX512
+	#endif /* __AVX512F__ */
+#endif /* NMATH_NO_SIMD */
+
+#if defined(NMATH_SIMD_AVX)
+	#include <immintrin.h>
+#elif defined(NMATH_SIMD_SSE2)
+	#include <emmintrin.h>
+#elif defined(NMATH_SIMD_SSE)
+	#include <xmmintrin.h>
+#endif
+
+namespace NMath {
+
+/*
+	Vectors of NMATH_SCALAR_LANES scalar_t for the batch kernels, left
+	undefined when there is no instruction set for the precision. The
+	comparisons set all the bits of a lane where they hold, and
+	scalar_v_bits packs the lanes into the low bits of an integer.
+*/
+#if defined(MATH_SINGLE_PRECISION) && defined(NMATH_SIMD_AVX)
+	#define NMATH_SCALAR_LANES 8
+
+	typedef __m256 scalar_v;
+
+	static inline scalar_v scalar_v_load(const scalar_t *p) { return _mm256_loadu_ps(p); }
+	static inline scalar_v scalar_v_set(scalar_t a) { return _mm256_set1_ps(a); }
+	static inline scalar_v scalar_v_add(scalar_v a, scalar_v b) { return _mm256_add_ps(a, b); }
+	static inline scalar_v scalar_v_sub(scalar_v a, scalar_v b) { return _mm256_sub_ps(a, b); }
+	static inline scalar_v scalar_v_mul(scalar_v a, scalar_v b) { return _mm256_mul_ps(a, b); }
+	static inline scalar_v scalar_v_max(scalar_v a, scalar_v b) { return _mm256_max_ps(a, b); }
+	static inline scalar_v scalar_v_and(scalar_v a, scalar_v b) { return _mm256_and_ps(a, b); }
+	static inline scalar_v scalar_v_le(scalar_v a, scalar_v b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	static inline unsigned int scalar_v_bits(scalar_v a) { return (unsigned int)_mm256_movemask_ps(a); }
+
+#elif defined(MATH_SINGLE_PRECISION) && defined(NMATH_SIMD_SSE)
+	#define NMATH_SCALAR_LANES 4
+
+	typedef __m128 scalar_v;
+
+	static inline scalar_v scalar_v_load(const scalar_t *p) { return _mm_loadu_ps(p); }
+	static inline scalar_v scalar_v_set(scalar_t a) { return _mm_set1_ps(a); }
+	static inline scalar_v scalar_v_add(scalar_v a, scalar_v b) { return _mm_add_ps(a, b); }
+	static inline scalar_v scalar_v_sub(scalar_v a, scalar_v b) { return _mm_sub_ps(a, b); }
+	static inline scalar_v scalar_v_mul(scalar_v a, scalar_v b) { return _mm_mul_ps(a, b); }
+	static inline scalar_v scalar_v_max(scalar_v a, scalar_v b) { return _mm_max_ps(a, b); }
+	static inline scalar_v scalar_v_and(scalar_v a, scalar_v b) { return _mm_and_ps(a, b); }
+	static inline scalar_v scalar_v_le(scalar_v a, scalar_v b) { return _mm_cmple_ps(a, b); }
+	static inline unsigned int scalar_v_bits(scalar_v a) { return (unsigned int)_mm_movemask_ps(a); }
+
+#elif !defined(MATH_SINGLE_PRECISION) && defined(NMATH_SIMD_AVX)
+	#define NMATH_SCALAR_LANES 4
+
+	typedef __m256d scalar_v;
+
+	static inline scalar_v scalar_v_load(const scalar_t *p) { return _mm256_loadu_pd(p); }
+	static inline scalar_v scalar_v_set(scalar_t a) { return _mm256_set1_pd(a); }
+	static inline scalar_v scalar_v_add(scalar_v a, scalar_v b) { return _mm256_add_pd(a, b); }
+	static inline scalar_v scalar_v_sub(scalar_v a, scalar_v b) { return _mm256_sub_pd(a, b); }
+	static inline scalar_v scalar_v_mul(scalar_v a, scalar_v b) { return _mm256_mul_pd(a, b); }
+	static inline scalar_v scalar_v_max(scalar_v a, scalar_v b) { return _mm256_max_pd(a, b); }
+	static inline scalar_v scalar_v_and(scalar_v a, scalar_v b) { return _mm256_and_pd(a, b); }
+	static inline scalar_v scalar_v_le(scalar_v a, scalar_v b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+	static inline unsigned int scalar_v_bits(scalar_v a) { return (unsigned int)_mm256_movemask_pd(a); }
+
+#elif !defined(MATH_SINGLE_PRECISION) && defined(NMATH_SIMD_SSE2)
+	#define NMATH_SCALAR_LANES 2
+
+	typedef __m128d scalar_v;
+
+	static inline scalar_v scalar_v_load(const scalar_t *p) { return _mm_loadu_pd(p); }
+	static inline scalar_v scalar_v_set(scalar_t a) { return _mm_set1_pd(a); }
+	static inline scalar_v scalar_v_add(scalar_v a, scalar_v b) { return _mm_add_pd(a, b); }
+	static inline scalar_v scalar_v_sub(scalar_v a, scalar_v b) { return _mm_sub_pd(a, b); }
+	static inline scalar_v scalar_v_mul(scalar_v a, scalar_v b) { return _mm_mul_pd(a, b); }
+	static inline scalar_v scalar_v_max(scalar_v a, scalar_v b) { return _mm_max_pd(a, b); }
+	static inline scalar_v scalar_v_and(scalar_v a, scalar_v b) { return _mm_and_pd(a, b); }
+	static inline scalar_v scalar_v_le(scalar_v a, scalar_v b) { return _mm_cmple_pd(a, b); }
+	static inline unsigned int scalar_v_bits(scalar_v a) { return (unsigned int)_mm_movemask_pd(a); }
+
+#endif /* MATH_SINGLE_PRECISION && NMATH_SIMD_AVX */
+
+} /* namespace NMath */
+
+#endif /* NMATH_SIMD_H_INCLUDED */
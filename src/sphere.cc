@@ -30,6 +30,7 @@
 #include "defs.h"
 #include "vector.h"
 #include "intinfo.h"
+#include "simd.h"
 
 namespace NMath {
 
@@ -37,6 +38,44 @@ namespace NMath {
 extern "C" {
 #endif	/* __cplusplus */
 
+void sphere_overlaps_batch(sphere_t s, vec3_soa_t origin, const scalar_t *radius, unsigned int count, uint32_t *mask)
+{
+#ifdef NMATH_SCALAR_LANES
+	const scalar_v cx = scalar_v_set(s.origin.x);
+	const scalar_v cy = scalar_v_set(s.origin.y);
+	const scalar_v cz = scalar_v_set(s.origin.z);
+	const scalar_v r = scalar_v_set(s.radius);
+#endif /* NMATH_SCALAR_LANES */
+
+	for (unsigned int first = 0; first < count; first += 32) {
+		unsigned int n = count - first < 32 ? count - first : 32;
+		uint32_t bits = 0;
+		unsigned int j = 0;
+
+#ifdef NMATH_SCALAR_LANES
+		for (; j + NMATH_SCALAR_LANES <= n; j += NMATH_SCALAR_LANES) {
+			unsigned int i = first + j;
+			scalar_v dx = scalar_v_sub(cx, scalar_v_load(origin.x + i));
+			scalar_v dy = scalar_v_sub(cy, scalar_v_load(origin.y + i));
+			scalar_v dz = scalar_v_sub(cz, scalar_v_load(origin.z + i));
+			scalar_v rr = scalar_v_add(r, scalar_v_load(radius + i));
+			scalar_v d = scalar_v_add(scalar_v_add(scalar_v_mul(dx, dx), scalar_v_mul(dy, dy)), scalar_v_mul(dz, dz));
+
+			bits |= (uint32_t)scalar_v_bits(scalar_v_le(d, scalar_v_mul(rr, rr))) << j;
+		}
+#endif /* NMATH_SCALAR_LANES */
+
+		for (; j < n; ++j) {
+			unsigned int i = first + j;
+			sphere_t b = sphere_pack(vec3_pack(origin.x[i], origin.y[i], origin.z[i]), radius[i]);
+
+			bits |= (uint32_t)sphere_overlaps(s, b) << j;
+		}
+
+		mask[first / 32] = bits;
+	}
+}
+
 #ifdef __cplusplus
 }
 
@@ -79,8 +118,8 @@ bool Sphere::intersection(const Ray &ray, IntInfo* i_info) const
 			i_info->t = t;
 			i_info->point = ray.origin + ray.direction * t;
 			i_info->normal = (i_info->point - origin) / radius;
-			i_info->texcoord = Vector2f((asin(i_info->normal.x / (uv_scale.x != 0.0f ? uv_scale.x : 1.0f)) / PI + 0.5),
-								(asin(i_info->normal.y / (uv_scale.y != 0.0f ? uv_scale.y : 1.0f)) / PI + 0.5));
+			i_info->texcoord = Vector2f((nmath_asin(i_info->normal.x / (uv_scale.x != 0.0f ? uv_scale.x : 1.0f)) / PI + 0.5),
+								(nmath_asin(i_info->normal.y / (uv_scale.y != 0.0f ? uv_scale.y : 1.0f)) / PI + 0.5));
 			i_info->geometry = this;
 
 			return true;
@@ -91,6 +130,25 @@ bool Sphere::intersection(const Ray &ray, IntInfo* i_info) const
 	return false;
 }
 
+void Sphere::overlaps(const vec3_soa_t &origin, const scalar_t *radius, unsigned int count, uint32_t *mask) const
+{
+	sphere_overlaps_batch(sphere_pack(vec3_pack(this->origin.x, this->origin.y, this->origin.z), this->radius),
+						  origin, radius, count, mask);
+}
+
+Vector3f Sphere::closest_point(const Vector3f &p) const
+{
+	Vector3f d = p - origin;
+	scalar_t length = d.length();
+
+	// every point of the surface is as close to the center
+	if (length < EPSILON) {
+		return origin + Vector3f(radius, 0, 0);
+	}
+
+	return origin + d * (radius / length);
+}
+
 void Sphere::calc_aabb()
 {
 	aabb.max = origin + Vector3f(radius, radius, radius);
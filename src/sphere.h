@@ -34,6 +34,9 @@
 #include "vector.h"
 #include "geometry.h"
 #include "ray.h"
+#include "aabb.h"
+
+#include <stdint.h>
 
 namespace NMath {
 
@@ -50,6 +53,13 @@ struct sphere_t
 typedef struct sphere_t sphere_t;
 
 static inline sphere_t sphere_pack(vec3_t origin, scalar_t radius);
+static inline short sphere_overlaps(sphere_t a, sphere_t b);	// returns 1 if the spheres share at least a point, else 0
+
+/*
+	Batch test of s against count spheres given as arrays of origins and
+	radii. The mask is laid out as in aabb3_overlaps_batch.
+*/
+NMATH_DECLSPEC void sphere_overlaps_batch(sphere_t s, vec3_soa_t origin, const scalar_t *radius, unsigned int count, uint32_t *mask);
 
 #ifdef __cplusplus
 }	/* __cplusplus */
@@ -63,6 +73,10 @@ class NMATH_DECLSPEC Sphere: public Geometry
         Sphere(const Vector3f &org, scalar_t rad);
 
 		bool intersection(const Ray &ray, IntInfo* i_info) const;
+		Vector3f closest_point(const Vector3f &p) const;	// on the surface
+		inline bool overlaps(const Sphere &s) const;
+		inline bool overlaps(const BoundingBox3 &b) const;
+		void overlaps(const vec3_soa_t &origin, const scalar_t *radius, unsigned int count, uint32_t *mask) const;	// sphere_overlaps_batch
 		void calc_aabb();
 
         Vector3f origin;
@@ -46,8 +46,30 @@ static inline sphere_t sphere_pack(vec3_t origin, scalar_t radius)
 	return s;
 }
 
+static inline short sphere_overlaps(sphere_t a, sphere_t b)
+{
+	vec3_t d = vec3_sub(a.origin, b.origin);
+	scalar_t r = a.radius + b.radius;
+
+	return (d.x * d.x + d.y * d.y + d.z * d.z <= r * r)? 1 : 0;
+}
+
 #ifdef __cplusplus
 }
+
+inline bool Sphere::overlaps(const Sphere &s) const
+{
+	scalar_t r = radius + s.radius;
+	Vector3f d = origin - s.origin;
+
+	return dot(d, d) <= r * r;
+}
+
+inline bool Sphere::overlaps(const BoundingBox3 &b) const
+{
+	return b.overlaps(origin, radius);
+}
+
 #endif	/* __cplusplus */
 
 } /* namespace NMath */
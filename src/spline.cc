@@ -0,0 +1,333 @@
+/*
+
+    This file is part of libnmath.
+
+    spline.cc
+    Arc length parameterized splines
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include <stdlib.h>
+
+#include "spline.h"
+
+/* Depth limit of the adaptive quadrature and iteration limit of the inversion */
+#define NMATH_SPLINE_DEPTH	16
+#define NMATH_SPLINE_NEWTON	8
+
+namespace NMath {
+
+using Interpolation::poly3_t;
+
+/* 5 point Gauss-Legendre rule on [-1, 1], exact for polynomials of degree 9 */
+static const scalar_t gl_node[5] = {
+	0.0, -0.53846931010568309, 0.53846931010568309, -0.90617984593866399, 0.90617984593866399
+};
+
+static const scalar_t gl_weight[5] = {
+	0.56888888888888889, 0.47862867049936647, 0.47862867049936647, 0.23692688505618909, 0.23692688505618909
+};
+
+static scalar_t spline_speed(const poly3_t *p, unsigned int dim, scalar_t t)
+{
+	scalar_t sum = 0;
+
+	for (unsigned int k = 0; k < dim; ++k) {
+		scalar_t d = p[k].c1 + t * (2 * p[k].c2 + t * 3 * p[k].c3);
+		sum += d * d;
+	}
+
+	return nmath_sqrt(sum);
+}
+
+static scalar_t spline_gauss(const poly3_t *p, unsigned int dim, scalar_t a, scalar_t b)
+{
+	scalar_t h = (b - a) / 2;
+	scalar_t m = (a + b) / 2;
+	scalar_t sum = 0;
+
+	for (unsigned int i = 0; i < 5; ++i) {
+		sum += gl_weight[i] * spline_speed(p, dim, m + h * gl_node[i]);
+	}
+
+	return h * sum;
+}
+
+/*
+	Arc length of segment p over [a, b], where whole is the 5 point rule
+	over the interval. Each half is integrated separately and the interval
+	is split further while the halves disagree with the whole.
+*/
+static scalar_t spline_adaptive(const poly3_t *p, unsigned int dim, scalar_t a, scalar_t b,
+								scalar_t whole, scalar_t tolerance, unsigned int depth)
+{
+	scalar_t m = (a + b) / 2;
+	scalar_t left = spline_gauss(p, dim, a, m);
+	scalar_t right = spline_gauss(p, dim, m, b);
+
+	if (!depth || nmath_abs(left + right - whole) <= tolerance * (left + right)) {
+		return left + right;
+	}
+
+	return spline_adaptive(p, dim, a, m, left, tolerance, depth - 1)
+		 + spline_adaptive(p, dim, m, b, right, tolerance, depth - 1);
+}
+
+static scalar_t spline_integrate(const poly3_t *p, unsigned int dim, scalar_t a, scalar_t b, scalar_t tolerance)
+{
+	return spline_adaptive(p, dim, a, b, spline_gauss(p, dim, a, b), tolerance, NMATH_SPLINE_DEPTH);
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+int spline_init(spline_t *s, const scalar_t *point, unsigned int count, unsigned int dim,
+				int type, unsigned int resolution, scalar_t tolerance)
+{
+	unsigned int segments;
+
+	s->dim = dim;
+	s->segments = 0;
+	s->resolution = resolution;
+	s->tolerance = tolerance;
+	s->poly = 0;
+	s->length = 0;
+	s->bucket = 0;
+
+	if (!dim || dim > 4 || !resolution) {
+		return -1;
+	}
+
+	if (type == SPLINE_BEZIER) {
+		if (count < 4 || (count - 1) % 3) {
+			return -1;
+		}
+		segments = (count - 1) / 3;
+	}
+	else {
+		if (count < 2) {
+			return -1;
+		}
+		segments = count - 1;
+	}
+
+	unsigned int steps = segments * resolution;
+
+	/* Polynomials, lengths and buckets in one block */
+	char *mem = (char *)malloc(segments * dim * sizeof(poly3_t) + (steps + 1) * sizeof(scalar_t)
+							   + steps * sizeof(unsigned int));
+
+	if (!mem) {
+		return -1;
+	}
+
+	s->segments = segments;
+	s->poly = (poly3_t *)mem;
+	s->length = (scalar_t *)(mem + segments * dim * sizeof(poly3_t));
+	s->bucket = (unsigned int *)(s->length + steps + 1);
+
+	for (unsigned int i = 0; i < segments; ++i) {
+		poly3_t *p = s->poly + i * dim;
+
+		if (type == SPLINE_BEZIER) {
+			const scalar_t *a = point + 3 * i * dim;
+
+			for (unsigned int k = 0; k < dim; ++k) {
+				p[k] = Interpolation::poly3_bezier_cubic(a[k], a[dim + k], a[2 * dim + k], a[3 * dim + k]);
+			}
+		}
+		else {
+			const scalar_t *a = point + i * dim;
+			const scalar_t *b = a + dim;
+			const scalar_t *prev = i ? a - dim : a;
+			const scalar_t *next = i + 1 < segments ? b + dim : b;
+
+			for (unsigned int k = 0; k < dim; ++k) {
+				p[k] = Interpolation::poly3_catmullrom(prev[k], a[k], b[k], next[k]);
+			}
+		}
+	}
+
+	s->length[0] = 0;
+
+	for (unsigned int j = 0; j < steps; ++j) {
+		const poly3_t *p = s->poly + (j / resolution) * dim;
+		scalar_t a = (scalar_t)(j % resolution) / resolution;
+		scalar_t b = (scalar_t)(j % resolution + 1) / resolution;
+
+		s->length[j + 1] = s->length[j] + spline_integrate(p, dim, a, b, tolerance);
+	}
+
+	/* bucket[i] is the last step starting at or before i / steps of the length */
+	scalar_t total = s->length[steps];
+
+	for (unsigned int i = 0, j = 0; i < steps; ++i) {
+		scalar_t start = total * i / steps;
+
+		while (j + 1 < steps && s->length[j + 1] <= start) {
+			++j;
+		}
+
+		s->bucket[i] = j;
+	}
+
+	return 0;
+}
+
+void spline_release(spline_t *s)
+{
+	free(s->poly);
+	s->poly = 0;
+	s->length = 0;
+	s->bucket = 0;
+	s->segments = 0;
+}
+
+scalar_t spline_arc_length(const spline_t *s, scalar_t u)
+{
+	const unsigned int resolution = s->resolution;
+
+	if (u <= 0) {
+		return 0;
+	}
+
+	if (u >= (scalar_t)s->segments) {
+		return spline_length(s);
+	}
+
+	unsigned int i = (unsigned int)u;
+	unsigned int k = (unsigned int)((u - i) * resolution);
+
+	if (k >= resolution) {
+		k = resolution - 1;
+	}
+
+	scalar_t a = (scalar_t)k / resolution;
+
+	return s->length[i * resolution + k]
+		 + spline_integrate(s->poly + i * s->dim, s->dim, a, u - i, s->tolerance);
+}
+
+scalar_t spline_param(const spline_t *s, scalar_t distance)
+{
+	const unsigned int resolution = s->resolution;
+	const unsigned int steps = s->segments * resolution;
+	const scalar_t *length = s->length;
+	const scalar_t total = length[steps];
+
+	if (distance <= 0) {
+		return 0;
+	}
+
+	if (distance >= total) {
+		return (scalar_t)s->segments;
+	}
+
+	/* The bucket bounds the step, length[lo] <= distance < length[hi] */
+	unsigned int b = (unsigned int)(distance / total * steps);
+
+	if (b >= steps) {
+		b = steps - 1;
+	}
+
+	unsigned int lo = s->bucket[b];
+	unsigned int hi = b + 1 < steps ? s->bucket[b + 1] + 1 : steps;
+
+	/* Rounding may put distance just outside the bucket */
+	while (lo && length[lo] > distance) {
+		--lo;
+	}
+
+	while (hi < steps && length[hi] <= distance) {
+		++hi;
+	}
+
+	while (hi - lo > 1) {
+		unsigned int mid = lo + (hi - lo) / 2;
+
+		if (length[mid] <= distance) {
+			lo = mid;
+		}
+		else {
+			hi = mid;
+		}
+	}
+
+	/*
+		Newton iterations for the parameter in the step, kept inside a
+		bracket. After the first the corrections are small, and the length
+		is updated with the quadrature over the correction alone.
+	*/
+	const unsigned int segment = lo / resolution;
+	const poly3_t *p = s->poly + segment * s->dim;
+	const scalar_t step = length[lo + 1] - length[lo];
+	const scalar_t rest = distance - length[lo];
+
+	const scalar_t a = (scalar_t)(lo % resolution) / resolution;
+	scalar_t low = a, high = a + (scalar_t)1 / resolution;
+	scalar_t t = a + (high - a) * (rest / step);
+	scalar_t f = spline_integrate(p, s->dim, a, t, s->tolerance) - rest;
+
+	for (unsigned int n = 0; n < NMATH_SPLINE_NEWTON; ++n) {
+		if (nmath_abs(f) <= s->tolerance * step) {
+			break;
+		}
+
+		if (f > 0) {
+			high = t;
+		}
+		else {
+			low = t;
+		}
+
+		scalar_t speed = spline_speed(p, s->dim, t);
+		scalar_t next = speed > 0 ? t - f / speed : low;
+
+		next = next > low && next < high ? next : (low + high) / 2;
+		f += spline_gauss(p, s->dim, t, next);
+		t = next;
+	}
+
+	return (scalar_t)segment + t;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+Spline::Spline(const Vector2f *point, unsigned int count, int type, unsigned int resolution, scalar_t tolerance)
+{
+	m_valid = !spline_init(&m_spline, &point->x, count, 2, type, resolution, tolerance);
+}
+
+Spline::Spline(const Vector3f *point, unsigned int count, int type, unsigned int resolution, scalar_t tolerance)
+{
+	m_valid = !spline_init(&m_spline, &point->x, count, 3, type, resolution, tolerance);
+}
+
+Spline::~Spline()
+{
+	spline_release(&m_spline);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
@@ -0,0 +1,161 @@
+/*
+
+    This file is part of libnmath.
+
+    spline.h
+    Arc length parameterized splines
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SPLINE_H_INCLUDED
+#define NMATH_SPLINE_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "interpolation.h"
+
+/* Default arc length table entries per segment and relative integration tolerance */
+#define NMATH_SPLINE_RESOLUTION	16
+
+#ifdef MATH_SINGLE_PRECISION
+	#define NMATH_SPLINE_TOLERANCE	1E-6
+#else
+	#define NMATH_SPLINE_TOLERANCE	1E-10
+#endif /* MATH_SINGLE_PRECISION */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+enum NMATH_SPLINE_TYPE
+{
+	SPLINE_CATMULLROM,	/* through every point, the end points are repeated */
+	SPLINE_BEZIER		/* cubic segments sharing end points, 3 * segments + 1 points */
+};
+
+/*
+	Multi-segment spline with an arc length table, for motion at constant
+	speed. The parameter u runs from 0 to segments, segment i covers
+	[i, i + 1]. The segments are stored in the power basis of
+	Interpolation::poly3_t, dim polynomials each.
+
+	The table holds the arc length at every 1 / resolution of a segment,
+	each step integrated with adaptive Gauss-Legendre quadrature. A second
+	table buckets the total length into equal parts, so spline_param finds
+	the table step of a distance in constant time for reasonably uniform
+	curves and in O(log n) at worst. Inside the step the parameter is found
+	with a few safeguarded Newton iterations on the exact arc length.
+*/
+struct spline_t
+{
+	unsigned int dim;					/* scalars per point, 1 to 4 */
+	unsigned int segments;
+	unsigned int resolution;			/* table steps per segment */
+	scalar_t tolerance;					/* relative, of every integration */
+	Interpolation::poly3_t *poly;		/* segments * dim */
+	scalar_t *length;					/* segments * resolution + 1, length[0] = 0 */
+	unsigned int *bucket;				/* segments * resolution, first step of each bucket */
+};
+
+typedef struct spline_t spline_t;
+
+/*
+	Build a spline of type NMATH_SPLINE_TYPE through count points of dim
+	scalars each, stored point after point. tolerance is the relative error
+	allowed for the length of each table step. Return 0 on success, -1 if
+	dim is not 1 to 4, resolution is 0, there are too few points for one
+	segment, the point count does not fit a Bezier spline or the allocation
+	failed.
+*/
+NMATH_DECLSPEC int spline_init(spline_t *s, const scalar_t *point, unsigned int count, unsigned int dim,
+							   int type, unsigned int resolution, scalar_t tolerance);
+NMATH_DECLSPEC void spline_release(spline_t *s);
+
+/* Total arc length */
+static inline scalar_t spline_length(const spline_t *s);
+
+/* Write the dim scalars of the point, or of the derivative, at u to res */
+static inline void spline_eval(const spline_t *s, scalar_t u, scalar_t *res);
+static inline void spline_derivative(const spline_t *s, scalar_t u, scalar_t *res);
+
+/* Arc length from 0 to u */
+NMATH_DECLSPEC scalar_t spline_arc_length(const spline_t *s, scalar_t u);
+
+/* Parameter u at the given arc length, clamped to [0, spline_length(s)] */
+NMATH_DECLSPEC scalar_t spline_param(const spline_t *s, scalar_t distance);
+
+/* spline_eval(s, spline_param(s, distance), res) */
+static inline void spline_eval_distance(const spline_t *s, scalar_t distance, scalar_t *res);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/*
+	A spline that owns its segments and arc length tables, so it is not
+	copyable. Points that spline_init rejects leave it invalid with no
+	segments: length() is then 0 and it must not be evaluated.
+*/
+class NMATH_DECLSPEC Spline
+{
+	public:
+		Spline(const Vector2f *point, unsigned int count, int type = SPLINE_CATMULLROM,
+			   unsigned int resolution = NMATH_SPLINE_RESOLUTION, scalar_t tolerance = NMATH_SPLINE_TOLERANCE);
+		Spline(const Vector3f *point, unsigned int count, int type = SPLINE_CATMULLROM,
+			   unsigned int resolution = NMATH_SPLINE_RESOLUTION, scalar_t tolerance = NMATH_SPLINE_TOLERANCE);
+		~Spline();
+
+		inline bool valid() const;
+		inline unsigned int dim() const;
+		inline unsigned int segments() const;
+		inline scalar_t length() const;
+		inline const spline_t *data() const;
+
+		inline scalar_t arc_length(scalar_t u) const;
+		inline scalar_t param(scalar_t distance) const;
+
+		/* The result type has to match dim() */
+		inline void eval(scalar_t u, Vector2f *res) const;
+		inline void eval(scalar_t u, Vector3f *res) const;
+		inline void derivative(scalar_t u, Vector2f *res) const;
+		inline void derivative(scalar_t u, Vector3f *res) const;
+		inline void eval_distance(scalar_t distance, Vector2f *res) const;
+		inline void eval_distance(scalar_t distance, Vector3f *res) const;
+
+	private:
+		Spline(const Spline &);
+		Spline &operator =(const Spline &);
+
+		spline_t m_spline;
+		bool m_valid;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "spline.inl"
+
+#endif /* NMATH_SPLINE_H_INCLUDED */
@@ -0,0 +1,166 @@
+/*
+
+    This file is part of libnmath.
+
+    spline.inl
+    Arc length parameterized splines
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SPLINE_INL_INCLUDED
+#define NMATH_SPLINE_INL_INCLUDED
+
+#ifndef NMATH_SPLINE_H_INCLUDED
+    #error "spline.h must be included before spline.inl"
+#endif /* NMATH_SPLINE_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline scalar_t spline_length(const spline_t *s)
+{
+	return s->length[s->segments * s->resolution];
+}
+
+/* Segment of u, with u replaced by the parameter within the segment */
+static inline const Interpolation::poly3_t *spline_segment(const spline_t *s, scalar_t *u)
+{
+	scalar_t t = *u;
+	unsigned int i = 0;
+
+	if (t >= (scalar_t)s->segments) {
+		i = s->segments - 1;
+	}
+	else if (t > 0) {
+		i = (unsigned int)t;
+	}
+
+	*u = t - (scalar_t)i;
+	return s->poly + i * s->dim;
+}
+
+static inline void spline_eval(const spline_t *s, scalar_t u, scalar_t *res)
+{
+	const Interpolation::poly3_t *p = spline_segment(s, &u);
+
+	for (unsigned int k = 0; k < s->dim; ++k) {
+		res[k] = Interpolation::poly3_eval(p[k], u);
+	}
+}
+
+static inline void spline_derivative(const spline_t *s, scalar_t u, scalar_t *res)
+{
+	const Interpolation::poly3_t *p = spline_segment(s, &u);
+
+	for (unsigned int k = 0; k < s->dim; ++k) {
+		res[k] = p[k].c1 + u * (2 * p[k].c2 + u * 3 * p[k].c3);
+	}
+}
+
+static inline void spline_eval_distance(const spline_t *s, scalar_t distance, scalar_t *res)
+{
+	spline_eval(s, spline_param(s, distance), res);
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline bool Spline::valid() const
+{
+	return m_valid;
+}
+
+inline unsigned int Spline::dim() const
+{
+	return m_spline.dim;
+}
+
+inline unsigned int Spline::segments() const
+{
+	return m_spline.segments;
+}
+
+inline scalar_t Spline::length() const
+{
+	return m_valid ? spline_length(&m_spline) : 0;
+}
+
+inline const spline_t *Spline::data() const
+{
+	return &m_spline;
+}
+
+inline scalar_t Spline::arc_length(scalar_t u) const
+{
+	return spline_arc_length(&m_spline, u);
+}
+
+inline scalar_t Spline::param(scalar_t distance) const
+{
+	return spline_param(&m_spline, distance);
+}
+
+inline void Spline::eval(scalar_t u, Vector2f *res) const
+{
+	scalar_t v[2];
+	spline_eval(&m_spline, u, v);
+	*res = Vector2f(v[0], v[1]);
+}
+
+inline void Spline::eval(scalar_t u, Vector3f *res) const
+{
+	scalar_t v[3];
+	spline_eval(&m_spline, u, v);
+	*res = Vector3f(v[0], v[1], v[2]);
+}
+
+inline void Spline::derivative(scalar_t u, Vector2f *res) const
+{
+	scalar_t v[2];
+	spline_derivative(&m_spline, u, v);
+	*res = Vector2f(v[0], v[1]);
+}
+
+inline void Spline::derivative(scalar_t u, Vector3f *res) const
+{
+	scalar_t v[3];
+	spline_derivative(&m_spline, u, v);
+	*res = Vector3f(v[0], v[1], v[2]);
+}
+
+inline void Spline::eval_distance(scalar_t distance, Vector2f *res) const
+{
+	eval(spline_param(&m_spline, distance), res);
+}
+
+inline void Spline::eval_distance(scalar_t distance, Vector3f *res) const
+{
+	eval(spline_param(&m_spline, distance), res);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_SPLINE_INL_INCLUDED */
@@ -0,0 +1,610 @@
+/*
+
+    This file is part of libnmath.
+
+    sweep.cc
+    Sweep and prune broad phase
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sweep.h"
+
+/* Runs sorted by insertion before the merge passes */
+#define NMATH_SWEEP_RUN	16
+
+/* Initial number of slots of the pair set, a power of 2 */
+#define NMATH_SWEEP_SLOTS	64
+
+#define NMATH_SWEEP_EMPTY	0xFFFFFFFFu
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/* Order of the endpoints, a minimum comes before a maximum of the same value */
+static inline bool sweep_less(const SweepEndpoint &a, const SweepEndpoint &b)
+{
+	return a.value < b.value || (a.value == b.value && (a.data & 1) < (b.data & 1));
+}
+
+/* Merge sort, stable, with tmp as large as e */
+static void sweep_sort(SweepEndpoint *e, SweepEndpoint *tmp, unsigned int count)
+{
+	for (unsigned int first = 0; first < count; first += NMATH_SWEEP_RUN) {
+		unsigned int last = first + NMATH_SWEEP_RUN < count ? first + NMATH_SWEEP_RUN : count;
+
+		for (unsigned int i = first + 1; i < last; ++i) {
+			SweepEndpoint x = e[i];
+			unsigned int j = i;
+
+			while (j > first && sweep_less(x, e[j - 1])) {
+				e[j] = e[j - 1];
+				--j;
+			}
+
+			e[j] = x;
+		}
+	}
+
+	SweepEndpoint *src = e, *dst = tmp;
+
+	for (unsigned int width = NMATH_SWEEP_RUN; width < count; width *= 2) {
+		for (unsigned int first = 0; first < count; first += 2 * width) {
+			unsigned int mid = first + width < count ? first + width : count;
+			unsigned int last = mid + width < count ? mid + width : count;
+			unsigned int i = first, j = mid, k = first;
+
+			while (i < mid && j < last) {
+				dst[k++] = sweep_less(src[j], src[i]) ? src[j++] : src[i++];
+			}
+
+			while (i < mid) {
+				dst[k++] = src[i++];
+			}
+
+			while (j < last) {
+				dst[k++] = src[j++];
+			}
+		}
+
+		SweepEndpoint *t = src;
+		src = dst;
+		dst = t;
+	}
+
+	if (src != e) {
+		memcpy(e, src, count * sizeof(SweepEndpoint));
+	}
+}
+
+static inline unsigned int sweep_hash(unsigned int a, unsigned int b)
+{
+	unsigned int h = a * 0x9E3779B1u ^ b * 0x85EBCA77u;
+	return h ^ (h >> 16);
+}
+
+/*
+	Sweep of all the boxes along the axis on which their centers spread
+	the most. The boxes are copied in the order of their minimum, so that
+	each is tested against the boxes that start after it and before it
+	ends in one pass over memory. The pairs are counted first, so that the
+	second pass writes them in order and in parallel.
+
+	Write at most max pairs, or all of them to an array allocated into
+	*own if own is not 0. Return the number of pairs, NMATH_SWEEP_EMPTY if
+	an allocation failed.
+*/
+static unsigned int sweep_all(const BoundingBox3 *boxes, unsigned int count, OverlapPair *pairs, unsigned int max,
+							  OverlapPair **own)
+{
+	if (own) {
+		*own = 0;
+	}
+
+	if (count < 2) {
+		return 0;
+	}
+
+	SweepEndpoint *start = (SweepEndpoint *)malloc(2 * count * sizeof(SweepEndpoint));
+	BoundingBox3 *sorted = (BoundingBox3 *)malloc(count * sizeof(BoundingBox3));
+	unsigned int *first = (unsigned int *)malloc((count + 1) * sizeof(unsigned int));
+
+	if (!start || !sorted || !first) {
+		free(start);
+		free(sorted);
+		free(first);
+		return NMATH_SWEEP_EMPTY;
+	}
+
+	Vector3f sum, sum2;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		Vector3f c = boxes[i].min + boxes[i].max;
+		sum += c;
+		sum2 += c * c;
+	}
+
+	Vector3f spread = sum2 - sum * sum / (scalar_t)count;
+	unsigned int axis = spread.x >= spread.y ? (spread.x >= spread.z ? 0 : 2) : (spread.y >= spread.z ? 1 : 2);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		start[i].value = boxes[i].min[axis];
+		start[i].data = 2 * i;
+	}
+
+	sweep_sort(start, start + count, count);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		sorted[i] = boxes[start[i].data >> 1];
+	}
+
+	#pragma omp parallel for schedule(dynamic, 256) if(count > 4096)
+	for (int i = 0; i < (int)count; ++i) {
+		const BoundingBox3 &a = sorted[i];
+		unsigned int n = 0;
+
+		/* Along the axis the boxes overlap until the loop ends, the test is on all three to keep it branch free */
+		for (unsigned int j = i + 1; j < count && sorted[j].min[axis] <= a.max[axis]; ++j) {
+			const BoundingBox3 &b = sorted[j];
+
+			n += (a.min.x <= b.max.x) & (b.min.x <= a.max.x) & (a.min.y <= b.max.y) & (b.min.y <= a.max.y)
+			   & (a.min.z <= b.max.z) & (b.min.z <= a.max.z);
+		}
+
+		first[i + 1] = n;
+	}
+
+	first[0] = 0;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		first[i + 1] += first[i];
+	}
+
+	unsigned int total = first[count];
+
+	if (own) {
+		pairs = total ? (OverlapPair *)malloc(total * sizeof(OverlapPair)) : 0;
+		max = total;
+
+		if (total && !pairs) {
+			total = NMATH_SWEEP_EMPTY;
+			max = 0;
+		}
+
+		*own = pairs;
+	}
+
+	#pragma omp parallel for schedule(dynamic, 256) if(count > 4096)
+	for (int i = 0; i < (int)count; ++i) {
+		const BoundingBox3 &a = sorted[i];
+		unsigned int ia = start[i].data >> 1;
+		unsigned int k = first[i];
+		unsigned int last = first[i + 1] < max ? first[i + 1] : max;
+
+		for (unsigned int j = i + 1; k < last && j < count; ++j) {
+			if (a.overlaps(sorted[j])) {
+				unsigned int ib = start[j].data >> 1;
+
+				pairs[k].a = ia < ib ? ia : ib;
+				pairs[k].b = ia < ib ? ib : ia;
+				++k;
+			}
+		}
+	}
+
+	free(start);
+	free(sorted);
+	free(first);
+
+	return total;
+}
+
+OverlapListener::~OverlapListener()
+{}
+
+SweepAndPrune::SweepAndPrune()
+	: m_box(0)
+	, m_pos(0)
+	, m_count(0)
+	, m_pair(0)
+	, m_slot(0)
+	, m_pair_count(0)
+	, m_capacity(0)
+	, m_listener(0)
+	, m_failed(false)
+{
+	m_end[0] = m_end[1] = m_end[2] = 0;
+}
+
+SweepAndPrune::~SweepAndPrune()
+{
+	release();
+}
+
+void SweepAndPrune::release()
+{
+	free(m_box);
+	free(m_pair);
+	free(m_slot);
+
+	m_box = 0;
+	m_end[0] = m_end[1] = m_end[2] = 0;
+	m_pos = 0;
+	m_count = 0;
+	m_pair = 0;
+	m_slot = 0;
+	m_pair_count = 0;
+	m_capacity = 0;
+	m_listener = 0;
+}
+
+bool SweepAndPrune::build(const BoundingBox3 *boxes, unsigned int count, OverlapListener *listener)
+{
+	release();
+
+	if (!count) {
+		return true;
+	}
+
+	/* Boxes, endpoints and places in one block */
+	char *mem = (char *)malloc(count * (sizeof(BoundingBox3) + 6 * sizeof(SweepEndpoint) + 6 * sizeof(unsigned int)));
+	SweepEndpoint *tmp = (SweepEndpoint *)malloc(2 * count * sizeof(SweepEndpoint));
+
+	if (!mem || !tmp) {
+		free(mem);
+		free(tmp);
+		return false;
+	}
+
+	m_box = (BoundingBox3 *)mem;
+	m_end[0] = (SweepEndpoint *)(m_box + count);
+	m_end[1] = m_end[0] + 2 * count;
+	m_end[2] = m_end[1] + 2 * count;
+	m_pos = (unsigned int *)(m_end[2] + 2 * count);
+	m_count = count;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		m_box[i] = boxes[i];
+	}
+
+	for (unsigned int k = 0; k < 3; ++k) {
+		SweepEndpoint *end = m_end[k];
+
+		for (unsigned int i = 0; i < count; ++i) {
+			end[2 * i].value = boxes[i].min[k];
+			end[2 * i].data = 2 * i;
+			end[2 * i + 1].value = boxes[i].max[k];
+			end[2 * i + 1].data = 2 * i + 1;
+		}
+
+		sweep_sort(end, tmp, 2 * count);
+
+		for (unsigned int p = 0; p < 2 * count; ++p) {
+			m_pos[6 * (end[p].data >> 1) + 2 * k + (end[p].data & 1)] = p;
+		}
+	}
+
+	free(tmp);
+
+	OverlapPair *pairs;
+	unsigned int total = sweep_all(boxes, count, 0, 0, &pairs);
+
+	if (total == NMATH_SWEEP_EMPTY) {
+		release();
+		return false;
+	}
+
+	while (2 * total > m_capacity) {
+		if (!grow()) {
+			free(pairs);
+			release();
+			return false;
+		}
+	}
+
+	for (unsigned int i = 0; i < total; ++i) {
+		add_pair(pairs[i].a, pairs[i].b);
+	}
+
+	free(pairs);
+
+	/* The listener hears of the first pairs only once they are all stored */
+	m_listener = listener;
+
+	if (m_listener) {
+		for (unsigned int i = 0; i < m_pair_count; ++i) {
+			m_listener->pair_added(m_pair[i].a, m_pair[i].b);
+		}
+	}
+
+	return true;
+}
+
+bool SweepAndPrune::update(unsigned int i, const BoundingBox3 &box)
+{
+	m_failed = false;
+	m_box[i] = box;
+
+	for (unsigned int k = 0; k < 3; ++k) {
+		const unsigned int *pos = m_pos + 6 * i + 2 * k;
+		SweepEndpoint *end = m_end[k];
+
+		scalar_t min = end[pos[0]].value;
+		scalar_t max = end[pos[1]].value;
+
+		end[pos[0]].value = box.min[k];
+		end[pos[1]].value = box.max[k];
+
+		/* Growing first, so that a minimum never passes its own maximum */
+		if (box.min[k] < min) {
+			sort_down(k, pos[0]);
+		}
+
+		if (box.max[k] > max) {
+			sort_up(k, pos[1]);
+		}
+
+		if (box.min[k] > min) {
+			sort_up(k, pos[0]);
+		}
+
+		if (box.max[k] < max) {
+			sort_down(k, pos[1]);
+		}
+	}
+
+	return !m_failed;
+}
+
+/*
+	Insertion of the endpoint at pos towards the start. Passing the
+	maximum of another box with a minimum may start an overlap, and the
+	boxes decide it; passing a minimum with a maximum ends one.
+*/
+void SweepAndPrune::sort_down(unsigned int axis, unsigned int pos)
+{
+	SweepEndpoint *end = m_end[axis];
+	SweepEndpoint e = end[pos];
+	unsigned int a = e.data >> 1;
+
+	while (pos && sweep_less(e, end[pos - 1])) {
+		SweepEndpoint p = end[pos - 1];
+		unsigned int b = p.data >> 1;
+
+		if (a != b) {
+			if (!(e.data & 1) && (p.data & 1)) {
+				if (m_box[a].overlaps(m_box[b])) {
+					add_pair(a, b);
+				}
+			}
+			else if ((e.data & 1) && !(p.data & 1)) {
+				remove_pair(a, b);
+			}
+		}
+
+		end[pos] = p;
+		m_pos[6 * b + 2 * axis + (p.data & 1)] = pos;
+		--pos;
+	}
+
+	end[pos] = e;
+	m_pos[6 * a + 2 * axis + (e.data & 1)] = pos;
+}
+
+/* The same towards the end, where a maximum passing a minimum may start an overlap */
+void SweepAndPrune::sort_up(unsigned int axis, unsigned int pos)
+{
+	SweepEndpoint *end = m_end[axis];
+	SweepEndpoint e = end[pos];
+	unsigned int a = e.data >> 1;
+	const unsigned int last = 2 * m_count - 1;
+
+	while (pos < last && sweep_less(end[pos + 1], e)) {
+		SweepEndpoint n = end[pos + 1];
+		unsigned int b = n.data >> 1;
+
+		if (a != b) {
+			if ((e.data & 1) && !(n.data & 1)) {
+				if (m_box[a].overlaps(m_box[b])) {
+					add_pair(a, b);
+				}
+			}
+			else if (!(e.data & 1) && (n.data & 1)) {
+				remove_pair(a, b);
+			}
+		}
+
+		end[pos] = n;
+		m_pos[6 * b + 2 * axis + (n.data & 1)] = pos;
+		++pos;
+	}
+
+	end[pos] = e;
+	m_pos[6 * a + 2 * axis + (e.data & 1)] = pos;
+}
+
+/*
+	Pair set
+*/
+
+/* Slot of the pair, or the empty slot where it would go */
+unsigned int SweepAndPrune::find_slot(unsigned int a, unsigned int b) const
+{
+	const unsigned int mask = m_capacity - 1;
+	unsigned int s = sweep_hash(a, b) & mask;
+
+	while (m_slot[s] != NMATH_SWEEP_EMPTY) {
+		const OverlapPair &p = m_pair[m_slot[s]];
+
+		if (p.a == a && p.b == b) {
+			break;
+		}
+
+		s = (s + 1) & mask;
+	}
+
+	return s;
+}
+
+bool SweepAndPrune::overlapping(unsigned int a, unsigned int b) const
+{
+	if (a > b) {
+		unsigned int t = a;
+		a = b;
+		b = t;
+	}
+
+	return m_pair_count && m_slot[find_slot(a, b)] != NMATH_SWEEP_EMPTY;
+}
+
+/* Double the slots, at most half of which are in use */
+bool SweepAndPrune::grow()
+{
+	unsigned int capacity = m_capacity ? 2 * m_capacity : NMATH_SWEEP_SLOTS;
+
+	if (capacity < m_capacity) {
+		return false;
+	}
+
+	OverlapPair *pair = (OverlapPair *)realloc(m_pair, capacity / 2 * sizeof(OverlapPair));
+
+	if (!pair) {
+		return false;
+	}
+
+	m_pair = pair;
+
+	unsigned int *slot = (unsigned int *)malloc(capacity * sizeof(unsigned int));
+
+	if (!slot) {
+		return false;
+	}
+
+	free(m_slot);
+	m_slot = slot;
+	m_capacity = capacity;
+
+	for (unsigned int s = 0; s < capacity; ++s) {
+		m_slot[s] = NMATH_SWEEP_EMPTY;
+	}
+
+	for (unsigned int i = 0; i < m_pair_count; ++i) {
+		m_slot[find_slot(m_pair[i].a, m_pair[i].b)] = i;
+	}
+
+	return true;
+}
+
+bool SweepAndPrune::add_pair(unsigned int a, unsigned int b)
+{
+	if (a > b) {
+		unsigned int t = a;
+		a = b;
+		b = t;
+	}
+
+	if (2 * (m_pair_count + 1) > m_capacity && !grow()) {
+		m_failed = true;
+		return false;
+	}
+
+	unsigned int s = find_slot(a, b);
+
+	if (m_slot[s] != NMATH_SWEEP_EMPTY) {
+		return true;
+	}
+
+	m_slot[s] = m_pair_count;
+	m_pair[m_pair_count].a = a;
+	m_pair[m_pair_count].b = b;
+	++m_pair_count;
+
+	if (m_listener) {
+		m_listener->pair_added(a, b);
+	}
+
+	return true;
+}
+
+void SweepAndPrune::remove_pair(unsigned int a, unsigned int b)
+{
+	if (a > b) {
+		unsigned int t = a;
+		a = b;
+		b = t;
+	}
+
+	if (!m_pair_count) {
+		return;
+	}
+
+	const unsigned int mask = m_capacity - 1;
+	unsigned int s = find_slot(a, b);
+	unsigned int i = m_slot[s];
+
+	if (i == NMATH_SWEEP_EMPTY) {
+		return;
+	}
+
+	/* Shift back the slots after s that would no longer be found past the hole */
+	for (unsigned int j = (s + 1) & mask; m_slot[j] != NMATH_SWEEP_EMPTY; j = (j + 1) & mask) {
+		const OverlapPair &p = m_pair[m_slot[j]];
+		unsigned int home = sweep_hash(p.a, p.b) & mask;
+
+		if (((j - home) & mask) >= ((j - s) & mask)) {
+			m_slot[s] = m_slot[j];
+			s = j;
+		}
+	}
+
+	m_slot[s] = NMATH_SWEEP_EMPTY;
+
+	/* Fill the gap in the pair array with the last pair */
+	unsigned int last = --m_pair_count;
+
+	if (i != last) {
+		m_slot[find_slot(m_pair[last].a, m_pair[last].b)] = i;
+		m_pair[i] = m_pair[last];
+	}
+
+	if (m_listener) {
+		m_listener->pair_removed(a, b);
+	}
+}
+
+unsigned int SweepAndPrune::find_pairs(const BoundingBox3 *boxes, unsigned int count, OverlapPair *pairs, unsigned int max)
+{
+	unsigned int total = sweep_all(boxes, count, pairs, max, 0);
+
+	return total == NMATH_SWEEP_EMPTY ? 0 : total;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
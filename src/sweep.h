@@ -0,0 +1,150 @@
+/*
+
+    This file is part of libnmath.
+
+    sweep.h
+    Sweep and prune broad phase
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SWEEP_H_INCLUDED
+#define NMATH_SWEEP_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "vector.h"
+#include "aabb.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/* Overlapping boxes by their index, a < b */
+struct OverlapPair
+{
+	unsigned int a, b;
+};
+
+/* Notified by SweepAndPrune as pairs start and stop overlapping */
+class NMATH_DECLSPEC OverlapListener
+{
+	public:
+		virtual ~OverlapListener();
+
+		virtual void pair_added(unsigned int a, unsigned int b) = 0;
+		virtual void pair_removed(unsigned int a, unsigned int b) = 0;
+};
+
+/* Endpoint of a box on one axis, data is the box index times 2, plus 1 for the maximum */
+struct SweepEndpoint
+{
+	scalar_t value;
+	unsigned int data;
+};
+
+/*
+	Incremental sweep and prune broad phase over a fixed set of boxes.
+
+	Every axis keeps the 2n endpoints of the boxes sorted, with a minimum
+	before a maximum of the same value so that touching boxes overlap, as
+	in BoundingBox3::overlaps. update() moves the endpoints of one box to
+	their new places with insertion sort. A minimum that passes a maximum
+	of another box may start an overlap, which is tested against the
+	boxes, a maximum that passes a minimum ends one. The cost of an update
+	is the number of endpoints passed, which stays small while the boxes
+	move little between steps.
+
+	The overlapping pairs are kept in a hash set, and the listener hears
+	of every pair as it is added or removed. For a step in which most
+	boxes moved far, find_pairs() sweeps all the boxes from scratch along
+	one axis, in parallel with OpenMP.
+*/
+class NMATH_DECLSPEC SweepAndPrune
+{
+	public:
+		SweepAndPrune();
+		~SweepAndPrune();
+
+		/*
+			Sort the boxes and find the pairs that overlap, which the
+			listener hears of as added. Return false if the allocation failed.
+		*/
+		bool build(const BoundingBox3 *boxes, unsigned int count, OverlapListener *listener = 0);
+		void release();
+
+		/* Move box i, return false if a new pair could not be stored */
+		bool update(unsigned int i, const BoundingBox3 &box);
+
+		inline unsigned int count() const;
+		inline const BoundingBox3 &box(unsigned int i) const;
+
+		/* The overlapping pairs, in no particular order */
+		inline unsigned int pair_count() const;
+		inline const OverlapPair *pairs() const;
+
+		bool overlapping(unsigned int a, unsigned int b) const;
+
+		/*
+			The pairs of overlapping boxes, without any state. Write at most
+			max of them and return how many there are, 0 also if the
+			allocation failed.
+		*/
+		static unsigned int find_pairs(const BoundingBox3 *boxes, unsigned int count, OverlapPair *pairs, unsigned int max);
+
+	private:
+		SweepAndPrune(const SweepAndPrune &);
+		SweepAndPrune &operator =(const SweepAndPrune &);
+
+		void sort_down(unsigned int axis, unsigned int pos);
+		void sort_up(unsigned int axis, unsigned int pos);
+
+		bool add_pair(unsigned int a, unsigned int b);
+		void remove_pair(unsigned int a, unsigned int b);
+		unsigned int find_slot(unsigned int a, unsigned int b) const;
+		bool grow();
+
+		BoundingBox3 *m_box;
+		SweepEndpoint *m_end[3];	/* sorted endpoints of each axis */
+		unsigned int *m_pos;		/* place of endpoint k of box i on axis j at 6 i + 2 j + k */
+		unsigned int m_count;
+
+		OverlapPair *m_pair;
+		unsigned int *m_slot;		/* hash set of pairs, indices into m_pair */
+		unsigned int m_pair_count;
+		unsigned int m_capacity;	/* of m_slot, twice that of m_pair */
+
+		OverlapListener *m_listener;
+		bool m_failed;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "sweep.inl"
+
+#endif /* NMATH_SWEEP_H_INCLUDED */
@@ -0,0 +1,68 @@
+/*
+
+    This file is part of libnmath.
+
+    sweep.inl
+    Sweep and prune broad phase
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_SWEEP_INL_INCLUDED
+#define NMATH_SWEEP_INL_INCLUDED
+
+#ifndef NMATH_SWEEP_H_INCLUDED
+    #error "sweep.h must be included before sweep.inl"
+#endif /* NMATH_SWEEP_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline unsigned int SweepAndPrune::count() const
+{
+	return m_count;
+}
+
+inline const BoundingBox3 &SweepAndPrune::box(unsigned int i) const
+{
+	return m_box[i];
+}
+
+inline unsigned int SweepAndPrune::pair_count() const
+{
+	return m_pair_count;
+}
+
+inline const OverlapPair *SweepAndPrune::pairs() const
+{
+	return m_pair;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_SWEEP_INL_INCLUDED */
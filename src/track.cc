@@ -0,0 +1,140 @@
+/*
+
+    This file is part of libnmath.
+
+    track.cc
+    Keyframe animation tracks
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include <stdlib.h>
+
+#include "track.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+int track_init(track_t *t, const scalar_t *time, const scalar_t *value, unsigned int count,
+			   unsigned int dim, int interpolation, int extrapolation)
+{
+	t->count = 0;
+	t->dim = dim;
+	t->interpolation = interpolation;
+	t->extrapolation = extrapolation;
+	t->time = t->value = 0;
+
+	if (!count || !dim || dim > 4) {
+		return -1;
+	}
+
+	for (unsigned int i = 1; i < count; ++i) {
+		if (!(time[i] > time[i - 1])) {
+			return -1;
+		}
+	}
+
+	/* Times and values in one block */
+	scalar_t *mem = (scalar_t *)malloc(count * (1 + dim) * sizeof(scalar_t));
+
+	if (!mem) {
+		return -1;
+	}
+
+	t->count = count;
+	t->time = mem;
+	t->value = mem + count;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		t->time[i] = time[i];
+	}
+
+	for (unsigned int i = 0; i < count * dim; ++i) {
+		t->value[i] = value ? value[i] : 0;
+	}
+
+	return 0;
+}
+
+void track_release(track_t *t)
+{
+	free(t->time);
+	t->time = t->value = 0;
+	t->count = 0;
+}
+
+void track_eval_batch(const track_t *t, track_cursor_t *c, unsigned int count, scalar_t time, scalar_t *res)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		track_eval(t + i, c + i, time, res);
+		res += t[i].dim;
+	}
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+Track::Track(const scalar_t *time, const scalar_t *value, unsigned int count, int interpolation, int extrapolation)
+{
+	m_valid = !track_init(&m_track, time, value, count, 1, interpolation, extrapolation);
+}
+
+Track::Track(const scalar_t *time, const Vector3f *value, unsigned int count, int interpolation, int extrapolation)
+{
+	m_valid = !track_init(&m_track, time, 0, count, 3, interpolation, extrapolation);
+
+	for (unsigned int i = 0; m_valid && i < count; ++i) {
+		m_track.value[i * 3 + 0] = value[i].x;
+		m_track.value[i * 3 + 1] = value[i].y;
+		m_track.value[i * 3 + 2] = value[i].z;
+	}
+}
+
+Track::Track(const scalar_t *time, const Vector4f *value, unsigned int count, int interpolation, int extrapolation)
+{
+	m_valid = !track_init(&m_track, time, 0, count, 4, interpolation, extrapolation);
+
+	for (unsigned int i = 0; m_valid && i < count; ++i) {
+		m_track.value[i * 4 + 0] = value[i].x;
+		m_track.value[i * 4 + 1] = value[i].y;
+		m_track.value[i * 4 + 2] = value[i].z;
+		m_track.value[i * 4 + 3] = value[i].w;
+	}
+}
+
+Track::~Track()
+{
+	track_release(&m_track);
+}
+
+void Track::eval(const Track *const *tracks, track_cursor_t *c, unsigned int count, scalar_t time, scalar_t *res)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		track_eval(&tracks[i]->m_track, c + i, time, res);
+		res += tracks[i]->m_track.dim;
+	}
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
@@ -0,0 +1,158 @@
+/*
+
+    This file is part of libnmath.
+
+    track.h
+    Keyframe animation tracks
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_TRACK_H_INCLUDED
+#define NMATH_TRACK_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "interpolation.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+enum NMATH_TRACK_INTERPOLATION
+{
+	TRACK_STEP,			/* hold each key until the next */
+	TRACK_LINEAR,
+	TRACK_CATMULLROM	/* uniform Catmull-Rom, the end keys are repeated */
+};
+
+enum NMATH_TRACK_EXTRAPOLATION
+{
+	TRACK_CLAMP,		/* hold the first and last keys */
+	TRACK_REPEAT		/* loop over [time[0], time[count - 1]) */
+};
+
+/*
+	Keyframe track. The values are dim scalars each, stored key after key,
+	so one track type covers scalar_t, Vector3f and Vector4f channels.
+
+	Evaluation goes through a cursor that remembers the segment of the last
+	call. Playback that advances by less than a segment per call finds its
+	segment in constant time, and only a jump falls back to a binary search
+	of the key times. Cursors are separate from the track so any number of
+	players can share one.
+*/
+struct track_t
+{
+	unsigned int count;		/* number of keys */
+	unsigned int dim;		/* scalars per value, 1 to 4 */
+	int interpolation;		/* NMATH_TRACK_INTERPOLATION */
+	int extrapolation;		/* NMATH_TRACK_EXTRAPOLATION */
+	scalar_t *time;			/* strictly increasing */
+	scalar_t *value;		/* count * dim */
+};
+
+typedef struct track_t track_t;
+
+struct track_cursor_t
+{
+	unsigned int segment;	/* segment of the last evaluation */
+};
+
+typedef struct track_cursor_t track_cursor_t;
+
+/*
+	Copy count keys into the track. value may be 0, the values are then
+	zero and can be written to t->value afterwards. Return 0 on success,
+	-1 if count is 0, dim is not 1 to 4, the times are not strictly
+	increasing or the allocation failed.
+*/
+NMATH_DECLSPEC int track_init(track_t *t, const scalar_t *time, const scalar_t *value, unsigned int count,
+							  unsigned int dim, int interpolation, int extrapolation);
+NMATH_DECLSPEC void track_release(track_t *t);
+
+static inline void track_cursor_reset(track_cursor_t *c);
+
+/* Segment s with time[s] <= time < time[s + 1], for time[0] <= time < time[count - 1] */
+static inline unsigned int track_segment(const track_t *t, track_cursor_t *c, scalar_t time);
+
+/* Write the dim scalars of the track value at time to res */
+static inline void track_eval(const track_t *t, track_cursor_t *c, scalar_t time, scalar_t *res);
+
+/*
+	Evaluate count tracks at the same time, with one cursor per track. The
+	values are written one after the other, dim scalars for each track.
+*/
+NMATH_DECLSPEC void track_eval_batch(const track_t *t, track_cursor_t *c, unsigned int count, scalar_t time, scalar_t *res);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/*
+	A track that owns a copy of its keys, so it is not copyable. Keys that
+	track_init rejects leave it invalid with no keys: start() and end()
+	are then 0 and it must not be evaluated.
+*/
+class NMATH_DECLSPEC Track
+{
+	public:
+		Track(const scalar_t *time, const scalar_t *value, unsigned int count,
+			  int interpolation = TRACK_LINEAR, int extrapolation = TRACK_CLAMP);
+		Track(const scalar_t *time, const Vector3f *value, unsigned int count,
+			  int interpolation = TRACK_LINEAR, int extrapolation = TRACK_CLAMP);
+		Track(const scalar_t *time, const Vector4f *value, unsigned int count,
+			  int interpolation = TRACK_LINEAR, int extrapolation = TRACK_CLAMP);
+		~Track();
+
+		inline bool valid() const;
+		inline unsigned int count() const;
+		inline unsigned int dim() const;
+		inline scalar_t start() const;
+		inline scalar_t end() const;
+		inline const track_t *data() const;
+
+		/* The result type has to match dim() */
+		inline void eval(track_cursor_t *c, scalar_t time, scalar_t *res) const;
+		inline void eval(track_cursor_t *c, scalar_t time, Vector3f *res) const;
+		inline void eval(track_cursor_t *c, scalar_t time, Vector4f *res) const;
+
+		/* Batch evaluation, laid out as in track_eval_batch */
+		static void eval(const Track *const *tracks, track_cursor_t *c, unsigned int count, scalar_t time, scalar_t *res);
+
+	private:
+		Track(const Track &);
+		Track &operator =(const Track &);
+
+		track_t m_track;
+		bool m_valid;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "track.inl"
+
+#endif /* NMATH_TRACK_H_INCLUDED */
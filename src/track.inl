@@ -0,0 +1,195 @@
+/*
+
+    This file is part of libnmath.
+
+    track.inl
+    Keyframe animation tracks
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_TRACK_INL_INCLUDED
+#define NMATH_TRACK_INL_INCLUDED
+
+#ifndef NMATH_TRACK_H_INCLUDED
+    #error "track.h must be included before track.inl"
+#endif /* NMATH_TRACK_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+static inline void track_cursor_reset(track_cursor_t *c)
+{
+	c->segment = 0;
+}
+
+static inline unsigned int track_segment(const track_t *t, track_cursor_t *c, scalar_t time)
+{
+	const scalar_t *key = t->time;
+	unsigned int s = c->segment;
+
+	/* Sequential playback, the cached segment or the one after it */
+	if (s + 1 < t->count && time >= key[s]) {
+		if (time < key[s + 1]) {
+			return s;
+		}
+
+		if (s + 2 < t->count && time < key[s + 2]) {
+			c->segment = s + 1;
+			return s + 1;
+		}
+	}
+
+	/* A jump, with key[lo] <= time < key[hi] */
+	unsigned int lo = 0, hi = t->count - 1;
+
+	while (hi - lo > 1) {
+		unsigned int mid = lo + (hi - lo) / 2;
+
+		if (key[mid] <= time) {
+			lo = mid;
+		}
+		else {
+			hi = mid;
+		}
+	}
+
+	c->segment = lo;
+	return lo;
+}
+
+static inline void track_eval(const track_t *t, track_cursor_t *c, scalar_t time, scalar_t *res)
+{
+	const unsigned int dim = t->dim;
+	const unsigned int last = t->count - 1;
+	const scalar_t first_time = t->time[0];
+	const scalar_t last_time = t->time[last];
+
+	if (t->extrapolation == TRACK_REPEAT && last) {
+		scalar_t length = last_time - first_time;
+		time -= length * (scalar_t)floor((time - first_time) / length);
+	}
+
+	if (time <= first_time || !last) {
+		for (unsigned int k = 0; k < dim; ++k) {
+			res[k] = t->value[k];
+		}
+		return;
+	}
+
+	if (time >= last_time) {
+		for (unsigned int k = 0; k < dim; ++k) {
+			res[k] = t->value[last * dim + k];
+		}
+		return;
+	}
+
+	unsigned int s = track_segment(t, c, time);
+
+	const scalar_t *a = t->value + s * dim;
+	const scalar_t *b = a + dim;
+	scalar_t u = (time - t->time[s]) / (t->time[s + 1] - t->time[s]);
+
+	switch (t->interpolation) {
+		case TRACK_STEP:
+			for (unsigned int k = 0; k < dim; ++k) {
+				res[k] = a[k];
+			}
+			break;
+
+		case TRACK_CATMULLROM:
+		{
+			const scalar_t *prev = s ? a - dim : a;
+			const scalar_t *next = s + 1 < last ? b + dim : b;
+
+			for (unsigned int k = 0; k < dim; ++k) {
+				res[k] = Interpolation::catmullrom(prev[k], a[k], b[k], next[k], u);
+			}
+			break;
+		}
+
+		default:
+			for (unsigned int k = 0; k < dim; ++k) {
+				res[k] = Interpolation::linear(a[k], b[k], u);
+			}
+			break;
+	}
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+inline bool Track::valid() const
+{
+	return m_valid;
+}
+
+inline unsigned int Track::count() const
+{
+	return m_track.count;
+}
+
+inline unsigned int Track::dim() const
+{
+	return m_track.dim;
+}
+
+inline scalar_t Track::start() const
+{
+	return m_valid ? m_track.time[0] : 0;
+}
+
+inline scalar_t Track::end() const
+{
+	return m_valid ? m_track.time[m_track.count - 1] : 0;
+}
+
+inline const track_t *Track::data() const
+{
+	return &m_track;
+}
+
+inline void Track::eval(track_cursor_t *c, scalar_t time, scalar_t *res) const
+{
+	track_eval(&m_track, c, time, res);
+}
+
+inline void Track::eval(track_cursor_t *c, scalar_t time, Vector3f *res) const
+{
+	scalar_t v[3];
+	track_eval(&m_track, c, time, v);
+	*res = Vector3f(v[0], v[1], v[2]);
+}
+
+inline void Track::eval(track_cursor_t *c, scalar_t time, Vector4f *res) const
+{
+	scalar_t v[4];
+	track_eval(&m_track, c, time, v);
+	*res = Vector4f(v[0], v[1], v[2], v[3]);
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_TRACK_INL_INCLUDED */
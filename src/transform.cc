@@ -0,0 +1,231 @@
+/*
+
+    This file is part of libnmath.
+
+    transform.cc
+    Affine transformation
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#include "transform.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+aabb3_t aabb3_transform(aabb3_t b, const mat4x4_t m)
+{
+	const scalar_t bmin[3] = { b.min.x, b.min.y, b.min.z };
+	const scalar_t bmax[3] = { b.max.x, b.max.y, b.max.z };
+	scalar_t rmin[3], rmax[3];
+
+	for (int i=0; i<3; ++i) {
+		rmin[i] = rmax[i] = m[i][3];
+
+		for (int j=0; j<3; ++j) {
+			scalar_t e = m[i][j] * bmin[j];
+			scalar_t f = m[i][j] * bmax[j];
+
+			if (e < f) {
+				rmin[i] += e;
+				rmax[i] += f;
+			}
+			else {
+				rmin[i] += f;
+				rmax[i] += e;
+			}
+		}
+	}
+
+	b.min = vec3_pack(rmin[0], rmin[1], rmin[2]);
+	b.max = vec3_pack(rmax[0], rmax[1], rmax[2]);
+	return b;
+}
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+Transform::Transform()
+	: m_inverse_valid(true), m_normal_valid(true)
+{}
+
+Transform::Transform(const Matrix4x4f &m)
+	: m_matrix(m), m_inverse_valid(false), m_normal_valid(false)
+{}
+
+Transform::Transform(const Matrix4x4f &m, const Matrix4x4f &inv)
+	: m_matrix(m), m_inverse(inv), m_inverse_valid(true), m_normal_valid(false)
+{}
+
+void Transform::set_matrix(const Matrix4x4f &m)
+{
+	m_matrix = m;
+	m_inverse_valid = false;
+	m_normal_valid = false;
+}
+
+void Transform::set_matrix(const Matrix4x4f &m, const Matrix4x4f &inv)
+{
+	m_matrix = m;
+	m_inverse = inv;
+	m_inverse_valid = true;
+	m_normal_valid = false;
+}
+
+void Transform::translate(const Vector3f &trans)
+{
+	const Matrix4x4f &m = m_matrix;
+
+	/*
+		T^-1 subtracts t times the last row of M^-1 from its other rows.
+		That row is (0, 0, 0, 1) when M is affine, so the upper 3x3 and
+		the normal matrix are only affected for a projective M.
+	*/
+	if (m[3][0] != 0 || m[3][1] != 0 || m[3][2] != 0 || m[3][3] != 1) {
+		m_normal_valid = false;
+	}
+
+	m_matrix.translate(trans);
+
+	/* (M * T)^-1 = T^-1 * M^-1 */
+	if (m_inverse_valid) {
+		const scalar_t t[3] = { trans.x, trans.y, trans.z };
+
+		for (int i=0; i<3; ++i) {
+			for (int j=0; j<4; ++j) {
+				m_inverse[i][j] -= t[i] * m_inverse[3][j];
+			}
+		}
+	}
+}
+
+void Transform::rotate(const Vector3f &axis, scalar_t angle)
+{
+	Matrix4x4f rot;
+	rot.set_rotation(axis, angle);
+
+	m_matrix *= rot;
+
+	/* (M * R)^-1 = R^T * M^-1 */
+	if (m_inverse_valid) {
+		m_inverse = rot.transposed() * m_inverse;
+	}
+
+	m_normal_valid = false;
+}
+
+void Transform::scale(const Vector3f &vec)
+{
+	m_matrix.scale(Vector4f(vec.x, vec.y, vec.z, 1));
+
+	/* (M * S)^-1 = S^-1 * M^-1 */
+	if (m_inverse_valid) {
+		const scalar_t s[3] = { vec.x, vec.y, vec.z };
+
+		for (int i=0; i<3; ++i) {
+			scalar_t rs = 1.0 / s[i];
+
+			for (int j=0; j<4; ++j) {
+				m_inverse[i][j] *= rs;
+			}
+		}
+	}
+
+	m_normal_valid = false;
+}
+
+void Transform::concatenate(const Transform &t)
+{
+	m_matrix *= t.m_matrix;
+
+	if (m_inverse_valid) {
+		m_inverse = t.inverse() * m_inverse;
+	}
+
+	m_normal_valid = false;
+}
+
+void Transform::update()
+{
+	if (!m_inverse_valid)
+		update_inverse();
+
+	if (!m_normal_valid)
+		update_normal_matrix();
+}
+
+Matrix4x4f Transform::inverse_transpose() const
+{
+	return inverse().transposed();
+}
+
+Transform Transform::inverted() const
+{
+	return Transform(inverse(), m_matrix);
+}
+
+BoundingBox3 Transform::apply_bbox(const BoundingBox3 &b) const
+{
+	aabb3_t box;
+	box.min = vec3_pack(b.min.x, b.min.y, b.min.z);
+	box.max = vec3_pack(b.max.x, b.max.y, b.max.z);
+
+	box = aabb3_transform(box, m_matrix.data);
+
+	BoundingBox3 res;
+	res.min = Vector3f(box.min.x, box.min.y, box.min.z);
+	res.max = Vector3f(box.max.x, box.max.y, box.max.z);
+	return res;
+}
+
+void Transform::update_inverse() const
+{
+	const Matrix4x4f &m = m_matrix;
+
+	/* Affine transformations have a cheaper inverse */
+	if (m[3][0] == 0 && m[3][1] == 0 && m[3][2] == 0 && m[3][3] == 1) {
+		m_inverse = m.inverse_affine();
+	}
+	else {
+		m_inverse = m.inverse();
+	}
+
+	m_inverse_valid = true;
+}
+
+void Transform::update_normal_matrix() const
+{
+	const Matrix4x4f &inv = inverse();
+
+	for (int i=0; i<3; ++i) {
+		for (int j=0; j<3; ++j) {
+			m_normal[i][j] = inv[j][i];
+		}
+	}
+
+	m_normal_valid = true;
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
@@ -0,0 +1,119 @@
+/*
+
+    This file is part of libnmath.
+
+    transform.h
+    Affine transformation
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_TRANSFORM_H_INCLUDED
+#define NMATH_TRANSFORM_H_INCLUDED
+
+#include "defs.h"
+#include "declspec.h"
+#include "precision.h"
+#include "types.h"
+#include "vector.h"
+#include "matrix.h"
+#include "ray.h"
+#include "aabb.h"
+
+namespace NMath {
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/*
+	Transforms the box with Arvo's method, which takes the extrema of
+	every row product directly instead of transforming the 8 corners.
+	m must be affine, i.e. have (0, 0, 0, 1) as its last row.
+*/
+NMATH_DECLSPEC aabb3_t aabb3_transform(aabb3_t b, const mat4x4_t m);
+
+#ifdef __cplusplus
+}   /* extern "C" */
+
+/*
+	A transformation along with its inverse and its normal matrix, the
+	inverse transpose of the upper 3x3 part. Both are computed lazily on
+	first use after a mutation. The incremental mutators update a valid
+	inverse in place rather than inverting the matrix again.
+
+	The lazy caches are written from const accessors, so sharing a const
+	Transform between threads is only safe after update() has been called
+	and before the next mutation.
+*/
+class NMATH_DECLSPEC Transform
+{
+	public:
+		/* Constructors */
+		Transform();
+		Transform(const Matrix4x4f &m);
+		Transform(const Matrix4x4f &m, const Matrix4x4f &inv);	/* inv must be the inverse of m */
+
+		/* Assignment */
+		void set_matrix(const Matrix4x4f &m);
+		void set_matrix(const Matrix4x4f &m, const Matrix4x4f &inv);
+
+		/* Incremental mutation, applied before the current transformation */
+		void translate(const Vector3f &trans);
+		void rotate(const Vector3f &axis, scalar_t angle);	/* axis must be normalized */
+		void scale(const Vector3f &vec);
+		void concatenate(const Transform &t);
+
+		/* Computes the inverse and normal matrix now instead of on first use */
+		void update();
+
+		/* Access */
+		inline const Matrix4x4f &matrix() const;
+		inline const Matrix4x4f &inverse() const;
+		inline const Matrix3x3f &normal_matrix() const;
+		Matrix4x4f inverse_transpose() const;
+		Transform inverted() const;
+
+		/* Application */
+		inline Vector3f apply_point(const Vector3f &p) const;
+		inline Vector3f apply_vector(const Vector3f &v) const;
+		inline Vector3f apply_normal(const Vector3f &n) const;	/* the result is not normalized */
+		inline Ray apply_ray(const Ray &r) const;				/* the direction is not normalized */
+		BoundingBox3 apply_bbox(const BoundingBox3 &b) const;	/* the matrix must be affine */
+
+	private:
+		void update_inverse() const;
+		void update_normal_matrix() const;
+
+		Matrix4x4f m_matrix;
+
+		mutable Matrix4x4f m_inverse;
+		mutable Matrix3x3f m_normal;
+		mutable bool m_inverse_valid;
+		mutable bool m_normal_valid;
+};
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#include "transform.inl"
+
+#endif /* NMATH_TRANSFORM_H_INCLUDED */
@@ -0,0 +1,96 @@
+/*
+
+    This file is part of libnmath.
+
+    transform.inl
+    Affine transformation inline functions
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_TRANSFORM_INL_INCLUDED
+#define NMATH_TRANSFORM_INL_INCLUDED
+
+#ifndef NMATH_TRANSFORM_H_INCLUDED
+    #error "transform.h must be included before transform.inl"
+#endif /* NMATH_TRANSFORM_H_INCLUDED */
+
+namespace NMath {
+
+#ifdef __cplusplus
+
+inline const Matrix4x4f &Transform::matrix() const
+{
+	return m_matrix;
+}
+
+inline const Matrix4x4f &Transform::inverse() const
+{
+	if (!m_inverse_valid)
+		update_inverse();
+
+	return m_inverse;
+}
+
+inline const Matrix3x3f &Transform::normal_matrix() const
+{
+	if (!m_normal_valid)
+		update_normal_matrix();
+
+	return m_normal;
+}
+
+inline Vector3f Transform::apply_point(const Vector3f &p) const
+{
+	const Matrix4x4f &m = m_matrix;
+
+	return Vector3f(m[0][0] * p.x + m[0][1] * p.y + m[0][2] * p.z + m[0][3],
+					m[1][0] * p.x + m[1][1] * p.y + m[1][2] * p.z + m[1][3],
+					m[2][0] * p.x + m[2][1] * p.y + m[2][2] * p.z + m[2][3]);
+}
+
+inline Vector3f Transform::apply_vector(const Vector3f &v) const
+{
+	const Matrix4x4f &m = m_matrix;
+
+	return Vector3f(m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+					m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+					m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+}
+
+inline Vector3f Transform::apply_normal(const Vector3f &n) const
+{
+	const Matrix3x3f &m = normal_matrix();
+
+	return Vector3f(m[0][0] * n.x + m[0][1] * n.y + m[0][2] * n.z,
+					m[1][0] * n.x + m[1][1] * n.y + m[1][2] * n.z,
+					m[2][0] * n.x + m[2][1] * n.y + m[2][2] * n.z);
+}
+
+inline Ray Transform::apply_ray(const Ray &r) const
+{
+	return Ray(apply_point(r.origin), apply_vector(r.direction));
+}
+
+#endif	/* __cplusplus */
+
+} /* namespace NMath */
+
+#endif /* NMATH_TRANSFORM_INL_INCLUDED */
@@ -92,6 +92,67 @@ bool Triangle::intersection(const Ray &ray, IntInfo* i_info) const
 	return true;
 }
 
+/*
+	Closest point by the Voronoi regions of the vertices, the edges and the
+	face, as in "Real-Time Collision Detection", Christer Ericson, 5.1.5
+*/
+Vector3f Triangle::closest_point(const Vector3f &p) const
+{
+	Vector3f ab = v[1] - v[0];
+	Vector3f ac = v[2] - v[0];
+
+	Vector3f ap = p - v[0];
+	scalar_t d1 = dot(ab, ap);
+	scalar_t d2 = dot(ac, ap);
+
+	if (d1 <= 0 && d2 <= 0) {
+		return v[0];
+	}
+
+	Vector3f bp = p - v[1];
+	scalar_t d3 = dot(ab, bp);
+	scalar_t d4 = dot(ac, bp);
+
+	if (d3 >= 0 && d4 <= d3) {
+		return v[1];
+	}
+
+	scalar_t vc = d1 * d4 - d3 * d2;
+
+	if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+		return v[0] + ab * (d1 / (d1 - d3));
+	}
+
+	Vector3f cp = p - v[2];
+	scalar_t d5 = dot(ab, cp);
+	scalar_t d6 = dot(ac, cp);
+
+	if (d6 >= 0 && d5 <= d6) {
+		return v[2];
+	}
+
+	scalar_t vb = d5 * d2 - d1 * d6;
+
+	if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+		return v[0] + ac * (d2 / (d2 - d6));
+	}
+
+	scalar_t va = d3 * d6 - d5 * d4;
+
+	if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+		return v[1] + (v[2] - v[1]) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	}
+
+	// inside the face, denom is 0 only for a degenerate triangle
+	scalar_t denom = va + vb + vc;
+
+	if (denom <= 0) {
+		return v[0];
+	}
+
+	return v[0] + ab * (vb / denom) + ac * (vc / denom);
+}
+
 void Triangle::calc_aabb()
 {
 	aabb.max = Vector3f(-INFINITY, -INFINITY, -INFINITY);
@@ -56,6 +56,7 @@ class NMATH_DECLSPEC Triangle: public Geometry
         Triangle();
 
 		bool intersection(const Ray &ray, IntInfo* i_info) const;
+		Vector3f closest_point(const Vector3f &p) const;
 		void calc_aabb();
 		Vector3f calc_normal() const;
 		Vector3f calc_barycentric(const Vector3f &p) const;
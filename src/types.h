@@ -36,6 +36,15 @@ namespace NMath {
 extern "C" {
 #endif /* __cplusplus */
 
+/*
+	The C types are aggregates, so constant tables of them are laid out
+	at compile time with no startup cost, e.g.
+
+		static const vec3_t face_normals[6] = { {1, 0, 0}, {-1, 0, 0}, ... };
+
+	The C++ classes construct from them inline.
+*/
+
 /* Vectors */
 struct vec2_t { scalar_t x, y; };
 struct vec3_t { scalar_t x, y, z; };
@@ -45,6 +54,21 @@ typedef struct vec2_t vec2_t;
 typedef struct vec3_t vec3_t;
 typedef struct vec4_t vec4_t;
 
+/* Structure of arrays, used by the batch kernels */
+struct vec3_soa_t { scalar_t *x, *y, *z; };
+
+typedef struct vec3_soa_t vec3_soa_t;
+
+/* Quaternions */
+struct quat_t { scalar_t x, y, z, w; };
+
+typedef struct quat_t quat_t;
+
+/* Dual quaternions */
+struct dquat_t { quat_t real, dual; };
+
+typedef struct dquat_t dquat_t;
+
 /* Matrices */
 typedef scalar_t mat3x3_t[3][3];
 typedef scalar_t mat4x4_t[4][4];
@@ -56,6 +80,11 @@ struct aabb3_t { vec3_t min, max; };
 typedef struct aabb2_t aabb2_t;
 typedef struct aabb3_t aabb3_t;
 
+/* Structure of arrays of boxes, used by the batch overlap tests */
+struct aabb3_soa_t { vec3_soa_t min, max; };
+
+typedef struct aabb3_soa_t aabb3_soa_t;
+
 #ifdef __cplusplus
 }   /* extern "C" */
 
@@ -67,6 +96,9 @@ class Vector4f;
 class Matrix3x3f;
 class Matrix4x4f;
 
+class Quaternion;
+class DualQuaternion;
+
 class BoundingBox2;
 class BoundingBox3;
 
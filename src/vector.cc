@@ -54,11 +54,6 @@ void vector_format(std::ostream& out)
 /*
     Vector2f
 */
-Vector2f::Vector2f(scalar_t aX, scalar_t aY): x(aX), y(aY){}
-Vector2f::Vector2f(const Vector2f& v): x(v.x), y(v.y){}
-Vector2f::Vector2f(const Vector3f& v): x(v.x), y(v.y){}
-Vector2f::Vector2f(const Vector4f& v): x(v.x), y(v.y){}
-
 std::ostream& operator <<(std::ostream& out, const Vector2f& vec)
 {
 	vector_format(out);
@@ -70,11 +65,6 @@ std::ostream& operator <<(std::ostream& out, const Vector2f& vec)
 /*
     Vector3f
 */
-Vector3f::Vector3f(scalar_t aX, scalar_t aY, scalar_t aZ): x(aX), y(aY), z(aZ){}
-Vector3f::Vector3f(const Vector3f& v): x(v.x), y(v.y), z(v.z){}
-Vector3f::Vector3f(const Vector2f& v): x(v.x), y(v.y), z(0.0f){}
-Vector3f::Vector3f(const Vector4f& v): x(v.x), y(v.y), z(v.z){}
-
 std::ostream& operator <<(std::ostream& out, const Vector3f &vec)
 {
 	vector_format(out);
@@ -84,13 +74,60 @@ std::ostream& operator <<(std::ostream& out, const Vector3f &vec)
 }
 
 /*
-    Vector4f
+	Batch normalization. A block is copied out to separate x, y and z
+	arrays, so that the squared lengths reach invsqrt_batch as one array
+	and no loop both reads and writes the caller's memory, which would keep
+	the compiler from vectorizing it when res may be v.
 */
-Vector4f::Vector4f(scalar_t aX, scalar_t aY, scalar_t aZ, scalar_t aW): x(aX), y(aY), z(aZ), w(aW){}
-Vector4f::Vector4f(const Vector4f& v): x(v.x), y(v.y), z(v.z), w(v.w){}
-Vector4f::Vector4f(const Vector2f& v): x(v.x), y(v.y), z(0.0f), w(0.0f){}
-Vector4f::Vector4f(const Vector3f& v): x(v.x), y(v.y), z(v.z), w(0.0f){}
+#define NMATH_NORMALIZE_BLOCK	256
+
+template <class T>
+static void vec3_normalize_kernel(T *res, const T *v, unsigned int count, int accuracy)
+{
+	scalar_t x[NMATH_NORMALIZE_BLOCK];
+	scalar_t y[NMATH_NORMALIZE_BLOCK];
+	scalar_t z[NMATH_NORMALIZE_BLOCK];
+	scalar_t inv[NMATH_NORMALIZE_BLOCK];
+
+	for (unsigned int i = 0; i < count; i += NMATH_NORMALIZE_BLOCK) {
+		unsigned int n = count - i < NMATH_NORMALIZE_BLOCK ? count - i : NMATH_NORMALIZE_BLOCK;
+		const T *a = v + i;
+		T *r = res + i;
+
+		for (unsigned int k = 0; k < n; ++k) {
+			x[k] = a[k].x;
+			y[k] = a[k].y;
+			z[k] = a[k].z;
+		}
+
+		for (unsigned int k = 0; k < n; ++k) {
+			inv[k] = x[k] * x[k] + y[k] * y[k] + z[k] * z[k];
+		}
+
+		invsqrt_batch(inv, inv, n, accuracy);
+
+		/* Zero vectors have inv = 0 and stay zero */
+		for (unsigned int k = 0; k < n; ++k) {
+			r[k].x = x[k] * inv[k];
+			r[k].y = y[k] * inv[k];
+			r[k].z = z[k] * inv[k];
+		}
+	}
+}
 
+extern "C" void vec3_normalize_batch(vec3_t *res, const vec3_t *v, unsigned int count, int accuracy)
+{
+	vec3_normalize_kernel(res, v, count, accuracy);
+}
+
+void Vector3f::normalize(Vector3f *res, const Vector3f *v, unsigned int count, int accuracy)
+{
+	vec3_normalize_kernel(res, v, count, accuracy);
+}
+
+/*
+    Vector4f
+*/
 std::ostream& operator <<(std::ostream& out, const Vector4f &vec)
 {
 	vector_format(out);
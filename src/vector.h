@@ -31,6 +31,7 @@
 #include "defs.h"
 #include "declspec.h"
 #include "types.h"
+#include "mutil.h"
 
 #ifdef __cplusplus
 	#include <ostream>
@@ -90,6 +91,14 @@ static inline vec3_t vec3_refract(vec3_t v, vec3_t n, scalar_t ior_src, scalar_t
 
 static inline void vec3_print(FILE *fp, vec3_t v);
 
+/*
+	res[i] = v[i] normalized, accuracy is one of NMATH_RSQRT_ACCURACY, res
+	may be v. Two to three times as fast as a loop of normalized() while the
+	arrays are in cache, beyond that both are bound by memory
+	(bench/normalize).
+*/
+NMATH_DECLSPEC void vec3_normalize_batch(vec3_t *res, const vec3_t *v, unsigned int count, int accuracy);
+
 /*
     C 4D vector functions
 */
@@ -120,18 +129,15 @@ class NMATH_DECLSPEC Vector2f
 {
     public:
         /* Constructors */
-        Vector2f(scalar_t aX = 0.0, scalar_t aY = 0.0);
-        Vector2f(const Vector2f &v);
-        Vector2f(const Vector3f &v);
-        Vector2f(const Vector4f &v);
+        inline Vector2f(scalar_t aX = 0.0, scalar_t aY = 0.0);
+        inline Vector2f(const Vector3f &v);
+        inline Vector2f(const Vector4f &v);
+        inline Vector2f(const vec2_t &v);
 
         /* Array subscript */
         inline scalar_t& operator [](unsigned int index);
         inline const scalar_t& operator [](unsigned int index) const;
 
-        /* Assignment operator */
-        inline const Vector2f &operator =(const Vector2f &v);
-
         /* Unary operator */
         friend inline const Vector2f operator -(const Vector2f &v);
 
@@ -197,18 +203,15 @@ class NMATH_DECLSPEC Vector3f
 {
     public:
         /* Constructors */
-        Vector3f(scalar_t aX = 0.0, scalar_t aY = 0.0, scalar_t aZ = 0.0);
-        Vector3f(const Vector3f &v);
-        Vector3f(const Vector2f &v);
-        Vector3f(const Vector4f &v);
+        inline Vector3f(scalar_t aX = 0.0, scalar_t aY = 0.0, scalar_t aZ = 0.0);
+        inline Vector3f(const Vector2f &v);
+        inline Vector3f(const Vector4f &v);
+        inline Vector3f(const vec3_t &v);
 
         /* Array subscript */
         inline scalar_t& operator [](unsigned int index);
         inline const scalar_t& operator [](unsigned int index) const;
 
-        /* Assignment operator */
-        inline const Vector3f &operator =(const Vector3f &v);
-
         /* Unary operator */
         friend inline const Vector3f operator -(const Vector3f &v);
 
@@ -252,6 +255,7 @@ class NMATH_DECLSPEC Vector3f
         /* - Normalization */
         inline void normalize();
         inline Vector3f normalized() const;
+        static void normalize(Vector3f *res, const Vector3f *v, unsigned int count, int accuracy = RSQRT_NEWTON);
         /* - Reflection / Refraction */
         inline void reflect(const Vector3f &normal);
         inline Vector3f reflected(const Vector3f &normal) const;
@@ -277,18 +281,15 @@ class NMATH_DECLSPEC Vector4f
 {
     public:
         /* Constructors */
-        Vector4f(scalar_t aX = 0.0, scalar_t aY = 0.0, scalar_t aZ = 0.0, scalar_t aW = 0.0);
-        Vector4f(const Vector4f &v);
-        Vector4f(const Vector2f &v);
-        Vector4f(const Vector3f &v);
+        inline Vector4f(scalar_t aX = 0.0, scalar_t aY = 0.0, scalar_t aZ = 0.0, scalar_t aW = 0.0);
+        inline Vector4f(const Vector2f &v);
+        inline Vector4f(const Vector3f &v);
+        inline Vector4f(const vec4_t &v);
 
         /* Array subscript */
         inline scalar_t& operator [](unsigned int index);
         inline const scalar_t& operator [](unsigned int index) const;
 
-        /* Assignment operator */
-        inline const Vector4f &operator =(const Vector4f &v);
-
         /* Unary operator */
         friend inline const Vector4f operator -(const Vector4f &v);
 
@@ -381,6 +381,11 @@ static inline void vec4_print(FILE *fp, vec4_t v)
 }	/* extern "C" */
 
 /* Vector2f functions */
+inline Vector2f::Vector2f(scalar_t aX, scalar_t aY): x(aX), y(aY){}
+inline Vector2f::Vector2f(const Vector3f& v): x(v.x), y(v.y){}
+inline Vector2f::Vector2f(const Vector4f& v): x(v.x), y(v.y){}
+inline Vector2f::Vector2f(const vec2_t& v): x(v.x), y(v.y){}
+
 inline scalar_t &Vector2f::operator [](unsigned int index)
 {
 	return index ? y : x;
@@ -391,13 +396,6 @@ inline const scalar_t &Vector2f::operator [](unsigned int index) const
 	return index ? y : x;
 }
 
-inline const Vector2f& Vector2f::operator =(const Vector2f& v)
-{
-    x = v.x;
-    y = v.y;
-    return v;
-}
-
 inline const Vector2f operator -(const Vector2f& v)
 {
 	return Vector2f(-v.x, -v.y);
@@ -601,6 +599,11 @@ inline scalar_t dot(const Vector2f& v1, const Vector2f& v2)
 }
 
 /* Vector3f functions */
+inline Vector3f::Vector3f(scalar_t aX, scalar_t aY, scalar_t aZ): x(aX), y(aY), z(aZ){}
+inline Vector3f::Vector3f(const Vector2f& v): x(v.x), y(v.y), z(0.0f){}
+inline Vector3f::Vector3f(const Vector4f& v): x(v.x), y(v.y), z(v.z){}
+inline Vector3f::Vector3f(const vec3_t& v): x(v.x), y(v.y), z(v.z){}
+
 inline scalar_t& Vector3f::operator [](unsigned int index)
 {
 	return index ? (index == 1 ? y : z) : x;
@@ -611,14 +614,6 @@ inline const scalar_t& Vector3f::operator [](unsigned int index) const
 	return index ? (index == 1 ? y : z) : x;
 }
 
-inline const Vector3f& Vector3f::operator =(const Vector3f& v)
-{
-    x = v.x;
-    y = v.y;
-    z = v.z;
-    return v;
-}
-
 inline const Vector3f operator -(const Vector3f& v)
 {
 	return Vector3f(-v.x, -v.y, -v.z);
@@ -862,6 +857,11 @@ inline Vector3f Vector3f::transformed(Matrix4x4f &m)
 }
 
 /* Vector4f functions */
+inline Vector4f::Vector4f(scalar_t aX, scalar_t aY, scalar_t aZ, scalar_t aW): x(aX), y(aY), z(aZ), w(aW){}
+inline Vector4f::Vector4f(const Vector2f& v): x(v.x), y(v.y), z(0.0f), w(0.0f){}
+inline Vector4f::Vector4f(const Vector3f& v): x(v.x), y(v.y), z(v.z), w(0.0f){}
+inline Vector4f::Vector4f(const vec4_t& v): x(v.x), y(v.y), z(v.z), w(v.w){}
+
 inline scalar_t& Vector4f::operator [](unsigned int index)
 {
 	return index ? (index == 1 ? y : (index == 2 ? z : w)) : x;
@@ -872,15 +872,6 @@ inline const scalar_t& Vector4f::operator [](unsigned int index) const
 	return index ? (index == 1 ? y : (index == 2 ? z : w)) : x;
 }
 
-inline const Vector4f& Vector4f::operator =(const Vector4f& v)
-{
-    x = v.x;
-    y = v.y;
-    z = v.z;
-    w = v.w;
-    return v;
-}
-
 inline const Vector4f operator -(const Vector4f& v)
 {
 	return Vector4f(-v.x, -v.y, -v.z, -v.w);
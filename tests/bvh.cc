@@ -0,0 +1,385 @@
+/*
+
+    This file is part of libnmath.
+
+    bvh.cc
+    Tests of the closest point queries and the BVH against brute force
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+/*
+	Triangle::closest_point is checked against the nearest of its face
+	projection, edge projections and vertices, which covers every Voronoi
+	region, and Sphere and Plane against their closed forms. The BVH
+	queries are checked against a scan of closest_point() over all the
+	geometry: closest_point, nearest with small k and with k as large as
+	the scene, which outgrows the heap on the stack, and max_distance.
+	A second scene adds unbounded planes, which every query and cull must
+	still see.
+*/
+
+#include "bvh.h"
+#include "plane.h"
+#include "sphere.h"
+#include "triangle.h"
+#include "test.h"
+
+#include <float.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+using namespace NMath;
+
+#define SCENE		3000
+#define QUERIES		300
+
+static const double eps = sizeof(scalar_t) == 4 ? FLT_EPSILON : DBL_EPSILON;
+
+static bool same_distance(double a, double b, double scale)
+{
+	return fabs(a - b) <= 256 * eps * (scale + (a > b ? a : b));
+}
+
+static bool same_point(const Vector3f &a, const Vector3f &b, double scale)
+{
+	return same_distance((a - b).length(), 0, scale);
+}
+
+static Vector3f random_point(double lo, double hi)
+{
+	return Vector3f((scalar_t)test_uniform(lo, hi), (scalar_t)test_uniform(lo, hi), (scalar_t)test_uniform(lo, hi));
+}
+
+/* Closest point of the segment ab to p */
+static Vector3f segment_point(const Vector3f &p, const Vector3f &a, const Vector3f &b)
+{
+	Vector3f ab = b - a;
+	scalar_t t = dot(p - a, ab) / dot(ab, ab);
+	t = t < 0 ? 0 : (t > 1 ? 1 : t);
+	return a + ab * t;
+}
+
+/* The nearest of the face projection, if it falls inside, the edges and the vertices */
+static Vector3f triangle_reference(const Triangle &tri, const Vector3f &p)
+{
+	const Vector3f &a = tri.v[0], &b = tri.v[1], &c = tri.v[2];
+	Vector3f candidate[4] = { segment_point(p, a, b), segment_point(p, b, c), segment_point(p, c, a), Vector3f() };
+	unsigned int count = 3;
+
+	/* Solve for the barycentric coordinates of the projection */
+	Vector3f e1 = b - a, e2 = c - a, w = p - a;
+	double d11 = dot(e1, e1), d12 = dot(e1, e2), d22 = dot(e2, e2);
+	double w1 = dot(w, e1), w2 = dot(w, e2);
+	double det = d11 * d22 - d12 * d12;
+	double u = (w1 * d22 - w2 * d12) / det, v = (w2 * d11 - w1 * d12) / det;
+
+	if (u >= 0 && v >= 0 && u + v <= 1) {
+		candidate[count++] = a + e1 * (scalar_t)u + e2 * (scalar_t)v;
+	}
+
+	Vector3f best = candidate[0];
+
+	for (unsigned int i = 1; i < count; ++i) {
+		if ((candidate[i] - p).length() < (best - p).length()) {
+			best = candidate[i];
+		}
+	}
+
+	return best;
+}
+
+static Triangle random_triangle(const Vector3f &center, double size)
+{
+	Triangle t;
+
+	for (int k = 0; k < 3; ++k) {
+		t.v[k] = center + random_point(-size, size);
+	}
+
+	t.calc_aabb();
+	return t;
+}
+
+static void check_primitives()
+{
+	bool ok = true;
+
+	for (unsigned int i = 0; i < 100000; ++i) {
+		Triangle t = random_triangle(Vector3f(0, 0, 0), 1);
+		Vector3f p = random_point(-3, 3);
+		ok = same_point(t.closest_point(p), triangle_reference(t, p), 3) && ok;
+	}
+
+	test_check("Triangle::closest_point, random points", ok);
+
+	/* One point in each Voronoi region of a right triangle in z = 0 */
+	Triangle t;
+	t.v[0] = Vector3f(0, 0, 0);
+	t.v[1] = Vector3f(1, 0, 0);
+	t.v[2] = Vector3f(0, 1, 0);
+
+	static const scalar_t region[][6] = {
+		{ -1, -1, 1,		0, 0, 0 },			/* vertex 0 */
+		{ 2, -1, -1,		1, 0, 0 },			/* vertex 1 */
+		{ -1, 2, 1,			0, 1, 0 },			/* vertex 2 */
+		{ 0.5, -1, 2,		0.5, 0, 0 },		/* edge 01 */
+		{ 1.5, 1, -2,		0.75, 0.25, 0 },	/* edge 12 */
+		{ -1, 0.5, 0.5,		0, 0.5, 0 },		/* edge 20 */
+		{ 0.25, 0.25, 3,	0.25, 0.25, 0 }		/* face */
+	};
+
+	ok = true;
+
+	for (unsigned int i = 0; i < sizeof(region) / sizeof(region[0]); ++i) {
+		Vector3f p(region[i][0], region[i][1], region[i][2]);
+		Vector3f expected(region[i][3], region[i][4], region[i][5]);
+		ok = same_point(t.closest_point(p), expected, 1) && ok;
+	}
+
+	test_check("Triangle::closest_point, each Voronoi region", ok);
+
+	Sphere s(Vector3f(1, 2, 3), 2);
+	ok = true;
+
+	for (unsigned int i = 0; i < 1000; ++i) {
+		Vector3f p = random_point(-5, 5);
+		Vector3f expected = s.origin + (p - s.origin).normalized() * s.radius;
+		ok = same_point(s.closest_point(p), expected, 5) && ok;
+	}
+
+	test_check("Sphere::closest_point", ok);
+
+	/* The plane y = 2, through abs(normal) * distance */
+	Plane plane;
+	plane.normal = Vector3f(0, 1, 0);
+	plane.distance = 2;
+	ok = true;
+
+	for (unsigned int i = 0; i < 1000; ++i) {
+		Vector3f p = random_point(-5, 5);
+		ok = same_point(plane.closest_point(p), Vector3f(p.x, 2, p.z), 5) && ok;
+	}
+
+	test_check("Plane::closest_point", ok);
+}
+
+/* Distances of all the geometry from p, sorted */
+static std::vector<double> brute_force(const std::vector<const Geometry *> &scene, const Vector3f &p)
+{
+	std::vector<double> d(scene.size());
+
+	for (size_t i = 0; i < scene.size(); ++i) {
+		d[i] = (scene[i]->closest_point(p) - p).length();
+	}
+
+	std::sort(d.begin(), d.end());
+	return d;
+}
+
+/* The result is the geometry's own closest point, at the distance given */
+static bool consistent(const std::vector<const Geometry *> &scene, const Vector3f &p, const PointInfo &info, double scale)
+{
+	return info.geometry && info.index < scene.size() && info.geometry == scene[info.index]
+		&& same_point(info.point, scene[info.index]->closest_point(p), scale)
+		&& same_distance(info.distance, (info.point - p).length(), scale);
+}
+
+static bool check_nearest(const BVH &bvh, const std::vector<const Geometry *> &scene, const Vector3f &p,
+						  unsigned int k, scalar_t max_distance, double scale)
+{
+	std::vector<double> ref = brute_force(scene, p);
+	std::vector<PointInfo> info(k);
+
+	unsigned int n = bvh.nearest(p, k, &info[0], max_distance);
+	unsigned int expected = 0;
+
+	while (expected < k && expected < ref.size() && ref[expected] < max_distance) {
+		++expected;
+	}
+
+	/* A distance within rounding of max_distance may go either way */
+	if (n != expected && !(n + 1 == expected && same_distance(ref[n], max_distance, scale))) {
+		return false;
+	}
+
+	std::vector<unsigned int> seen;
+
+	for (unsigned int i = 0; i < n; ++i) {
+		if (!consistent(scene, p, info[i], scale) || !same_distance(info[i].distance, ref[i], scale)) {
+			return false;
+		}
+
+		seen.push_back(info[i].index);
+	}
+
+	std::sort(seen.begin(), seen.end());
+	return std::adjacent_find(seen.begin(), seen.end()) == seen.end();
+}
+
+static bool check_closest(const BVH &bvh, const std::vector<const Geometry *> &scene, const Vector3f &p, double scale)
+{
+	std::vector<double> ref = brute_force(scene, p);
+	PointInfo info;
+
+	return bvh.closest_point(p, &info) && consistent(scene, p, info, scale) && same_distance(info.distance, ref[0], scale);
+}
+
+/* Indices the BVH passes against those whose boxes overlap, unbounded ones always */
+static bool check_cull(const BVH &bvh, const std::vector<const Geometry *> &scene, const Frustum &frustum)
+{
+	std::vector<unsigned int> expected, index(scene.size());
+
+	for (unsigned int i = 0; i < scene.size(); ++i) {
+		if (scene[i]->type == GEOMETRY_PLANE || frustum.overlaps(scene[i]->aabb)) {
+			expected.push_back(i);
+		}
+	}
+
+	unsigned int n = bvh.cull(frustum, &index[0], (unsigned int)index.size());
+	index.resize(n < index.size() ? n : index.size());
+	std::sort(index.begin(), index.end());
+
+	return n == expected.size() && index == expected;
+}
+
+static void check_scene(const char *name, const std::vector<const Geometry *> &scene, double scale)
+{
+	char label[128];
+	BVH bvh;
+
+	sprintf(label, "%s: build", name);
+	test_check(label, bvh.build(&scene[0], (unsigned int)scene.size()) == 0 && bvh.count() == scene.size());
+
+	std::vector<Vector3f> query(QUERIES);
+
+	for (unsigned int i = 0; i < QUERIES; ++i) {
+		/* Inside the scene and around it */
+		query[i] = random_point(-0.2 * scale, 1.2 * scale);
+	}
+
+	bool ok = true;
+
+	for (unsigned int i = 0; i < QUERIES; ++i) {
+		ok = check_closest(bvh, scene, query[i], scale) && ok;
+	}
+
+	sprintf(label, "%s: closest_point", name);
+	test_check(label, ok);
+
+	/* The batch form against the single one */
+	std::vector<PointInfo> batch(QUERIES);
+	bvh.closest_point(&query[0], QUERIES, &batch[0]);
+	ok = true;
+
+	for (unsigned int i = 0; i < QUERIES; ++i) {
+		PointInfo info;
+		bvh.closest_point(query[i], &info);
+		ok = ok && batch[i].index == info.index && batch[i].distance == info.distance;
+	}
+
+	sprintf(label, "%s: closest_point batch", name);
+	test_check(label, ok);
+
+	static const unsigned int ks[] = { 2, 16 };
+
+	for (unsigned int j = 0; j < sizeof(ks) / sizeof(ks[0]); ++j) {
+		ok = true;
+
+		for (unsigned int i = 0; i < QUERIES; ++i) {
+			ok = check_nearest(bvh, scene, query[i], ks[j], SCALAR_T_MAX, scale) && ok;
+		}
+
+		sprintf(label, "%s: nearest k = %u", name, ks[j]);
+		test_check(label, ok);
+	}
+
+	/* Every node is a candidate, so the heap has to grow */
+	ok = true;
+
+	for (unsigned int i = 0; i < 10; ++i) {
+		ok = check_nearest(bvh, scene, query[i], (unsigned int)scene.size(), SCALAR_T_MAX, scale) && ok;
+	}
+
+	sprintf(label, "%s: nearest k = all", name);
+	test_check(label, ok);
+
+	ok = true;
+
+	for (unsigned int i = 0; i < QUERIES; ++i) {
+		ok = check_nearest(bvh, scene, query[i], 32, (scalar_t)test_uniform(0, 0.1) * (scalar_t)scale, scale) && ok;
+	}
+
+	sprintf(label, "%s: nearest within max_distance", name);
+	test_check(label, ok);
+
+	/* A frustum around a corner of the scene, and one beyond it */
+	Matrix4x4f m;
+	m.data[0][0] = m.data[1][1] = m.data[2][2] = (scalar_t)(4 / scale);
+	Frustum corner(m);
+
+	m.data[0][3] = m.data[1][3] = m.data[2][3] = -10;
+	Frustum beyond(m);
+
+	sprintf(label, "%s: cull", name);
+	test_check(label, check_cull(bvh, scene, corner) && check_cull(bvh, scene, beyond));
+}
+
+int main()
+{
+	printf("BVH, %u geometries, %u queries per check\n", SCENE, QUERIES);
+
+	check_primitives();
+
+	/* Small spheres and triangles in a 10 unit cube */
+	std::vector<Sphere> spheres;
+	std::vector<Triangle> triangles;
+
+	for (unsigned int i = 0; i < SCENE / 2; ++i) {
+		spheres.push_back(Sphere(random_point(0, 10), (scalar_t)test_uniform(0.01, 0.3)));
+		spheres.back().calc_aabb();
+		triangles.push_back(random_triangle(random_point(0, 10), 0.3));
+	}
+
+	std::vector<const Geometry *> scene;
+
+	for (unsigned int i = 0; i < SCENE / 2; ++i) {
+		scene.push_back(&spheres[i]);
+		scene.push_back(&triangles[i]);
+	}
+
+	check_scene("spheres and triangles", scene, 10);
+
+	/* The same with planes below and beside the cube, at the front and the end */
+	Plane floor, wall;
+	floor.normal = Vector3f(0, 1, 0);
+	floor.distance = -1;
+	floor.calc_aabb();
+	wall.normal = Vector3f(1, 0, 0);
+	wall.distance = 11;
+	wall.calc_aabb();
+
+	scene.insert(scene.begin(), &floor);
+	scene.push_back(&wall);
+
+	check_scene("with planes", scene, 10);
+
+	return test_result("bvh");
+}
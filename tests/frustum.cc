@@ -0,0 +1,192 @@
+/*
+
+    This file is part of libnmath.
+
+    frustum.cc
+    Tests of the batch frustum culling against the single test
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+/*
+	frustum_cull_batch must set exactly the bits frustum_overlaps_aabb
+	gives, clear the bits past count in the last word and write nothing
+	past it. The counts straddle the lane and word boundaries, the largest
+	one is enough words for the OpenMP path. An orthographic frustum with
+	power of two planes and boxes on a half unit grid make the touching
+	cases exact, and those must agree too. A perspective frustum has
+	rounded planes, so there a box whose p-vertex lies within rounding of
+	a plane may go either way.
+*/
+
+#include "frustum.h"
+#include "test.h"
+
+#include <float.h>
+#include <math.h>
+#include <vector>
+
+using namespace NMath;
+
+#define SENTINEL	0x5a5a5a5au
+
+static const unsigned int counts[] = { 1, 7, 31, 32, 33, 100, 40000 };
+
+static scalar_t grid(int lo, int hi)
+{
+	return (scalar_t)(2 * lo + (int)(test_rand() % (2 * (hi - lo) + 1))) / 2;
+}
+
+/* count boxes from an odd offset in the arrays */
+struct Batch
+{
+	std::vector<scalar_t> data[6];
+	aabb3_soa_t soa;
+
+	Batch(unsigned int count, int lo, int hi)
+	{
+		for (int i = 0; i < 6; ++i) {
+			data[i].assign(count + 1, 0);
+		}
+
+		soa.min.x = &data[0][1];
+		soa.min.y = &data[1][1];
+		soa.min.z = &data[2][1];
+		soa.max.x = &data[3][1];
+		soa.max.y = &data[4][1];
+		soa.max.z = &data[5][1];
+
+		scalar_t *min[3] = { soa.min.x, soa.min.y, soa.min.z };
+		scalar_t *max[3] = { soa.max.x, soa.max.y, soa.max.z };
+
+		for (unsigned int i = 0; i < count; ++i) {
+			for (int k = 0; k < 3; ++k) {
+				scalar_t a = grid(lo, hi), b = grid(lo, hi);
+				min[k][i] = a < b ? a : b;
+				max[k][i] = a < b ? b : a;
+			}
+		}
+	}
+
+	aabb3_t box(unsigned int i) const
+	{
+		return aabb3_pack(vec3_pack(soa.min.x[i], soa.min.y[i], soa.min.z[i]),
+						  vec3_pack(soa.max.x[i], soa.max.y[i], soa.max.z[i]));
+	}
+};
+
+/* Whether the p-vertex of some plane is within tolerance of it */
+static bool near_plane(const frustum_t *f, aabb3_t b, double tolerance)
+{
+	for (unsigned int i = 0; i < 6; ++i) {
+		const frustum_plane_t *p = f->plane + i;
+		double pd = (double)p->normal.x * (p->normal.x >= 0 ? b.max.x : b.min.x)
+				  + (double)p->normal.y * (p->normal.y >= 0 ? b.max.y : b.min.y)
+				  + (double)p->normal.z * (p->normal.z >= 0 ? b.max.z : b.min.z) + p->distance;
+
+		if (fabs(pd) <= tolerance) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+	The mask matches the single test where the box is farther than
+	tolerance from the planes, is cleared past count and the word after it
+	is untouched.
+*/
+static bool check_cull(const Frustum &frustum, const Batch &batch, unsigned int count, double tolerance, unsigned int *visible)
+{
+	const frustum_t *f = frustum.data();
+	unsigned int words = (count + 31) / 32;
+	std::vector<uint32_t> mask(words + 1, SENTINEL), wrapped(words + 1, SENTINEL);
+
+	frustum_cull_batch(f, batch.soa, count, &mask[0]);
+	frustum.cull(batch.soa, count, &wrapped[0]);
+
+	bool ok = mask == wrapped && mask[words] == SENTINEL;
+
+	for (unsigned int i = 0; i < words * 32 && ok; ++i) {
+		unsigned int bit = (mask[i / 32] >> (i % 32)) & 1;
+
+		if (i >= count) {
+			ok = !bit;
+		}
+		else if ((unsigned int)frustum_overlaps_aabb(f, batch.box(i)) != bit) {
+			ok = tolerance > 0 && near_plane(f, batch.box(i), tolerance);
+		}
+
+		*visible += bit;
+	}
+
+	return ok;
+}
+
+static void check_frustum(const char *name, const Frustum &frustum, int lo, int hi, double tolerance)
+{
+	char label[128];
+
+	for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+		bool ok = true;
+		unsigned int visible = 0, total = 0;
+
+		for (unsigned int q = 0; q < (counts[c] > 1000 ? 2 : 50); ++q) {
+			Batch batch(counts[c], lo, hi);
+			ok = check_cull(frustum, batch, counts[c], tolerance, &visible) && ok;
+			total += counts[c];
+		}
+
+		/* Neither everything nor nothing, or the check says little */
+		if (counts[c] > 32) {
+			ok = ok && visible > 0 && visible < total;
+		}
+
+		sprintf(label, "%s, %u boxes", name, counts[c]);
+		test_check(label, ok);
+	}
+}
+
+int main()
+{
+	printf("Batch frustum culling, 50 batches per check\n");
+
+	/* x in [-3, 5], y in [-4, 4], z in [-4, 4], all exact */
+	Matrix4x4f ortho((scalar_t)0.25, 0, 0, (scalar_t)0.25,
+					 0, (scalar_t)0.25, 0, 0,
+					 0, 0, (scalar_t)0.25, 0,
+					 0, 0, 0, 1);
+
+	check_frustum("orthographic", Frustum(ortho), -6, 6, 0);
+	check_frustum("orthographic, zero depth", Frustum(ortho, FRUSTUM_DEPTH_ZERO), -6, 6, 0);
+
+	/* 60 degrees vertically, 4:3, from 1 to 20 along -z */
+	double f = 1 / tan(M_PI / 6), n = 1, r = 20;
+	Matrix4x4f perspective((scalar_t)(f * 3 / 4), 0, 0, 0,
+						   0, (scalar_t)f, 0, 0,
+						   0, 0, (scalar_t)((n + r) / (n - r)), (scalar_t)(2 * n * r / (n - r)),
+						   0, 0, -1, 0);
+
+	double eps = sizeof(scalar_t) == 4 ? FLT_EPSILON : DBL_EPSILON;
+
+	check_frustum("perspective", Frustum(perspective), -20, 4, 256 * eps * 20);
+
+	return test_result("frustum");
+}
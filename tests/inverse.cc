@@ -0,0 +1,276 @@
+/*
+
+    This file is part of libnmath.
+
+    inverse.cc
+    Accuracy of the 4x4 inverses against a cofactor expansion
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+/*
+	The general inverse has an SSE (single precision), an SSE2 (double
+	precision) and a scalar kernel, selected at compile time, so make check
+	builds this test once per kernel, each with its own copy of matrix.cc.
+
+	The reference is the cofactor expansion that mat4x4_inverse used
+	before, evaluated in long double. The error of an inverse grows with
+	the condition number of the matrix, so each result is held to a bound
+	of a small multiple of cond(m) * epsilon.
+*/
+
+#include "matrix.h"
+#include "simd.h"
+#include "test.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+using namespace NMath;
+
+#if defined(NMATH_SIMD_SSE) && defined(MATH_SINGLE_PRECISION)
+	#define KERNEL "SSE"
+#elif defined(NMATH_SIMD_SSE2) && !defined(MATH_SINGLE_PRECISION)
+	#define KERNEL "SSE2"
+#else
+	#define KERNEL "scalar"
+#endif
+
+#ifdef MATH_SINGLE_PRECISION
+	#define PRECISION "single"
+	#define MACHINE_EPSILON FLT_EPSILON
+#else
+	#define PRECISION "double"
+	#define MACHINE_EPSILON DBL_EPSILON
+#endif /* MATH_SINGLE_PRECISION */
+
+#define TRIALS 10000
+#define BOUND 8
+
+typedef long double ref_t;
+
+static ref_t minor3(const mat4x4_t m, int row, int col)
+{
+	int r[3], c[3];
+
+	for (int i = 0, n = 0; i < 4; ++i) {
+		if (i != row) r[n++] = i;
+	}
+
+	for (int j = 0, n = 0; j < 4; ++j) {
+		if (j != col) c[n++] = j;
+	}
+
+	ref_t a[3][3];
+
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			a[i][j] = m[r[i]][c[j]];
+		}
+	}
+
+	return a[0][0] * (a[1][1] * a[2][2] - a[2][1] * a[1][2])
+		 - a[0][1] * (a[1][0] * a[2][2] - a[2][0] * a[1][2])
+		 + a[0][2] * (a[1][0] * a[2][1] - a[2][0] * a[1][1]);
+}
+
+/* Returns 0 if m is singular */
+static int reference_inverse(ref_t res[4][4], const mat4x4_t m)
+{
+	ref_t cof[4][4];
+	ref_t det = 0;
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			cof[i][j] = ((i + j) & 1 ? -1 : 1) * minor3(m, i, j);
+		}
+		det += m[0][i] * cof[0][i];
+	}
+
+	if (det == 0) {
+		return 0;
+	}
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			res[i][j] = cof[j][i] / det;
+		}
+	}
+
+	return 1;
+}
+
+static ref_t norm_inf(const ref_t m[4][4])
+{
+	ref_t res = 0;
+
+	for (int i = 0; i < 4; ++i) {
+		ref_t row = fabsl(m[i][0]) + fabsl(m[i][1]) + fabsl(m[i][2]) + fabsl(m[i][3]);
+		res = row > res ? row : res;
+	}
+
+	return res;
+}
+
+/* Error of inv relative to the bound for m, 1 is on the bound */
+static double relative_error(const mat4x4_t inv, const mat4x4_t m)
+{
+	ref_t ref[4][4], mr[4][4], diff = 0;
+
+	if (!reference_inverse(ref, m)) {
+		return 0;
+	}
+
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			mr[i][j] = m[i][j];
+
+			ref_t d = fabsl(inv[i][j] - ref[i][j]);
+			diff = d > diff ? d : diff;
+		}
+	}
+
+	ref_t cond = norm_inf(mr) * norm_inf(ref);
+
+	return (double)(diff / (norm_inf(ref) * cond * MACHINE_EPSILON));
+}
+
+static void random_matrix(mat4x4_t m)
+{
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			m[i][j] = (scalar_t)test_uniform(-1, 1);
+		}
+	}
+}
+
+static void random_affine(mat4x4_t m)
+{
+	random_matrix(m);
+
+	for (int j = 0; j < 3; ++j) {
+		m[j][3] = (scalar_t)test_uniform(-100, 100);
+	}
+
+	m[3][0] = m[3][1] = m[3][2] = 0;
+	m[3][3] = 1;
+}
+
+/* Rotation from a random unit quaternion, plus a translation */
+static void random_rigid(mat4x4_t m)
+{
+	double x, y, z, w, l;
+
+	do {
+		x = test_uniform(-1, 1); y = test_uniform(-1, 1);
+		z = test_uniform(-1, 1); w = test_uniform(-1, 1);
+		l = x * x + y * y + z * z + w * w;
+	} while (l < 0.01 || l > 1);
+
+	l = 1 / sqrt(l);
+	x *= l; y *= l; z *= l; w *= l;
+
+	mat4x4_pack(m,
+		(scalar_t)(1 - 2 * (y * y + z * z)), (scalar_t)(2 * (x * y - w * z)), (scalar_t)(2 * (x * z + w * y)), (scalar_t)test_uniform(-100, 100),
+		(scalar_t)(2 * (x * y + w * z)), (scalar_t)(1 - 2 * (x * x + z * z)), (scalar_t)(2 * (y * z - w * x)), (scalar_t)test_uniform(-100, 100),
+		(scalar_t)(2 * (x * z - w * y)), (scalar_t)(2 * (y * z + w * x)), (scalar_t)(1 - 2 * (x * x + y * y)), (scalar_t)test_uniform(-100, 100),
+		0, 0, 0, 1);
+}
+
+/* A random matrix whose last row is nearly a combination of the others */
+static void random_near_singular(mat4x4_t m, double delta)
+{
+	random_matrix(m);
+
+	double a = test_uniform(-1, 1), b = test_uniform(-1, 1), c = test_uniform(-1, 1);
+
+	for (int j = 0; j < 4; ++j) {
+		m[3][j] = (scalar_t)(a * m[0][j] + b * m[1][j] + c * m[2][j] + delta * test_uniform(-1, 1));
+	}
+}
+
+static double worst(double a, double b)
+{
+	return a > b ? a : b;
+}
+
+int main()
+{
+	printf("4x4 inverse, %s kernel, %s precision\n", KERNEL, PRECISION);
+
+	double err_general = 0, err_affine = 0, err_affine_general = 0;
+	double err_rigid = 0, err_rigid_general = 0, err_near_singular = 0;
+
+	mat4x4_t m, inv;
+
+	for (int n = 0; n < TRIALS; ++n) {
+		random_matrix(m);
+		mat4x4_inverse(inv, m);
+		err_general = worst(err_general, relative_error(inv, m));
+
+		random_affine(m);
+		mat4x4_inverse_affine(inv, m);
+		err_affine = worst(err_affine, relative_error(inv, m));
+		mat4x4_inverse(inv, m);
+		err_affine_general = worst(err_affine_general, relative_error(inv, m));
+
+		random_rigid(m);
+		mat4x4_inverse_rigid(inv, m);
+		err_rigid = worst(err_rigid, relative_error(inv, m));
+		mat4x4_inverse(inv, m);
+		err_rigid_general = worst(err_rigid_general, relative_error(inv, m));
+
+		random_near_singular(m, n & 1 ? 1e-2 : 1e-4);
+		mat4x4_inverse(inv, m);
+		err_near_singular = worst(err_near_singular, relative_error(inv, m));
+	}
+
+	test_check_error("general, random", err_general, BOUND);
+	test_check_error("general, affine", err_affine_general, BOUND);
+	test_check_error("general, rigid", err_rigid_general, BOUND);
+	test_check_error("general, near singular", err_near_singular, BOUND);
+	test_check_error("inverse_affine, affine", err_affine, BOUND);
+	test_check_error("inverse_rigid, rigid", err_rigid, BOUND);
+
+	/* The class forwards to the same kernels */
+	random_affine(m);
+	Matrix4x4f mat(m);
+	Matrix4x4f a = mat.inverse(), b = mat.inverse_affine();
+	test_check_error("Matrix4x4f inverse", relative_error(a.data, m), BOUND);
+	test_check_error("Matrix4x4f inverse_affine", relative_error(b.data, m), BOUND);
+
+	random_rigid(m);
+	Matrix4x4f rigid(m);
+	Matrix4x4f c = rigid.inverse_rigid();
+	test_check_error("Matrix4x4f inverse_rigid", relative_error(c.data, m), BOUND);
+
+	/* A singular matrix leaves the result untouched, as it always has */
+	random_matrix(m);
+	memcpy(m[1], m[0], sizeof(m[0]));
+	mat4x4_identity(inv);
+	mat4x4_inverse(inv, m);
+
+	mat4x4_t identity;
+	mat4x4_identity(identity);
+	test_check("singular matrix leaves the result untouched", !memcmp(inv, identity, sizeof(mat4x4_t)));
+
+	return test_result("inverse");
+}
@@ -0,0 +1,283 @@
+/*
+
+    This file is part of libnmath.
+
+    kdtree.cc
+    Tests of the k-d tree queries against brute force
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+/*
+	The nearest and radius queries are checked against a scan of all the
+	points, on uniform points and on clustered ones with duplicates, which
+	exercise ties and degenerate cells. The squared distances must match
+	to a few ulp, as -ffast-math may sum the squares in another order. The
+	batch queries must return exactly what the single queries do.
+*/
+
+#include "kdtree.h"
+#include "test.h"
+
+#include <float.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+using namespace NMath;
+
+#define POINTS		20000
+#define QUERIES		300
+
+static scalar_t distance_squared(const Vector3f &a, const Vector3f &b)
+{
+	Vector3f d = a - b;
+	return d.x * d.x + d.y * d.y + d.z * d.z;
+}
+
+static bool same_distance(scalar_t a, scalar_t b)
+{
+	double eps = sizeof(scalar_t) == 4 ? FLT_EPSILON : DBL_EPSILON;
+	return fabs(a - b) <= 4 * eps * (a > b ? a : b);
+}
+
+/* The squared distances of all points from q, sorted */
+static std::vector<scalar_t> brute_force(const std::vector<Vector3f> &point, const Vector3f &q)
+{
+	std::vector<scalar_t> d(point.size());
+
+	for (size_t i = 0; i < point.size(); ++i) {
+		d[i] = distance_squared(q, point[i]);
+	}
+
+	std::sort(d.begin(), d.end());
+	return d;
+}
+
+/* The indices are distinct and the distances are theirs */
+static bool consistent(const std::vector<Vector3f> &point, const Vector3f &q,
+					   const unsigned int *index, const scalar_t *distance, unsigned int n)
+{
+	std::vector<unsigned int> seen(index, index + n);
+	std::sort(seen.begin(), seen.end());
+
+	if (std::adjacent_find(seen.begin(), seen.end()) != seen.end()) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < n; ++i) {
+		if (index[i] >= point.size() || !same_distance(distance[i], distance_squared(q, point[index[i]]))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool check_nearest(const KDTree &tree, const std::vector<Vector3f> &point, const Vector3f &q,
+						  unsigned int k, scalar_t max_distance)
+{
+	std::vector<scalar_t> ref = brute_force(point, q);
+	std::vector<unsigned int> index(k);
+	std::vector<scalar_t> distance(k);
+
+	unsigned int n = tree.nearest(q, k, &index[0], &distance[0], max_distance);
+
+	/* Squared without overflow, -ffast-math assumes there are no infinities */
+	scalar_t limit = max_distance < sqrt(SCALAR_T_MAX) ? max_distance * max_distance : SCALAR_T_MAX;
+
+	unsigned int expected = 0;
+	while (expected < k && expected < ref.size() && ref[expected] < limit) {
+		++expected;
+	}
+
+	if (n != expected || !consistent(point, q, &index[0], &distance[0], n)) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < n; ++i) {
+		if (!same_distance(distance[i], ref[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool check_radius(const KDTree &tree, const std::vector<Vector3f> &point, const Vector3f &q, scalar_t radius)
+{
+	std::vector<scalar_t> ref = brute_force(point, q);
+	unsigned int expected = (unsigned int)(std::lower_bound(ref.begin(), ref.end(), radius * radius) - ref.begin());
+
+	std::vector<unsigned int> index(expected + 1);
+	std::vector<scalar_t> distance(expected + 1);
+
+	unsigned int n = tree.radius(q, radius, expected + 1, &index[0], &distance[0]);
+
+	if (n != expected || !consistent(point, q, &index[0], &distance[0], n)) {
+		return false;
+	}
+
+	/* The same set, in any order */
+	std::sort(distance.begin(), distance.begin() + n);
+
+	for (unsigned int i = 0; i < n; ++i) {
+		if (!same_distance(distance[i], ref[i])) {
+			return false;
+		}
+	}
+
+	/* Too small a buffer still counts them all */
+	return !expected || tree.radius(q, radius, expected / 2, &index[0], 0) == expected;
+}
+
+static Vector3f uniform_point()
+{
+	return Vector3f((scalar_t)test_uniform(0, 1), (scalar_t)test_uniform(0, 1), (scalar_t)test_uniform(0, 1));
+}
+
+/* Thin slabs on seven planes, with runs of duplicates */
+static Vector3f clustered_point(unsigned int i)
+{
+	return Vector3f((scalar_t)test_uniform(0, 100), (scalar_t)test_uniform(0, 0.01), (scalar_t)(i % 7));
+}
+
+static void check_set(const char *name, const std::vector<Vector3f> &point, const std::vector<Vector3f> &query, scalar_t scale)
+{
+	static const unsigned int ks[] = { 1, 8, 40 };
+	char label[128];
+
+	KDTree tree(&point[0], (unsigned int)point.size());
+	sprintf(label, "%s: valid", name);
+	test_check(label, tree.valid() && tree.count() == point.size());
+
+	for (unsigned int j = 0; j < sizeof(ks) / sizeof(ks[0]); ++j) {
+		bool ok = true;
+
+		for (size_t i = 0; i < query.size(); ++i) {
+			ok = check_nearest(tree, point, query[i], ks[j], SCALAR_T_MAX) && ok;
+		}
+
+		sprintf(label, "%s: nearest k = %u", name, ks[j]);
+		test_check(label, ok);
+	}
+
+	bool ok = true;
+
+	for (size_t i = 0; i < query.size(); ++i) {
+		ok = check_nearest(tree, point, query[i], 16, (scalar_t)test_uniform(0, 0.05) * scale) && ok;
+	}
+
+	sprintf(label, "%s: nearest within max_distance", name);
+	test_check(label, ok);
+
+	ok = true;
+
+	for (size_t i = 0; i < query.size(); ++i) {
+		ok = check_radius(tree, point, query[i], (scalar_t)test_uniform(0, 0.1) * scale) && ok;
+	}
+
+	sprintf(label, "%s: radius", name);
+	test_check(label, ok);
+
+	/* Batches against single queries */
+	const unsigned int k = 8, max = 64;
+	unsigned int count = (unsigned int)query.size();
+	scalar_t radius = (scalar_t)0.03 * scale;
+
+	std::vector<unsigned int> index(count * max), found(count), single_index(max);
+	std::vector<scalar_t> distance(count * max), single_distance(max);
+
+	tree.nearest(&query[0], count, k, &index[0], &distance[0], &found[0]);
+	ok = true;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned int n = tree.nearest(query[i], k, &single_index[0], &single_distance[0]);
+		ok = ok && found[i] == n
+			&& std::equal(single_index.begin(), single_index.begin() + n, index.begin() + i * k)
+			&& std::equal(single_distance.begin(), single_distance.begin() + n, distance.begin() + i * k);
+	}
+
+	sprintf(label, "%s: nearest batch", name);
+	test_check(label, ok);
+
+	tree.radius(&query[0], count, radius, max, &index[0], &distance[0], &found[0]);
+	ok = true;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned int n = tree.radius(query[i], radius, max, &single_index[0], &single_distance[0]);
+		unsigned int m = n < max ? n : max;
+		ok = ok && found[i] == n
+			&& std::equal(single_index.begin(), single_index.begin() + m, index.begin() + i * max)
+			&& std::equal(single_distance.begin(), single_distance.begin() + m, distance.begin() + i * max);
+	}
+
+	sprintf(label, "%s: radius batch", name);
+	test_check(label, ok);
+}
+
+int main()
+{
+	std::vector<Vector3f> point(POINTS), query(QUERIES);
+
+	printf("k-d tree, %u points, %u queries per check\n", POINTS, QUERIES);
+
+	for (unsigned int i = 0; i < POINTS; ++i) {
+		point[i] = uniform_point();
+	}
+
+	for (unsigned int i = 0; i < QUERIES; ++i) {
+		query[i] = uniform_point();
+	}
+
+	check_set("uniform", point, query, 1);
+
+	for (unsigned int i = 0; i < POINTS; ++i) {
+		point[i] = clustered_point(i);
+
+		/* Every tenth point repeats the one before */
+		if (i % 10 == 9) {
+			point[i] = point[i - 1];
+		}
+	}
+
+	for (unsigned int i = 0; i < QUERIES; ++i) {
+		/* Half of the queries sit on points */
+		query[i] = i % 2 ? point[test_rand() % POINTS] : Vector3f((scalar_t)test_uniform(0, 100),
+			(scalar_t)test_uniform(0, 0.01), (scalar_t)test_uniform(0, 7));
+	}
+
+	check_set("clustered", point, query, 100);
+
+	/* Fewer points than k, a single point and none */
+	std::vector<Vector3f> few(point.begin(), point.begin() + 5);
+	KDTree small(&few[0], (unsigned int)few.size());
+	test_check("5 points: nearest k = 8", check_nearest(small, few, query[0], 8, SCALAR_T_MAX));
+
+	KDTree one(&few[0], 1);
+	unsigned int index[4];
+	scalar_t distance[4];
+	test_check("1 point: nearest", one.nearest(query[0], 4, index, distance) == 1 && index[0] == 0);
+
+	KDTree empty(&few[0], 0);
+	test_check("no points: nearest and radius", empty.nearest(query[0], 4, index, distance) == 0
+		&& empty.radius(query[0], 1000, 4, index, distance) == 0);
+
+	return test_result("kdtree");
+}
@@ -0,0 +1,220 @@
+/*
+
+    This file is part of libnmath.
+
+    overlap.cc
+    Tests of the batch overlap masks against the single tests
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+/*
+	aabb3_overlaps_batch, aabb3_overlaps_sphere_batch and
+	sphere_overlaps_batch must set exactly the bits the single tests give,
+	clear the bits past count in the last word and write nothing past it.
+	The counts straddle the lane and word boundaries. The coordinates are
+	on a half unit grid so that touching boxes and spheres, where the
+	comparisons are equalities, come up often and are computed exactly.
+*/
+
+#include "aabb.h"
+#include "sphere.h"
+#include "test.h"
+
+#include <vector>
+
+using namespace NMath;
+
+#define SENTINEL	0x5a5a5a5au
+
+static const unsigned int counts[] = { 1, 7, 31, 32, 33, 100 };
+
+static scalar_t grid(int lo, int hi)
+{
+	return (scalar_t)(2 * lo + (int)(test_rand() % (2 * (hi - lo) + 1))) / 2;
+}
+
+static vec3_t grid_point(int lo, int hi)
+{
+	return vec3_pack(grid(lo, hi), grid(lo, hi), grid(lo, hi));
+}
+
+static aabb3_t grid_box()
+{
+	vec3_t a = grid_point(0, 8), b = grid_point(0, 8);
+	return aabb3_pack(vec3_pack(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z),
+					  vec3_pack(a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y, a.z < b.z ? b.z : a.z));
+}
+
+/* count boxes, or spheres in min and max.x, from an odd offset in the arrays */
+struct Batch
+{
+	std::vector<scalar_t> data[6];
+	aabb3_soa_t soa;
+
+	Batch(unsigned int count)
+	{
+		for (int i = 0; i < 6; ++i) {
+			data[i].assign(count + 1, 0);
+		}
+
+		soa.min.x = &data[0][1];
+		soa.min.y = &data[1][1];
+		soa.min.z = &data[2][1];
+		soa.max.x = &data[3][1];
+		soa.max.y = &data[4][1];
+		soa.max.z = &data[5][1];
+	}
+
+	aabb3_t box(unsigned int i) const
+	{
+		return aabb3_pack(vec3_pack(soa.min.x[i], soa.min.y[i], soa.min.z[i]),
+						  vec3_pack(soa.max.x[i], soa.max.y[i], soa.max.z[i]));
+	}
+};
+
+/* The mask matches the expected bits, is cleared past count and the word after it is untouched */
+static bool check_mask(const std::vector<uint32_t> &mask, const std::vector<short> &expected)
+{
+	unsigned int count = (unsigned int)expected.size(), words = (count + 31) / 32;
+
+	for (unsigned int i = 0; i < words * 32; ++i) {
+		unsigned int bit = (mask[i / 32] >> (i % 32)) & 1;
+
+		if (bit != (i < count ? (unsigned int)(expected[i] != 0) : 0)) {
+			return false;
+		}
+	}
+
+	return mask[words] == SENTINEL;
+}
+
+static std::vector<uint32_t> sentinel_mask(unsigned int count)
+{
+	return std::vector<uint32_t>((count + 31) / 32 + 1, SENTINEL);
+}
+
+static void check_boxes(unsigned int count)
+{
+	char label[128];
+	Batch batch(count);
+
+	for (unsigned int i = 0; i < count; ++i) {
+		aabb3_t b = grid_box();
+		batch.soa.min.x[i] = b.min.x;
+		batch.soa.min.y[i] = b.min.y;
+		batch.soa.min.z[i] = b.min.z;
+		batch.soa.max.x[i] = b.max.x;
+		batch.soa.max.y[i] = b.max.y;
+		batch.soa.max.z[i] = b.max.z;
+	}
+
+	bool ok = true, ok_sphere = true, ok_class = true;
+
+	for (unsigned int q = 0; q < 50; ++q) {
+		aabb3_t b = grid_box();
+		std::vector<short> expected(count);
+		std::vector<uint32_t> mask = sentinel_mask(count);
+
+		for (unsigned int i = 0; i < count; ++i) {
+			expected[i] = aabb3_overlaps(b, batch.box(i));
+		}
+
+		aabb3_overlaps_batch(b, batch.soa, count, &mask[0]);
+		ok = check_mask(mask, expected) && ok;
+
+		BoundingBox3 box(Vector3f(b.min.x, b.min.y, b.min.z), Vector3f(b.max.x, b.max.y, b.max.z));
+		mask = sentinel_mask(count);
+		box.overlaps(batch.soa, count, &mask[0]);
+		ok_class = check_mask(mask, expected) && ok_class;
+
+		/* Integer radii reach the box exactly as often as not */
+		vec3_t center = grid_point(-2, 10);
+		scalar_t radius = (scalar_t)(test_rand() % 4);
+		mask = sentinel_mask(count);
+
+		for (unsigned int i = 0; i < count; ++i) {
+			expected[i] = aabb3_overlaps_sphere(batch.box(i), center, radius);
+		}
+
+		aabb3_overlaps_sphere_batch(center, radius, batch.soa, count, &mask[0]);
+		ok_sphere = check_mask(mask, expected) && ok_sphere;
+	}
+
+	sprintf(label, "aabb3_overlaps_batch, %u boxes", count);
+	test_check(label, ok);
+	sprintf(label, "BoundingBox3::overlaps, %u boxes", count);
+	test_check(label, ok_class);
+	sprintf(label, "aabb3_overlaps_sphere_batch, %u boxes", count);
+	test_check(label, ok_sphere);
+}
+
+static void check_spheres(unsigned int count)
+{
+	char label[128];
+	Batch batch(count);
+	vec3_soa_t origin = batch.soa.min;
+	scalar_t *radius = batch.soa.max.x;
+
+	for (unsigned int i = 0; i < count; ++i) {
+		vec3_t o = grid_point(0, 8);
+		origin.x[i] = o.x;
+		origin.y[i] = o.y;
+		origin.z[i] = o.z;
+		radius[i] = grid(0, 3);
+	}
+
+	bool ok = true, ok_class = true;
+
+	for (unsigned int q = 0; q < 50; ++q) {
+		/* Sphere takes a zero radius for the default one, so query with positive radii */
+		sphere_t s = sphere_pack(grid_point(0, 8), grid(1, 3));
+		std::vector<short> expected(count);
+		std::vector<uint32_t> mask = sentinel_mask(count);
+
+		for (unsigned int i = 0; i < count; ++i) {
+			expected[i] = sphere_overlaps(s, sphere_pack(vec3_pack(origin.x[i], origin.y[i], origin.z[i]), radius[i]));
+		}
+
+		sphere_overlaps_batch(s, origin, radius, count, &mask[0]);
+		ok = check_mask(mask, expected) && ok;
+
+		Sphere sphere(Vector3f(s.origin.x, s.origin.y, s.origin.z), s.radius);
+		mask = sentinel_mask(count);
+		sphere.overlaps(origin, radius, count, &mask[0]);
+		ok_class = check_mask(mask, expected) && ok_class;
+	}
+
+	sprintf(label, "sphere_overlaps_batch, %u spheres", count);
+	test_check(label, ok);
+	sprintf(label, "Sphere::overlaps, %u spheres", count);
+	test_check(label, ok_class);
+}
+
+int main()
+{
+	printf("Batch overlap masks, 50 queries per check\n");
+
+	for (unsigned int i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+		check_boxes(counts[i]);
+		check_spheres(counts[i]);
+	}
+
+	return test_result("overlap");
+}
@@ -0,0 +1,254 @@
+/*
+
+    This file is part of libnmath.
+
+    prime.cc
+    Tests of the prime table, the sieve and the primality tests
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+/*
+	The table and prime_test below 2^18 are checked against trial
+	division, and the sieve against prime_test in ranges that cross the
+	table limit, 2^32 and a sieve segment, which compares Miller-Rabin
+	with an independent method. prime_next and prime_prev are checked
+	around the table limit and 2^32. The Miller-Rabin set has strong
+	pseudoprimes to many bases, squares and products of primes with no
+	small factor, and primes near 2^64.
+*/
+
+#include "prime.h"
+#include "test.h"
+
+#include <limits.h>
+#include <vector>
+
+using namespace NMath;
+
+#define NAIVE_LIMIT	262144
+
+static int naive_prime(unsigned long n)
+{
+	if (n < 2) {
+		return 0;
+	}
+
+	for (unsigned long d = 2; d * d <= n; ++d) {
+		if (!(n % d)) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static void check_table()
+{
+	const uint16_t *table = prime_table();
+	unsigned int k = 0;
+	bool ok = true;
+
+	for (unsigned long n = 0; n < NMATH_PRIME_TABLE_LIMIT && ok; ++n) {
+		if (naive_prime(n)) {
+			ok = k < NMATH_PRIME_TABLE_SIZE && table[k++] == n;
+		}
+	}
+
+	test_check("prime_table against trial division", ok && k == NMATH_PRIME_TABLE_SIZE);
+
+	ok = true;
+
+	for (unsigned long n = 0; n < NAIVE_LIMIT; ++n) {
+		ok = (isPrime(n) != 0) == (naive_prime(n) != 0) && ok;
+	}
+
+	test_check("isPrime against trial division below 2^18", ok);
+}
+
+/* The sieve of [lo, hi) against prime_test, its count and its list */
+static bool check_sieve(unsigned long lo, unsigned long hi)
+{
+	prime_sieve_t s;
+
+	if (prime_sieve_init(&s, lo, hi)) {
+		return false;
+	}
+
+	std::vector<unsigned long> expected;
+	bool ok = true;
+
+	/* One number on either side, which the sieve must not claim */
+	for (unsigned long n = lo ? lo - 1 : 0; n <= hi; ++n) {
+		int prime = isPrime(n);
+		ok = (prime_sieve_test(&s, n) != 0) == (prime && n >= lo && n < hi) && ok;
+
+		if (prime && n >= lo && n < hi) {
+			expected.push_back(n);
+		}
+	}
+
+	std::vector<unsigned long> list(expected.size() + 1);
+	unsigned long n = prime_sieve_list(&s, &list[0], (unsigned long)list.size());
+	list.resize(n);
+
+	ok = ok && prime_sieve_count(&s) == expected.size() && list == expected;
+
+	/* A short list stops at max */
+	if (expected.size() > 1) {
+		ok = ok && prime_sieve_list(&s, &list[0], 1) == 1 && list[0] == expected[0];
+	}
+
+	prime_sieve_release(&s);
+	return ok;
+}
+
+static void check_sieves()
+{
+	test_check("sieve, [0, 2^18)", check_sieve(0, NAIVE_LIMIT));
+	test_check("sieve, small and empty ranges", check_sieve(0, 0) && check_sieve(0, 1) && check_sieve(1, 3)
+			   && check_sieve(2, 3) && check_sieve(3, 4) && check_sieve(24, 28) && check_sieve(90, 89));
+	test_check("sieve, across the table limit", check_sieve(65000, 66001) && check_sieve(65521, 65538));
+	test_check("sieve, segments", check_sieve(1000001, 2300000));
+
+#if ULONG_MAX > 0xFFFFFFFFUL
+	test_check("sieve, across 2^32", check_sieve(4294967296UL - 5000, 4294967296UL + 5001));
+	test_check("sieve, 10^14", check_sieve(100000000000000UL, 100000000200000UL));
+#endif /* ULONG_MAX */
+}
+
+/* next is the first prime after n and prev the last before it */
+static bool check_neighbours(unsigned long n, unsigned long next, unsigned long prev)
+{
+	bool ok = prime_next(n) == next && prime_prev(n) == prev && getNextPrime(n) == next && getPrevPrime(n) == prev;
+
+	for (unsigned long i = prev + 1; i < next && ok; ++i) {
+		ok = i == n || !naive_prime(i);
+	}
+
+	return ok && naive_prime(next) && naive_prime(prev);
+}
+
+static void check_next_prev()
+{
+	test_check("prime_next and prime_prev, small", prime_next(0) == 2 && prime_next(1) == 2 && prime_next(2) == 3
+			   && prime_prev(3) == 2 && prime_prev(2) == 2 && check_neighbours(4, 5, 3) && check_neighbours(90, 97, 89));
+	test_check("prime_next and prime_prev, 2^16", check_neighbours(65521, 65537, 65519) && check_neighbours(65535, 65537, 65521)
+			   && check_neighbours(65536, 65537, 65521) && check_neighbours(65537, 65539, 65521));
+
+#if ULONG_MAX > 0xFFFFFFFFUL
+	test_check("prime_next and prime_prev, 2^32", check_neighbours(4294967291UL, 4294967311UL, 4294967279UL)
+			   && check_neighbours(4294967295UL, 4294967311UL, 4294967291UL) && check_neighbours(4294967296UL, 4294967311UL, 4294967291UL)
+			   && check_neighbours(4294967311UL, 4294967357UL, 4294967291UL));
+#endif /* ULONG_MAX */
+
+	bool ok = true;
+
+	for (unsigned int i = 0; i < 1000 && ok; ++i) {
+		unsigned long n = test_rand() % NAIVE_LIMIT;
+		unsigned long next = prime_next(n), prev = prime_prev(n);
+		ok = next > n && (n <= 2 ? prev == 2 : prev < n) && check_neighbours(n, next, prev);
+	}
+
+	test_check("prime_next and prime_prev, random below 2^18", ok);
+}
+
+#if ULONG_MAX > 0xFFFFFFFFUL
+/* Composites with their smallest factor, none of them found by the trial division */
+static const unsigned long composites[][2] = {
+	{ 3215031751UL, 151 },							/* strong pseudoprime to 2, 3, 5, 7 */
+	{ 2152302898747UL, 6763 },						/* ... to the primes up to 11 */
+	{ 3474749660383UL, 1303 },						/* ... up to 13 */
+	{ 341550071728321UL, 10670053 },				/* ... up to 17 */
+	{ 3825123056546413051UL, 149491 },				/* ... up to 23 */
+	{ 4294967291UL * 4294967291UL, 4294967291UL },	/* squares near 2^64 */
+	{ 4294967279UL * 4294967291UL, 4294967279UL },
+	{ 65537UL * 65537UL, 65537 },
+	{ 2305843009213693951UL * 3, 3 }				/* caught by the trial division after all */
+};
+
+static const unsigned long primes[] = {
+	4294967291UL, 4294967311UL,
+	2305843009213693951UL,							/* 2^61 - 1 */
+	9223372036854775783UL,							/* the largest below 2^63 */
+	18446744073709551557UL							/* the largest below 2^64 */
+};
+#endif /* ULONG_MAX */
+
+static void check_miller_rabin()
+{
+#if ULONG_MAX > 0xFFFFFFFFUL
+	bool ok = true;
+
+	for (unsigned int i = 0; i < sizeof(composites) / sizeof(composites[0]); ++i) {
+		unsigned long n = composites[i][0], f = composites[i][1];
+		ok = f > 1 && f < n && !(n % f) && !isPrime(n) && ok;
+	}
+
+	test_check("Miller-Rabin, strong pseudoprimes and squares", ok);
+
+	ok = true;
+
+	for (unsigned int i = 0; i < sizeof(primes) / sizeof(primes[0]); ++i) {
+		ok = isPrime(primes[i]) && ok;
+	}
+
+	test_check("Miller-Rabin, large primes", ok);
+
+	/* Products of two primes above the table */
+	ok = true;
+
+	for (unsigned int i = 0; i < 1000; ++i) {
+		unsigned long p = prime_next(65536 + test_rand() % 4000000000u);
+		unsigned long q = prime_next(65536 + test_rand() % 4000000000u);
+
+		ok = isPrime(p) && isPrime(q) && !isPrime(p * q) && ok;
+	}
+
+	test_check("Miller-Rabin, semiprimes", ok);
+#endif /* ULONG_MAX */
+
+	std::vector<unsigned long> n(20000);
+	std::vector<int> res(n.size());
+
+	for (size_t i = 0; i < n.size(); ++i) {
+		n[i] = (unsigned long)test_rand() * (i & 1 ? 1 : 977) + test_rand();
+	}
+
+	prime_test_batch(&n[0], &res[0], (unsigned int)n.size());
+	bool ok_batch = true;
+
+	for (size_t i = 0; i < n.size(); ++i) {
+		ok_batch = res[i] == isPrime(n[i]) && ok_batch;
+	}
+
+	test_check("prime_test_batch against isPrime", ok_batch);
+}
+
+int main()
+{
+	printf("Primes, table limit %u, trial division below %u\n", NMATH_PRIME_TABLE_LIMIT, NAIVE_LIMIT);
+
+	check_table();
+	check_sieves();
+	check_next_prev();
+	check_miller_rabin();
+
+	return test_result("prime");
+}
@@ -0,0 +1,270 @@
+/*
+
+    This file is part of libnmath.
+
+    prng.cc
+    Statistical tests of the Philox generator
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+/*
+	Chi-square tests of the bulk fills and the single value functions:
+	equidistribution in 1 and 2 dimensions and the balance of each bit.
+	The statistics are turned into a normal deviate with the Wilson and
+	Hilferty approximation, and a check fails beyond 5 standard deviations,
+	which a good generator does about once in 3.5 million runs. The seeds
+	are fixed, so a result is reproducible.
+
+	The bulk fills must also reproduce the single value sequence exactly,
+	for every length and starting offset, since that is what their SIMD
+	lanes are meant to guarantee.
+*/
+
+#include "prng.h"
+#include "test.h"
+
+#include <float.h>
+#include <math.h>
+#include <vector>
+
+using namespace NMath;
+
+#define SAMPLES		(1u << 22)
+#define BINS		1024
+#define BINS_2D		64
+#define MAX_DEVIATE	5.0
+
+/* Normal deviate of a chi-square statistic with k degrees of freedom */
+static double chi_square_deviate(double x, double k)
+{
+	double v = 2 / (9 * k);
+	return (pow(x / k, 1.0 / 3.0) - (1 - v)) / sqrt(v);
+}
+
+static double chi_square(const std::vector<double> &count, double expected)
+{
+	double x = 0;
+
+	for (size_t i = 0; i < count.size(); ++i) {
+		double d = count[i] - expected;
+		x += d * d / expected;
+	}
+
+	return chi_square_deviate(x, (double)(count.size() - 1));
+}
+
+/* Uniformity of values in [a, b) over BINS bins, and that they are in range */
+static double uniformity(const std::vector<double> &v, double a, double b, int *out_of_range)
+{
+	std::vector<double> count(BINS, 0);
+	*out_of_range = 0;
+
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (!(v[i] >= a && v[i] < b)) {
+			++*out_of_range;
+			continue;
+		}
+
+		size_t bin = (size_t)((v[i] - a) / (b - a) * BINS);
+		count[bin < BINS ? bin : BINS - 1] += 1;
+	}
+
+	return chi_square(count, (double)v.size() / BINS);
+}
+
+/* Uniformity of non overlapping pairs over BINS_2D x BINS_2D cells */
+static double uniformity_2d(const std::vector<double> &v, double a, double b)
+{
+	std::vector<double> count(BINS_2D * BINS_2D, 0);
+
+	for (size_t i = 0; i + 1 < v.size(); i += 2) {
+		size_t x = (size_t)((v[i] - a) / (b - a) * BINS_2D);
+		size_t y = (size_t)((v[i + 1] - a) / (b - a) * BINS_2D);
+		count[(x < BINS_2D ? x : BINS_2D - 1) * BINS_2D + (y < BINS_2D ? y : BINS_2D - 1)] += 1;
+	}
+
+	return chi_square(count, (double)(v.size() / 2) / (BINS_2D * BINS_2D));
+}
+
+/* Largest deviation of the 32 bit frequencies, in standard deviations */
+static double bit_balance(const std::vector<uint32_t> &v)
+{
+	double worst = 0, n = (double)v.size();
+
+	for (int bit = 0; bit < 32; ++bit) {
+		double ones = 0;
+
+		for (size_t i = 0; i < v.size(); ++i) {
+			ones += (v[i] >> bit) & 1;
+		}
+
+		double z = fabs(ones - n / 2) / sqrt(n / 4);
+		worst = z > worst ? z : worst;
+	}
+
+	return worst;
+}
+
+static void check_values(const char *name, const std::vector<double> &v, double a, double b)
+{
+	char label[64];
+	int out_of_range;
+
+	sprintf(label, "%s 1d", name);
+	test_check_error(label, fabs(uniformity(v, a, b, &out_of_range)), MAX_DEVIATE);
+
+	sprintf(label, "%s 2d", name);
+	test_check_error(label, fabs(uniformity_2d(v, a, b)), MAX_DEVIATE);
+
+	sprintf(label, "%s in [%g, %g)", name, a, b);
+	test_check(label, out_of_range == 0);
+}
+
+/* The fills against the single value functions, from every offset in a block */
+static void check_sequences()
+{
+	int mismatches = 0;
+
+	for (unsigned int skip = 0; skip < 4; ++skip) {
+		for (unsigned int count = 0; count < 80; ++count) {
+			prng_philox_t a, b;
+			prng_philox_seed(&a, 7, skip);
+			prng_philox_seed(&b, 7, skip);
+
+			for (unsigned int i = 0; i < skip; ++i) {
+				prng_philox_u32(&a);
+				prng_philox_u32(&b);
+			}
+
+			uint32_t u[80];
+			prng_philox_fill_u32(&a, u, count);
+			for (unsigned int i = 0; i < count; ++i) mismatches += u[i] != prng_philox_u32(&b);
+
+			float f[80];
+			prng_philox_fill_float(&a, f, count);
+			for (unsigned int i = 0; i < count; ++i) mismatches += f[i] != prng_philox_float(&b);
+
+			double d[80];
+			prng_philox_fill_double(&a, d, count);
+			for (unsigned int i = 0; i < count; ++i) mismatches += d[i] != prng_philox_double(&b);
+
+			scalar_t s[80];
+			prng_philox_fill(&a, s, count, -2, 3);
+			for (unsigned int i = 0; i < count; ++i) mismatches += s[i] != prng_philox(&b, -2, 3);
+
+			/* And the state is left in the same place */
+			mismatches += prng_philox_u32(&a) != prng_philox_u32(&b);
+		}
+	}
+
+	test_check("fills reproduce the single value sequence", mismatches == 0);
+
+	/* A jump lands where as many draws would */
+	prng_philox_t a, b;
+	prng_philox_seed(&a, 11, 3);
+	prng_philox_seed(&b, 11, 3);
+
+	for (unsigned int i = 0; i < 1001; ++i) {
+		prng_philox_u32(&a);
+	}
+
+	prng_philox_jump(&b, 1001);
+	test_check("jump matches sequential draws", prng_philox_u32(&a) == prng_philox_u32(&b));
+}
+
+/*
+	Between two neighbouring scalars a + (b - a) * u rounds up to b for
+	about half the draws, so everything has to be clamped back to a.
+*/
+static void check_bounds()
+{
+	const scalar_t eps = sizeof(scalar_t) == 4 ? FLT_EPSILON : DBL_EPSILON;
+	const scalar_t tiny = sizeof(scalar_t) == 4 ? FLT_MIN : DBL_MIN;
+
+	test_check("prng_range_max", prng_range_max(1, 2) == 2 - eps && prng_range_max(-2, -1) == -1 - eps
+			   && prng_range_max(-1, 0) == -tiny && prng_range_max(3, 3) == 3 && prng_range_max(3, 1) == 3);
+
+	static const scalar_t range[][2] = { { 1, 1 + eps }, { -1 - eps, -1 }, { -tiny, 0 } };
+	int outside = 0;
+
+	for (unsigned int k = 0; k < sizeof(range) / sizeof(range[0]); ++k) {
+		scalar_t a = range[k][0], b = range[k][1];
+		scalar_t r[256];
+		prng_philox_t s;
+		prng_philox_seed(&s, 8, k);
+
+		prng_philox_fill(&s, r, 256, a, b);
+
+		for (unsigned int i = 0; i < 256; ++i) {
+			outside += r[i] != a;
+			outside += prng_philox(&s, a, b) != a;
+		}
+	}
+
+	test_check("values stay below b", outside == 0);
+}
+
+int main()
+{
+	printf("Philox4x32-10, %u samples per check\n", SAMPLES);
+
+	check_sequences();
+	check_bounds();
+
+	prng_philox_t s;
+	std::vector<double> v(SAMPLES);
+
+	/* Bulk fills */
+	std::vector<uint32_t> u(SAMPLES);
+	prng_philox_seed(&s, 1, 0);
+	prng_philox_fill_u32(&s, &u[0], SAMPLES);
+	for (unsigned int i = 0; i < SAMPLES; ++i) v[i] = u[i];
+	check_values("fill_u32", v, 0, 4294967296.0);
+	test_check_error("fill_u32 bit balance", bit_balance(u), MAX_DEVIATE);
+
+	std::vector<float> f(SAMPLES);
+	prng_philox_seed(&s, 2, 0);
+	prng_philox_fill_float(&s, &f[0], SAMPLES);
+	for (unsigned int i = 0; i < SAMPLES; ++i) v[i] = f[i];
+	check_values("fill_float", v, 0, 1);
+
+	prng_philox_seed(&s, 3, 0);
+	prng_philox_fill_double(&s, &v[0], SAMPLES);
+	check_values("fill_double", v, 0, 1);
+
+	std::vector<scalar_t> r(SAMPLES);
+	prng_philox_seed(&s, 4, 0);
+	prng_philox_fill(&s, &r[0], SAMPLES, -3, 5);
+	for (unsigned int i = 0; i < SAMPLES; ++i) v[i] = r[i];
+	check_values("fill", v, -3, 5);
+
+	/* Single values, and neighbouring streams interleaved */
+	prng_philox_seed(&s, 5, 0);
+	for (unsigned int i = 0; i < SAMPLES; ++i) v[i] = prng_philox_float(&s);
+	check_values("philox_float", v, 0, 1);
+
+	prng_philox_t streams[16];
+	for (unsigned int i = 0; i < 16; ++i) prng_philox_seed(streams + i, 6, i);
+	for (unsigned int i = 0; i < SAMPLES; ++i) v[i] = prng_philox_double(streams + i % 16);
+	check_values("16 interleaved streams", v, 0, 1);
+
+	return test_result("prng");
+}
@@ -0,0 +1,111 @@
+/*
+
+    This file is part of libnmath.
+
+    smallcrush.cc
+    TestU01 SmallCrush battery on the Philox generator
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+/*
+	Runs SmallCrush (L'Ecuyer and Simard, "TestU01: A C library for
+	empirical testing of random number generators", ACM TOMS 2007) on the
+	32 bit outputs of the bulk fill, which takes the SIMD path, and on the
+	doubles of the single value function. configure looks for TestU01 and
+	make check builds this test only when it is found.
+
+	TestU01 reports p-values outside [0.001, 0.999] as suspect, which a
+	good generator shows now and then. A p-value outside [1e-10, 1 - 1e-10]
+	is a clear failure and fails the test.
+*/
+
+#include "prng.h"
+#include "test.h"
+
+extern "C" {
+	#include <unif01.h>
+	#include <bbattery.h>
+}
+
+using namespace NMath;
+
+#define BUFFER 4096
+#define SUSPECT_P 0.001
+#define FAILURE_P 1e-10
+
+static prng_philox_t state;
+static uint32_t buffer[BUFFER];
+static unsigned int next = BUFFER;
+
+static unsigned int philox_fill_bits()
+{
+	if (next == BUFFER) {
+		prng_philox_fill_u32(&state, buffer, BUFFER);
+		next = 0;
+	}
+
+	return buffer[next++];
+}
+
+static double philox_double()
+{
+	return prng_philox_double(&state);
+}
+
+/* Checks the p-values of the battery that just ran */
+static void check_battery(const char *name)
+{
+	int suspect = 0, failed = 0;
+
+	for (int i = 0; i < bbattery_NTests; ++i) {
+		double p = bbattery_pVal[i];
+
+		if (p < 0) {
+			continue;	/* not computed */
+		}
+
+		suspect += p < SUSPECT_P || p > 1 - SUSPECT_P;
+		failed += p < FAILURE_P || p > 1 - FAILURE_P;
+	}
+
+	printf("%s: %d tests, %d suspect, %d failed\n", name, bbattery_NTests, suspect, failed);
+	test_check(name, failed == 0);
+}
+
+int main()
+{
+	char name_bits[] = "prng_philox_fill_u32";
+	char name_double[] = "prng_philox_double";
+
+	prng_philox_seed(&state, 12345, 0);
+	unif01_Gen *gen = unif01_CreateExternGenBits(name_bits, philox_fill_bits);
+	bbattery_SmallCrush(gen);
+	unif01_DeleteExternGenBits(gen);
+	check_battery(name_bits);
+
+	prng_philox_seed(&state, 12345, 1);
+	gen = unif01_CreateExternGen01(name_double, philox_double);
+	bbattery_SmallCrush(gen);
+	unif01_DeleteExternGen01(gen);
+	check_battery(name_double);
+
+	return test_result("smallcrush");
+}
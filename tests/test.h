@@ -0,0 +1,95 @@
+/*
+
+    This file is part of libnmath.
+
+    test.h
+    Helpers shared by the tests
+
+    Copyright (C) 2008, 2010 - 2013
+    Papadopoulos Nikolaos
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General
+    Public License along with this library; if not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301 USA
+
+*/
+
+#ifndef NMATH_TEST_H_INCLUDED
+#define NMATH_TEST_H_INCLUDED
+
+#include <stdio.h>
+
+/*
+	Each test is a program that prints one line per check and exits with
+	a non zero status if any of them failed. make check runs them all.
+*/
+
+static int test_failed = 0;
+
+/* Records and prints the outcome of a check */
+static inline int test_check(const char *name, int ok)
+{
+	printf("  %-56s %s\n", name, ok ? "ok" : "FAILED");
+
+	if (!ok) {
+		++test_failed;
+	}
+
+	return ok;
+}
+
+/* The same for a measured error against a tolerance */
+static inline int test_check_error(const char *name, double error, double tolerance)
+{
+	printf("  %-40s %10.3g <= %-8.3g %s\n", name, error, tolerance, error <= tolerance ? "ok" : "FAILED");
+
+	if (!(error <= tolerance)) {
+		++test_failed;
+	}
+
+	return error <= tolerance;
+}
+
+static inline int test_result(const char *name)
+{
+	if (test_failed) {
+		printf("%s: %d check(s) failed\n", name, test_failed);
+		return 1;
+	}
+
+	printf("%s: passed\n", name);
+	return 0;
+}
+
+/*
+	Deterministic inputs, so that a failure can be reproduced. This is
+	Marsaglia's xorshift32 and is independent of the generators under test.
+*/
+static unsigned int test_rand_state = 2463534242u;
+
+static inline unsigned int test_rand()
+{
+	test_rand_state ^= test_rand_state << 13;
+	test_rand_state ^= test_rand_state >> 17;
+	test_rand_state ^= test_rand_state << 5;
+	return test_rand_state;
+}
+
+/* Uniform in [a, b) */
+static inline double test_uniform(double a, double b)
+{
+	return a + (b - a) * (test_rand() / 4294967296.0);
+}
+
+#endif /* NMATH_TEST_H_INCLUDED */